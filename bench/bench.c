@@ -0,0 +1,596 @@
+// Benchmark das funções principais sobre sentenças geradas
+// deterministicamente (ver generators.h).
+//
+// Uso: bench [--filter texto] [--quick] [--min-time seg] [--seed n]
+//            [-o resultados.jsonl] [--compare base.jsonl [--threshold pct]]
+//            [--list]
+//
+// Para cada caso (função/gerador/tamanho) mede a latência de cada chamada
+// (média, p50, p90, p99, máximo), a vazão, os nós de expressão criados
+// por chamada e o maior número de nós de uma conversão (pela
+// instrumentação da biblioteca, ConvertStats: só os nós, sem os buffers
+// dos resolvedores e do texto; -1 sem LOGICA_STATS) e o pico de RSS. Com
+// -o, escreve um objeto JSON por linha;
+// --compare compara o p50 com uma execução anterior e retorna 1 se algum
+// caso ficou mais lento que o limite (padrão 10%).
+
+#include <stdbool.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "../include/dnf_converter.h"
+#include "../include/dnf_cubes.h"
+#include "../include/expr_arena.h"
+#include "../include/native_eval.h"
+#include "generators.h"
+
+#ifdef _WIN32
+#include <windows.h>
+#else
+#include <sys/resource.h>
+#include <time.h>
+#endif
+
+// --- Relógio e memória do processo ---
+
+static double NowSeconds(void) {
+#ifdef _WIN32
+  LARGE_INTEGER freq, count;
+  QueryPerformanceFrequency(&freq);
+  QueryPerformanceCounter(&count);
+  return (double)count.QuadPart / (double)freq.QuadPart;
+#else
+  struct timespec ts;
+  clock_gettime(CLOCK_MONOTONIC, &ts);
+  return (double)ts.tv_sec + (double)ts.tv_nsec * 1e-9;
+#endif
+}
+
+// No Linux, escrever 5 em clear_refs zera o pico de RSS (VmHWM), o que
+// permite medir o pico de cada caso; nos demais sistemas o pico é o do
+// processo inteiro até o momento
+static void ResetPeakRss(void) {
+#ifdef __linux__
+  FILE* f = fopen("/proc/self/clear_refs", "w");
+  if (f) {
+    fputs("5", f);
+    fclose(f);
+  }
+#endif
+}
+
+static long PeakRssKb(void) {
+#if defined(__linux__)
+  FILE* f = fopen("/proc/self/status", "r");
+  long kb = -1;
+  if (f) {
+    char line[256];
+    while (fgets(line, sizeof(line), f))
+      if (sscanf(line, "VmHWM: %ld kB", &kb) == 1) break;
+    fclose(f);
+  }
+  return kb;
+#elif defined(_WIN32)
+  return -1;
+#else
+  struct rusage usage;
+  if (getrusage(RUSAGE_SELF, &usage) != 0) return -1;
+#ifdef __APPLE__
+  return usage.ru_maxrss / 1024;  // bytes no macOS
+#else
+  return usage.ru_maxrss;
+#endif
+#endif
+}
+
+// --- Casos ---
+
+typedef enum {
+  FN_CNF,
+  FN_DNF,
+  FN_DNF_STREAM,
+  FN_EQUIV,
+  FN_SAT,
+  FN_COUNT,
+  FN_SWEEP,        // varredura exaustiva com o interpretador bit-paralelo
+  FN_NATIVE_SWEEP  // a mesma varredura com o avaliador nativo
+} BenchFn;
+
+typedef enum {
+  GEN_KCNF,
+  GEN_PIGEONHOLE,
+  GEN_XOR,
+  GEN_LADDER,
+  GEN_WIDE_DNF
+} BenchGen;
+
+#define MAX_SIZES 4
+
+typedef struct {
+  const char* name_;
+  BenchFn fn_;
+  BenchGen gen_;
+  double ratio_;  // GEN_KCNF: cláusulas por variável
+  int sizes_[MAX_SIZES];  // terminado em 0; --quick usa só o primeiro
+} BenchCase;
+
+// O tamanho é o número de variáveis (kcnf, xor, ladder), de casas
+// (pigeonhole) ou de cubos (wide_dnf, sobre 16 variáveis)
+static const BenchCase kCases[] = {
+    {"cnf/xor", FN_CNF, GEN_XOR, 0, {4, 5, 6}},
+    {"cnf/wide_dnf", FN_CNF, GEN_WIDE_DNF, 0, {4, 6, 8}},
+    {"cnf/ladder", FN_CNF, GEN_LADDER, 0, {100, 1000, 10000}},
+    {"dnf/kcnf2", FN_DNF, GEN_KCNF, 2.0, {3, 4, 5}},
+    {"dnf/xor", FN_DNF, GEN_XOR, 0, {4, 5, 6}},
+    {"dnf/ladder", FN_DNF, GEN_LADDER, 0, {100, 1000, 10000}},
+    {"dnf-stream/kcnf2", FN_DNF_STREAM, GEN_KCNF, 2.0, {3, 4, 5}},
+    {"dnf-stream/xor", FN_DNF_STREAM, GEN_XOR, 0, {4, 5, 6}},
+    {"dnf-stream/ladder", FN_DNF_STREAM, GEN_LADDER, 0, {100, 1000, 10000}},
+    {"equiv/xor", FN_EQUIV, GEN_XOR, 0, {16, 64, 256}},
+    {"equiv/ladder", FN_EQUIV, GEN_LADDER, 0, {100, 1000, 10000}},
+    {"equiv/kcnf4.26", FN_EQUIV, GEN_KCNF, 4.26, {16, 30, 50}},
+    {"sat/kcnf4.26", FN_SAT, GEN_KCNF, 4.26, {50, 100, 150}},
+    {"sat/kcnf3", FN_SAT, GEN_KCNF, 3.0, {100, 1000, 10000}},
+    {"sat/pigeonhole", FN_SAT, GEN_PIGEONHOLE, 0, {4, 6, 8}},
+    {"sat/xor", FN_SAT, GEN_XOR, 0, {16, 1000, 100000}},
+    {"sat/ladder", FN_SAT, GEN_LADDER, 0, {1000, 10000, 100000}},
+    {"sat/wide_dnf", FN_SAT, GEN_WIDE_DNF, 0, {100, 1000, 10000}},
+    {"count/kcnf2", FN_COUNT, GEN_KCNF, 2.0, {30, 45, 60}},
+    {"count/xor", FN_COUNT, GEN_XOR, 0, {16, 256, 1024}},
+    {"count/ladder", FN_COUNT, GEN_LADDER, 0, {100, 1000, 10000}},
+    {"sweep/kcnf4.26", FN_SWEEP, GEN_KCNF, 4.26, {16, 20, 24}},
+    {"sweep/xor", FN_SWEEP, GEN_XOR, 0, {16, 20, 24}},
+    {"native/kcnf4.26", FN_NATIVE_SWEEP, GEN_KCNF, 4.26, {16, 20, 24}},
+    {"native/xor", FN_NATIVE_SWEEP, GEN_XOR, 0, {16, 20, 24}},
+};
+
+#define NUM_CASES ((int)(sizeof(kCases) / sizeof(kCases[0])))
+
+static const char* FnName(BenchFn fn) {
+  switch (fn) {
+    case FN_CNF:
+      return "ConvertToCNF";
+    case FN_DNF:
+      return "ConvertToDNF";
+    case FN_DNF_STREAM:
+      return "ForEachDnfCube";
+    case FN_EQUIV:
+      return "AreEquivalent";
+    case FN_COUNT:
+      return "CountModels";
+    case FN_SWEEP:
+      return "BitProgramCountAssignments";
+    case FN_NATIVE_SWEEP:
+      return "NativeEvalRun";
+    default:
+      return "IsSatisfiable";
+  }
+}
+
+// Semente própria de cada caso/tamanho: o resultado não depende de quais
+// outros casos rodaram (--filter)
+static uint64_t CaseSeed(uint64_t seed, const char* name, int size) {
+  uint64_t h = seed ^ 0xCBF29CE484222325ull;
+  for (const char* c = name; *c; c++) h = (h ^ (uint8_t)*c) * 0x100000001B3ull;
+  return h ^ (uint64_t)size * 0x9E3779B97F4A7C15ull;
+}
+
+// Gera a entrada (e, para FN_EQUIV, a segunda sentença equivalente)
+static void Generate(const BenchCase* c, int size, uint64_t seed,
+                     char** input1, char** input2) {
+  // sweep/ e native/ fazem a mesma varredura com avaliadores diferentes:
+  // a semente vem só do gerador, para que contem a mesma sentença
+  const char* key = c->name_;
+  if (c->fn_ == FN_SWEEP || c->fn_ == FN_NATIVE_SWEEP)
+    key = strchr(c->name_, '/') + 1;
+  BenchRng rng;
+  BenchRngSeed(&rng, CaseSeed(seed, key, size));
+  *input2 = NULL;
+  bool equiv = c->fn_ == FN_EQUIV;
+  switch (c->gen_) {
+    case GEN_KCNF:
+      *input1 = GenRandomKCnf(&rng, size, 3, c->ratio_, false);
+      if (equiv) {
+        BenchRngSeed(&rng, CaseSeed(seed, key, size));
+        *input2 = GenRandomKCnf(&rng, size, 3, c->ratio_, true);
+      }
+      break;
+    case GEN_PIGEONHOLE:
+      *input1 = GenPigeonhole(size);
+      if (equiv) *input2 = GenPigeonhole(size);
+      break;
+    case GEN_XOR:
+      *input1 = GenXorChain(size, false);
+      if (equiv) *input2 = GenXorChain(size, true);
+      break;
+    case GEN_LADDER:
+      *input1 = GenImplicationLadder(size, false);
+      if (equiv) *input2 = GenImplicationLadder(size, true);
+      break;
+    case GEN_WIDE_DNF:
+      *input1 = GenWideDnf(&rng, 16, size, 3);
+      if (equiv) *input2 = GenWideDnf(&rng, 16, size, 3);
+      break;
+    default:
+      abort();  // gerador novo sem caso aqui
+  }
+}
+
+typedef struct {
+  const char* case_;
+  int size_;
+  size_t input_bytes_;
+  int iterations_;
+  double mean_us_, p50_us_, p90_us_, p99_us_, max_us_;
+  double ops_per_sec_, mb_per_sec_;
+  long long nodes_per_op_, node_bytes_per_op_;
+  long long peak_nodes_;
+  long peak_rss_kb_;
+  char result_[32];
+} BenchResult;
+
+static bool CountCube(const int* lits, int size, void* user) {
+  (void)lits;
+  *(long long*)user += size;
+  return true;
+}
+
+static int Popcount(uint64_t w) {
+#if defined(__GNUC__)
+  return __builtin_popcountll(w);
+#else
+  int n = 0;
+  for (; w; w &= w - 1) n++;
+  return n;
+#endif
+}
+
+// Palavras por chamada de NativeEvalRun na varredura nativa
+#define SWEEP_LOG_WORDS 10
+
+// Conta as atribuições que satisfazem eval varrendo todas: as 6 primeiras
+// variáveis variam dentro da palavra, as SWEEP_LOG_WORDS seguintes entre
+// as palavras de um bloco e as demais são colunas constantes no bloco
+static long long NativeSweep(const NativeEval* eval) {
+  static const uint64_t kWordPatterns[6] = {
+      0xAAAAAAAAAAAAAAAAull, 0xCCCCCCCCCCCCCCCCull, 0xF0F0F0F0F0F0F0F0ull,
+      0xFF00FF00FF00FF00ull, 0xFFFF0000FFFF0000ull, 0xFFFFFFFF00000000ull};
+  int n = eval->prog_.num_vars_;
+  if (n > 40) return -1;
+  int low = n < 6 + SWEEP_LOG_WORDS ? n : 6 + SWEEP_LOG_WORDS;
+  size_t words = low > 6 ? (size_t)1 << (low - 6) : 1;
+  uint64_t* patterns =
+      (uint64_t*)malloc(sizeof(uint64_t) * words * (low > 0 ? low : 1));
+  uint64_t* zeros = (uint64_t*)calloc(words, sizeof(uint64_t));
+  uint64_t* ones = (uint64_t*)malloc(sizeof(uint64_t) * words);
+  uint64_t* out = (uint64_t*)malloc(sizeof(uint64_t) * words);
+  const uint64_t** columns =
+      (const uint64_t**)malloc(sizeof(*columns) * (n > 0 ? n : 1));
+  memset(ones, 0xFF, sizeof(uint64_t) * words);
+  for (int v = 0; v < low; v++) {
+    for (size_t w = 0; w < words; w++)
+      patterns[v * words + w] = v < 6 ? kWordPatterns[v]
+                                : (w >> (v - 6)) & 1 ? ~0ull
+                                                     : 0;
+    columns[v] = patterns + v * words;
+  }
+
+  // Com menos de 6 variáveis só os 2^n primeiros bits valem
+  uint64_t mask = n < 6 ? (1ull << (1 << n)) - 1 : ~0ull;
+  long long count = 0;
+  for (uint64_t block = 0; block < 1ull << (n - low); block++) {
+    for (int v = low; v < n; v++)
+      columns[v] = (block >> (v - low)) & 1 ? ones : zeros;
+    NativeEvalRun(eval, columns, out, words);
+    for (size_t w = 0; w < words; w++) count += Popcount(out[w] & mask);
+  }
+  free(columns);
+  free(out);
+  free(ones);
+  free(zeros);
+  free(patterns);
+  return count;
+}
+
+// Modelos de input por varredura exaustiva, interpretada ou nativa (a
+// biblioteca compilada no aquecimento é reaproveitada do disco)
+static long long SweepCount(const char* input, bool native) {
+  ExprArena arena;
+  ExprArenaInit(&arena);
+  int pos = 0;
+  ExprNode* t = ParseExpressionArena(&arena, input, &pos);
+  long long count = -1;
+  if (t && native) {
+    NativeEval eval;
+    if (NativeEvalCompile(t, NULL, &eval)) count = NativeSweep(&eval);
+    NativeEvalFree(&eval);
+  } else if (t) {
+    BitProgram prog;
+    if (BitProgramCompile(t, &prog))
+      count = BitProgramCountAssignments(&prog, true);
+    BitProgramFree(&prog);
+  }
+  ExprArenaRelease(&arena);
+  return count;
+}
+
+// Executa uma chamada e descreve o resultado (para detectar mudanças de
+// comportamento entre execuções, não só de tempo)
+static void RunOnce(BenchFn fn, const char* input1, const char* input2,
+                    char* result, size_t result_size) {
+  char* text = NULL;
+  switch (fn) {
+    case FN_CNF:
+      text = ConvertToCNF(input1);
+      break;
+    case FN_DNF:
+      text = ConvertToDNF(input1);
+      break;
+    case FN_DNF_STREAM: {
+      long long lits = 0;
+      long long cubes = ForEachDnfCube(input1, CountCube, &lits);
+      snprintf(result, result_size, "cubes=%lld lits=%lld", cubes, lits);
+      return;
+    }
+    case FN_EQUIV:
+      snprintf(result, result_size, "%s",
+               AreEquivalent(input1, input2) ? "true" : "false");
+      return;
+    case FN_SAT:
+      snprintf(result, result_size, "%s",
+               IsSatisfiable(input1) ? "true" : "false");
+      return;
+    case FN_COUNT:
+      // Prefixo da contagem (o resultado completo pode ter muitos dígitos)
+      text = CountModels(input1);
+      snprintf(result, result_size, "%s", text ? text : "null");
+      free(text);
+      return;
+    case FN_SWEEP:
+    case FN_NATIVE_SWEEP:
+      snprintf(result, result_size, "%lld",
+               SweepCount(input1, fn == FN_NATIVE_SWEEP));
+      return;
+  }
+  if (text)
+    snprintf(result, result_size, "bytes=%zu", strlen(text));
+  else
+    snprintf(result, result_size, "null");
+  free(text);
+}
+
+static int CompareDouble(const void* a, const void* b) {
+  double x = *(const double*)a, y = *(const double*)b;
+  return (x > y) - (x < y);
+}
+
+static double Percentile(const double* sorted, int n, double p) {
+  int rank = (int)(p * n + 0.999999) - 1;  // posto mais próximo
+  if (rank < 0) rank = 0;
+  if (rank >= n) rank = n - 1;
+  return sorted[rank];
+}
+
+#define MAX_ITERATIONS 100000
+
+static void RunCase(const BenchCase* c, int size, uint64_t seed,
+                    double min_time, BenchResult* r) {
+  char* input1;
+  char* input2;
+  Generate(c, size, seed, &input1, &input2);
+
+  memset(r, 0, sizeof(*r));
+  r->case_ = c->name_;
+  r->size_ = size;
+  r->input_bytes_ = strlen(input1) + (input2 ? strlen(input2) : 0);
+
+  // Aquecimento (também fixa o resultado de referência)
+  RunOnce(c->fn_, input1, input2, r->result_, sizeof(r->result_));
+
+  double* latencies = (double*)malloc(sizeof(double) * MAX_ITERATIONS);
+  char scratch[32];
+  ResetPeakRss();
+
+  int n = 0;
+  double total = 0;
+  while (n < MAX_ITERATIONS && (n < 3 || total < min_time)) {
+    double start = NowSeconds();
+    RunOnce(c->fn_, input1, input2, scratch, sizeof(scratch));
+    double elapsed = NowSeconds() - start;
+    latencies[n++] = elapsed;
+    total += elapsed;
+  }
+
+  r->peak_rss_kb_ = PeakRssKb();
+
+  // Nós contados numa chamada à parte: com a instrumentação ligada cada
+  // fase também lê o relógio, o que distorceria as latências acima
+  r->nodes_per_op_ = r->node_bytes_per_op_ = r->peak_nodes_ = -1;
+  if (ConvertStatsEnable(true)) {
+    ConvertStats stats;
+    ConvertStatsReset();
+    RunOnce(c->fn_, input1, input2, scratch, sizeof(scratch));
+    ConvertStatsGet(&stats);
+    ConvertStatsEnable(false);
+    r->nodes_per_op_ = stats.nodes_allocated_;
+    r->node_bytes_per_op_ =
+        stats.nodes_allocated_ * (long long)sizeof(ExprNode);
+    r->peak_nodes_ = stats.peak_nodes_;
+  }
+
+  qsort(latencies, n, sizeof(double), CompareDouble);
+  r->iterations_ = n;
+  r->mean_us_ = total / n * 1e6;
+  r->p50_us_ = Percentile(latencies, n, 0.50) * 1e6;
+  r->p90_us_ = Percentile(latencies, n, 0.90) * 1e6;
+  r->p99_us_ = Percentile(latencies, n, 0.99) * 1e6;
+  r->max_us_ = latencies[n - 1] * 1e6;
+  r->ops_per_sec_ = n / total;
+  r->mb_per_sec_ = r->input_bytes_ * (double)n / total / 1e6;
+
+  free(latencies);
+  free(input1);
+  free(input2);
+}
+
+static void WriteJson(FILE* out, const BenchResult* r, const char* fn) {
+  fprintf(out,
+          "{\"case\":\"%s\",\"function\":\"%s\",\"size\":%d,"
+          "\"input_bytes\":%zu,\"iterations\":%d,\"mean_us\":%.3f,"
+          "\"p50_us\":%.3f,\"p90_us\":%.3f,\"p99_us\":%.3f,\"max_us\":%.3f,"
+          "\"ops_per_sec\":%.3f,\"mb_per_sec\":%.3f,\"nodes_per_op\":%lld,"
+          "\"node_bytes_per_op\":%lld,\"peak_nodes\":%lld,"
+          "\"peak_rss_kb\":%ld,\"result\":\"%s\"}\n",
+          r->case_, fn, r->size_, r->input_bytes_, r->iterations_,
+          r->mean_us_, r->p50_us_, r->p90_us_, r->p99_us_, r->max_us_,
+          r->ops_per_sec_, r->mb_per_sec_, r->nodes_per_op_,
+          r->node_bytes_per_op_, r->peak_nodes_, r->peak_rss_kb_,
+          r->result_);
+}
+
+static void PrintHeader(void) {
+  printf("%-16s %7s %7s %11s %11s %11s %11s %11s %10s %9s\n", "caso",
+         "tamanho", "iter", "p50(us)", "p90(us)", "p99(us)", "ops/s",
+         "nos/op", "pico(nos)", "rss(KB)");
+}
+
+static void PrintRow(const BenchResult* r) {
+  printf("%-16s %7d %7d %11.1f %11.1f %11.1f %11.1f %11lld %10lld %9ld  %s\n",
+         r->case_, r->size_, r->iterations_, r->p50_us_, r->p90_us_,
+         r->p99_us_, r->ops_per_sec_, r->nodes_per_op_, r->peak_nodes_,
+         r->peak_rss_kb_, r->result_);
+  fflush(stdout);
+}
+
+// --- Comparação com uma execução anterior ---
+
+// Extrai o valor de "key" de uma linha JSON gerada por WriteJson
+static const char* JsonField(const char* line, const char* key) {
+  char pattern[64];
+  snprintf(pattern, sizeof(pattern), "\"%s\":", key);
+  const char* at = strstr(line, pattern);
+  return at ? at + strlen(pattern) : NULL;
+}
+
+// Retorna o p50 do caso na linha de base, ou < 0 se não houver
+static double BaselineP50(FILE* base, const BenchResult* r, char* result,
+                          size_t result_size) {
+  char line[1024];
+  rewind(base);
+  while (fgets(line, sizeof(line), base)) {
+    const char* name = JsonField(line, "case");
+    const char* size = JsonField(line, "size");
+    const char* p50 = JsonField(line, "p50_us");
+    const char* res = JsonField(line, "result");
+    size_t len = strlen(r->case_);
+    if (!name || !size || !p50 || !res) continue;
+    if (strncmp(name + 1, r->case_, len) != 0 || name[len + 1] != '"')
+      continue;
+    if (atoi(size) != r->size_) continue;
+    snprintf(result, result_size, "%.*s", (int)strcspn(res + 1, "\""),
+             res + 1);
+    return atof(p50);
+  }
+  return -1;
+}
+
+// Imprime a razão atual/base do p50 e retorna o número de regressões
+static int Compare(FILE* base, const BenchResult* results, int count,
+                   double threshold) {
+  int regressions = 0;
+  printf("\n%-16s %7s %11s %11s %8s\n", "caso", "tamanho", "base(us)",
+         "atual(us)", "razao");
+  for (int i = 0; i < count; i++) {
+    const BenchResult* r = &results[i];
+    char old_result[32];
+    double old_p50 = BaselineP50(base, r, old_result, sizeof(old_result));
+    if (old_p50 < 0) continue;
+    double ratio = old_p50 > 0 ? r->p50_us_ / old_p50 : 1.0;
+    const char* flag = "";
+    if (strcmp(old_result, r->result_) != 0) {
+      flag = "  RESULTADO MUDOU";
+      regressions++;
+    } else if (ratio > 1.0 + threshold / 100.0) {
+      flag = "  REGRESSAO";
+      regressions++;
+    }
+    printf("%-16s %7d %11.1f %11.1f %8.2f%s\n", r->case_, r->size_, old_p50,
+           r->p50_us_, ratio, flag);
+  }
+  return regressions;
+}
+
+int main(int argc, char** argv) {
+  const char* filter = NULL;
+  const char* out_path = NULL;
+  const char* compare_path = NULL;
+  double min_time = 0.5;
+  double threshold = 10.0;
+  uint64_t seed = 1;
+  bool quick = false;
+
+  for (int i = 1; i < argc; i++) {
+    bool has_value = i + 1 < argc;
+    if (!strcmp(argv[i], "--filter") && has_value) {
+      filter = argv[++i];
+    } else if (!strcmp(argv[i], "--quick")) {
+      quick = true;
+      min_time = 0.05;
+    } else if (!strcmp(argv[i], "--min-time") && has_value) {
+      min_time = atof(argv[++i]);
+    } else if (!strcmp(argv[i], "--seed") && has_value) {
+      seed = strtoull(argv[++i], NULL, 10);
+    } else if (!strcmp(argv[i], "-o") && has_value) {
+      out_path = argv[++i];
+    } else if (!strcmp(argv[i], "--compare") && has_value) {
+      compare_path = argv[++i];
+    } else if (!strcmp(argv[i], "--threshold") && has_value) {
+      threshold = atof(argv[++i]);
+    } else if (!strcmp(argv[i], "--list")) {
+      for (int c = 0; c < NUM_CASES; c++)
+        printf("%-16s %s\n", kCases[c].name_, FnName(kCases[c].fn_));
+      return 0;
+    } else {
+      fprintf(stderr, "Argumento desconhecido: %s\n", argv[i]);
+      return 2;
+    }
+  }
+
+  FILE* out = NULL;
+  if (out_path && !(out = fopen(out_path, "w"))) {
+    fprintf(stderr, "Nao foi possivel criar %s\n", out_path);
+    return 2;
+  }
+  FILE* base = NULL;
+  if (compare_path && !(base = fopen(compare_path, "r"))) {
+    fprintf(stderr, "Nao foi possivel abrir %s\n", compare_path);
+    return 2;
+  }
+
+  BenchResult* results =
+      (BenchResult*)malloc(sizeof(BenchResult) * NUM_CASES * MAX_SIZES);
+  int count = 0;
+  PrintHeader();
+  for (int c = 0; c < NUM_CASES; c++) {
+    const BenchCase* bc = &kCases[c];
+    if (filter && !strstr(bc->name_, filter)) continue;
+    for (int s = 0; s < MAX_SIZES && bc->sizes_[s]; s++) {
+      if (quick && s > 0) break;
+      BenchResult* r = &results[count++];
+      RunCase(bc, bc->sizes_[s], seed, min_time, r);
+      PrintRow(r);
+      if (out) WriteJson(out, r, FnName(bc->fn_));
+    }
+  }
+  if (out) fclose(out);
+
+  int regressions = 0;
+  if (base) {
+    regressions = Compare(base, results, count, threshold);
+    fclose(base);
+  }
+  free(results);
+  return regressions > 0;
+}
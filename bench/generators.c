@@ -0,0 +1,151 @@
+#include "generators.h"
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+typedef struct {
+  char* data_;
+  size_t size_;
+  size_t cap_;
+} GenBuffer;
+
+static void Append(GenBuffer* buf, const char* text) {
+  size_t len = strlen(text);
+  if (buf->size_ + len + 1 > buf->cap_) {
+    size_t cap = buf->cap_ ? buf->cap_ * 2 : 256;
+    while (cap < buf->size_ + len + 1) cap *= 2;
+    buf->data_ = (char*)realloc(buf->data_, cap);
+    buf->cap_ = cap;
+  }
+  memcpy(buf->data_ + buf->size_, text, len + 1);
+  buf->size_ += len;
+}
+
+static void AppendLit(GenBuffer* buf, int var, bool negated) {
+  char text[16];
+  snprintf(text, sizeof(text), "%s%d", negated ? "n" : "", var);
+  Append(buf, text);
+}
+
+// --- SplitMix64 ---
+
+void BenchRngSeed(BenchRng* rng, uint64_t seed) { rng->state_ = seed; }
+
+uint64_t BenchRngNext(BenchRng* rng) {
+  uint64_t z = (rng->state_ += 0x9E3779B97F4A7C15ull);
+  z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9ull;
+  z = (z ^ (z >> 27)) * 0x94D049BB133111EBull;
+  return z ^ (z >> 31);
+}
+
+static int RandomBelow(BenchRng* rng, int n) {
+  return (int)(BenchRngNext(rng) % (uint64_t)n);
+}
+
+// Sorteia `k` variáveis distintas em 1..num_vars (k <= num_vars)
+static void PickDistinct(BenchRng* rng, int num_vars, int k, int* out) {
+  for (int i = 0; i < k; i++) {
+    bool repeated;
+    do {
+      out[i] = 1 + RandomBelow(rng, num_vars);
+      repeated = false;
+      for (int j = 0; j < i; j++) repeated |= out[j] == out[i];
+    } while (repeated);
+  }
+}
+
+// --- Geradores ---
+
+char* GenRandomKCnf(BenchRng* rng, int num_vars, int k, double ratio,
+                    bool reversed) {
+  if (k > num_vars) k = num_vars;
+  int num_clauses = (int)(ratio * num_vars + 0.5);
+  if (num_clauses < 1) num_clauses = 1;
+  int* lits = (int*)malloc(sizeof(int) * num_clauses * k);
+  for (int c = 0; c < num_clauses; c++) {
+    PickDistinct(rng, num_vars, k, lits + c * k);
+    for (int j = 0; j < k; j++)
+      if (BenchRngNext(rng) & 1) lits[c * k + j] = -lits[c * k + j];
+  }
+
+  GenBuffer buf = {NULL, 0, 0};
+  for (int i = 0; i < num_clauses; i++) {
+    int c = reversed ? num_clauses - 1 - i : i;
+    Append(&buf, i ? " a (" : "(");
+    for (int j = 0; j < k; j++) {
+      if (j) Append(&buf, " v ");
+      int lit = lits[c * k + j];
+      AppendLit(&buf, abs(lit), lit < 0);
+    }
+    Append(&buf, ")");
+  }
+  free(lits);
+  return buf.data_;
+}
+
+char* GenPigeonhole(int holes) {
+  int pigeons = holes + 1;
+  GenBuffer buf = {NULL, 0, 0};
+  bool first = true;
+  // Variável p*holes + h + 1: pombo p está na casa h
+  for (int p = 0; p < pigeons; p++) {
+    Append(&buf, first ? "(" : " a (");
+    first = false;
+    for (int h = 0; h < holes; h++) {
+      if (h) Append(&buf, " v ");
+      AppendLit(&buf, p * holes + h + 1, false);
+    }
+    Append(&buf, ")");
+  }
+  for (int h = 0; h < holes; h++) {
+    for (int p = 0; p < pigeons; p++) {
+      for (int q = p + 1; q < pigeons; q++) {
+        Append(&buf, " a (");
+        AppendLit(&buf, p * holes + h + 1, true);
+        Append(&buf, " v ");
+        AppendLit(&buf, q * holes + h + 1, true);
+        Append(&buf, ")");
+      }
+    }
+  }
+  return buf.data_;
+}
+
+char* GenXorChain(int num_vars, bool reversed) {
+  GenBuffer buf = {NULL, 0, 0};
+  for (int i = 1; i <= num_vars; i++) {
+    if (i > 1) Append(&buf, " x ");
+    AppendLit(&buf, reversed ? num_vars + 1 - i : i, false);
+  }
+  return buf.data_;
+}
+
+char* GenImplicationLadder(int depth, bool flat) {
+  GenBuffer buf = {NULL, 0, 0};
+  for (int i = 1; i < depth; i++) {
+    AppendLit(&buf, i, flat);
+    Append(&buf, flat ? " v " : " > (");
+  }
+  AppendLit(&buf, depth, false);
+  if (!flat)
+    for (int i = 1; i < depth; i++) Append(&buf, ")");
+  return buf.data_;
+}
+
+char* GenWideDnf(BenchRng* rng, int num_vars, int num_cubes, int width) {
+  if (width > num_vars) width = num_vars;
+  int* vars = (int*)malloc(sizeof(int) * width);
+  GenBuffer buf = {NULL, 0, 0};
+  for (int c = 0; c < num_cubes; c++) {
+    Append(&buf, c ? " v (" : "(");
+    PickDistinct(rng, num_vars, width, vars);
+    for (int j = 0; j < width; j++) {
+      if (j) Append(&buf, " a ");
+      AppendLit(&buf, vars[j], BenchRngNext(rng) & 1);
+    }
+    Append(&buf, ")");
+  }
+  free(vars);
+  return buf.data_;
+}
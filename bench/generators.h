@@ -0,0 +1,37 @@
+#ifndef GENERATORS_H
+#define GENERATORS_H
+
+#include <stdbool.h>
+#include <stdint.h>
+
+// Geradores determinísticos de sentenças para o benchmark. Todos retornam
+// uma string na sintaxe do projeto (liberar com free); os aleatórios
+// dependem só da semente do BenchRng.
+
+typedef struct {
+  uint64_t state_;
+} BenchRng;
+
+void BenchRngSeed(BenchRng* rng, uint64_t seed);
+uint64_t BenchRngNext(BenchRng* rng);
+
+// k-CNF aleatória: round(ratio * num_vars) cláusulas de k variáveis
+// distintas com sinais aleatórios (3-CNF fica difícil perto de 4.26).
+// Com reversed = true as mesmas cláusulas saem em ordem inversa.
+char* GenRandomKCnf(BenchRng* rng, int num_vars, int k, double ratio,
+                    bool reversed);
+
+// Casa dos pombos: holes + 1 pombos em `holes` casas (insatisfatível)
+char* GenPigeonhole(int holes);
+
+// Paridade 1 x 2 x ... x n; com reversed = true, n x ... x 1
+char* GenXorChain(int num_vars, bool reversed);
+
+// Escada de implicações aninhadas 1 > (2 > (... > n)); com flat = true,
+// a forma equivalente n1 v n2 v ... v n(n-1) v n
+char* GenImplicationLadder(int depth, bool flat);
+
+// DNF larga: num_cubes cubos de `width` literais sobre num_vars variáveis
+char* GenWideDnf(BenchRng* rng, int num_vars, int num_cubes, int width);
+
+#endif  // GENERATORS_H
@@ -0,0 +1,33 @@
+#ifndef BATCH_H
+#define BATCH_H
+
+#include <stdio.h>
+
+// Modo em lote: lê uma tarefa por linha (até BATCH_MAX_LINE bytes) e escreve
+// um objeto JSON por linha, na mesma ordem da entrada. Formato da tarefa:
+//
+//   equiv <sentenca1> ; <sentenca2>
+//   cnf <sentenca>
+//   dnf <sentenca>
+//   mincnf <sentenca>   (CNF com minimização de dois níveis)
+//   mindnf <sentenca>   (DNF com minimização de dois níveis)
+//   sat <sentenca>
+//   count <sentenca>    (número de modelos, em decimal, como string JSON)
+//   tseitin <sentenca>
+//
+// Linhas vazias e iniciadas por '#' são ignoradas. Cada resultado traz o
+// campo "id" com o número da linha de origem e, com a instrumentação
+// ligada (ConvertStatsEnable), o campo "stats" com os contadores da tarefa.
+// Uma sentença inválida, uma operação desconhecida ou uma linha longa
+// demais dão o campo "error" no lugar do resultado, em qualquer operação.
+
+#define BATCH_MAX_LINE ((size_t)1 << 24)
+
+// Processa uma tarefa e retorna a linha JSON (sem '\n'; liberar com free)
+char* BatchRunJob(const char* line, long long id);
+
+// Distribui as tarefas de `in` entre `num_threads` trabalhadores
+// (0 = número de processadores). Retorna o número de tarefas processadas.
+long long BatchRun(FILE* in, FILE* out, int num_threads);
+
+#endif  // BATCH_H
@@ -0,0 +1,71 @@
+#ifndef BDD_H
+#define BDD_H
+
+#include <stdbool.h>
+
+#include "dnf_converter.h"
+#include "var_map.h"
+
+// Diagramas de decisão binária reduzidos e ordenados (ROBDD):
+// - tabela única: cada par (variável, filhos) existe uma só vez, então
+//   funções iguais têm o mesmo nó e equivalência é comparação de índices
+// - cache de ITE (if-then-else) mapeado diretamente
+// - ordem das variáveis configurável antes da construção
+// - coleta de lixo por marcação a partir das raízes externas
+// Variáveis são índices densos 1-based (os mesmos do VarMap usado).
+
+typedef int BddRef;
+
+#define BDD_FALSE 0
+#define BDD_TRUE 1
+#define BDD_INVALID (-1)  // limite de nós excedido
+
+typedef struct {
+  long long nodes_;       // nós vivos (incluindo os terminais)
+  long long peak_nodes_;
+  long long cache_lookups_;
+  long long cache_hits_;
+  long long gc_runs_;
+} BddStats;
+
+typedef struct BddManager BddManager;
+
+BddManager* BddManagerCreate(void);
+void BddManagerDestroy(BddManager* mgr);
+
+// order[i] é a variável do nível i. Só vale antes de existirem nós
+// internos; variáveis fora de `order` ficam abaixo, na ordem em que
+// aparecerem. Retorna false, sem mudar a ordem atual, se já houver nós ou
+// se `order` tiver variável menor que 1 ou repetida.
+bool BddSetVarOrder(BddManager* mgr, const int* order, int size);
+
+// Limite de nós vivos (0 = sem limite). Operações que precisariam de mais
+// retornam BDD_INVALID.
+void BddSetNodeLimit(BddManager* mgr, int limit);
+
+BddRef BddVar(BddManager* mgr, int var);
+BddRef BddIte(BddManager* mgr, BddRef f, BddRef g, BddRef h);
+BddRef BddNot(BddManager* mgr, BddRef f);
+BddRef BddAnd(BddManager* mgr, BddRef f, BddRef g);
+BddRef BddOr(BddManager* mgr, BddRef f, BddRef g);
+BddRef BddXor(BddManager* mgr, BddRef f, BddRef g);
+
+// Constrói o BDD de `root`; as variáveis da árvore são mapeadas com
+// VarMapGet em `vars`, que deve ser o mesmo entre consultas que serão
+// comparadas
+BddRef BddFromExpr(BddManager* mgr, const ExprNode* root, VarMap* vars);
+
+// Raízes externas: só nós alcançáveis a partir de referências mantidas
+// sobrevivem à coleta, que ocorre no início das operações públicas
+void BddIncRef(BddManager* mgr, BddRef f);
+void BddDecRef(BddManager* mgr, BddRef f);
+void BddCollectGarbage(BddManager* mgr);
+
+// Preenche values[1..num_vars] com uma atribuição que satisfaz f
+// (variáveis fora do caminho ficam false). Retorna false se f == BDD_FALSE.
+bool BddPickSat(const BddManager* mgr, BddRef f, bool* values);
+
+int BddNumVars(const BddManager* mgr);
+const BddStats* BddGetStats(const BddManager* mgr);
+
+#endif  // BDD_H
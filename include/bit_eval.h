@@ -0,0 +1,58 @@
+#ifndef BIT_EVAL_H
+#define BIT_EVAL_H
+
+#include <stdbool.h>
+#include <stdint.h>
+
+#include "dnf_converter.h"
+#include "var_map.h"
+
+// Avaliador bit-paralelo: a árvore é achatada em um programa pós-fixo de
+// registradores e cada instrução processa BIT_BLOCK_BITS atribuições de
+// uma vez (palavras de 64 bits; AVX2/AVX-512 quando disponíveis).
+
+#define BIT_BLOCK_WORDS 8
+#define BIT_BLOCK_BITS (64 * BIT_BLOCK_WORDS)
+
+typedef struct {
+  uint64_t w_[BIT_BLOCK_WORDS];
+} BitBlock;
+
+typedef enum { BIT_NOT, BIT_AND, BIT_OR, BIT_XOR, BIT_IMPLIES } BitOpCode;
+
+// Operandos e destino são "slots": 0..num_vars_-1 são as colunas das
+// variáveis, os seguintes são registradores temporários
+typedef struct {
+  BitOpCode op_;
+  int dst_;
+  int a_;
+  int b_;
+} BitInstr;
+
+typedef struct {
+  BitInstr* code_;
+  int size_;
+  int num_vars_;
+  int num_regs_;
+  int result_;  // slot com o resultado
+  VarMap vars_;
+} BitProgram;
+
+// Retorna false se a árvore estiver malformada
+bool BitProgramCompile(const ExprNode* root, BitProgram* prog);
+void BitProgramFree(BitProgram* prog);
+
+// Avalia um bloco; slots deve ter num_vars_ + num_regs_ blocos, com as
+// colunas das variáveis já preenchidas. Retorna o bloco do resultado.
+const BitBlock* BitProgramEvalBlock(const BitProgram* prog, BitBlock* slots);
+
+// Varredura exaustiva das 2^num_vars_ atribuições (num_vars_ <= 62):
+// retorna o índice da primeira em que o programa vale `target` (bit j =
+// valor da variável densa j + 1) ou -1 se não houver
+long long BitProgramFindAssignment(const BitProgram* prog, bool target);
+
+// Número de atribuições em que o programa vale `target` (-1 se
+// num_vars_ > 62)
+long long BitProgramCountAssignments(const BitProgram* prog, bool target);
+
+#endif  // BIT_EVAL_H
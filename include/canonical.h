@@ -0,0 +1,39 @@
+#ifndef CANONICAL_H
+#define CANONICAL_H
+
+#include <stdbool.h>
+#include <stddef.h>
+
+#include "dnf_converter.h"
+#include "expr_arena.h"
+
+// Forma canônica de sentenças para o cache de resultados: os operandos de
+// a, v e x são ordenados por um hash estrutural que ignora os nomes das
+// variáveis, e as variáveis são renumeradas 1..n na ordem da primeira
+// ocorrência nessa ordem. Sentenças iguais a menos de nomes e da ordem de
+// operandos comutativos costumam ter o mesmo texto canônico (empates de
+// hash mantêm a ordem original, então a forma não é completa, mas textos
+// iguais sempre denotam a mesma sentença).
+
+typedef struct {
+  char* text_;  // sentença canônica totalmente parentizada
+  size_t len_;
+  int* names_;  // names_[i] = variável original da variável canônica i
+  int num_vars_;
+  int max_var_;  // maior variável original
+} CanonicalForm;
+
+// Forma canônica de roots[0..num_roots) (nós de `arena`) com uma única
+// numeração; as partes ficam separadas por " ; " no texto. Com
+// commutative = true as partes também são ordenadas (ex.: os dois lados
+// de uma equivalência).
+void CanonicalizeTrees(const ExprArena* arena, ExprNode* const* roots,
+                       int num_roots, bool commutative, CanonicalForm* form);
+void CanonicalFormFree(CanonicalForm* form);
+
+// Reescreve um texto sobre as variáveis canônicas com os nomes originais;
+// números acima de num_vars_ (auxiliares de Tseitin) continuam após
+// max_var_. Liberar com free.
+char* CanonicalMapText(const CanonicalForm* form, const char* text);
+
+#endif  // CANONICAL_H
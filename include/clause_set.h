@@ -0,0 +1,41 @@
+#ifndef CLAUSE_SET_H
+#define CLAUSE_SET_H
+
+#include <stddef.h>
+
+// Conjunto de cláusulas em armazenamento plano (sem malloc por cláusula).
+// Literais seguem a convenção DIMACS: +v para a variável v, -v para nv.
+// A cláusula i ocupa lits_[starts_[i] .. starts_[i + 1] - 1].
+typedef struct {
+  int num_vars_;
+  int num_clauses_;
+  int* lits_;
+  size_t num_lits_;
+  size_t lits_cap_;
+  size_t* starts_;  // num_clauses_ + 1 entradas
+  size_t starts_cap_;
+} ClauseSet;
+
+void ClauseSetInit(ClauseSet* cs);
+void ClauseSetFree(ClauseSet* cs);
+void ClauseSetClear(ClauseSet* cs);
+
+// Reserva espaço para pelo menos esse total de cláusulas e literais
+void ClauseSetReserve(ClauseSet* cs, size_t num_clauses, size_t num_lits);
+
+// Copia `size` literais como uma nova cláusula e atualiza num_vars_
+void ClauseSetAdd(ClauseSet* cs, const int* lits, int size);
+
+// Cláusulas construídas literal a literal (sem buffer temporário)
+void ClauseSetPushLit(ClauseSet* cs, int lit);
+void ClauseSetEndClause(ClauseSet* cs);
+
+static inline const int* ClauseSetClause(const ClauseSet* cs, int i) {
+  return cs->lits_ + cs->starts_[i];
+}
+
+static inline int ClauseSetSize(const ClauseSet* cs, int i) {
+  return (int)(cs->starts_[i + 1] - cs->starts_[i]);
+}
+
+#endif  // CLAUSE_SET_H
@@ -0,0 +1,64 @@
+#ifndef CNF_ENCODER_H
+#define CNF_ENCODER_H
+
+#include <stdbool.h>
+
+#include "clause_set.h"
+#include "dnf_converter.h"
+#include "var_map.h"
+
+// Codificação de Tseitin: cada porta (a, v, x, >) recebe uma variável
+// auxiliar, gerando uma CNF equisatisfatível de tamanho linear.
+// As variáveis da entrada ocupam os índices 1..num_inputs_ (em `vars_`);
+// as auxiliares vêm em seguida.
+typedef struct {
+  VarMap vars_;
+  int num_inputs_;
+  int num_vars_;
+  ClauseSet cnf_;
+} CnfEncoding;
+
+// Retorna false se a árvore estiver malformada (filho ausente)
+bool EncodeTseitin(const ExprNode* root, CnfEncoding* enc);
+
+// Plaisted-Greenbaum: emite só a direção da definição exigida pela
+// polaridade de cada porta (menos cláusulas; modelos não fixam auxiliares)
+bool EncodePlaistedGreenbaum(const ExprNode* root, CnfEncoding* enc);
+
+void CnfEncodingFree(CnfEncoding* enc);
+
+// Codificação incremental: várias sentenças no mesmo espaço de variáveis
+// (Plaisted-Greenbaum, completando as direções que faltarem quando uma
+// porta volta a aparecer com outra polaridade). As variáveis da entrada e
+// as auxiliares são numeradas na ordem em que aparecem; nós da mesma arena
+// já codificados são reaproveitados entre as chamadas. As cláusulas novas
+// se acumulam em enc_.cnf_ até o chamador consumi-las (ClauseSetClear).
+typedef struct {
+  CnfEncoding enc_;  // vars_: entradas vistas; num_vars_: total usado
+  int* input_var_;   // índice denso da entrada -> variável
+  int input_cap_;
+  int* gate_lit_;
+  unsigned char* gate_pol_;
+  int gate_cap_;
+} CnfIncremental;
+
+void CnfIncrementalInit(CnfIncremental* inc);
+void CnfIncrementalFree(CnfIncremental* inc);
+
+// Variável de uma variável original (criada se necessário) / 0 se ausente
+int CnfIncrementalInput(CnfIncremental* inc, int var);
+int CnfIncrementalFind(const CnfIncremental* inc, int var);
+
+// Variável nova sem correspondente na entrada (seletores, por exemplo)
+int CnfIncrementalNewVar(CnfIncremental* inc);
+
+// *lit recebe um literal que implica `root` (com both = true, também é
+// implicado por ela)
+bool CnfIncrementalLiteral(CnfIncremental* inc, const ExprNode* root,
+                           bool both, int* lit);
+
+// Afirma `root`; com guard != 0 cada cláusula recebe também esse literal
+bool CnfIncrementalAssert(CnfIncremental* inc, const ExprNode* root,
+                          int guard);
+
+#endif  // CNF_ENCODER_H
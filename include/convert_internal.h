@@ -0,0 +1,141 @@
+#ifndef CONVERT_INTERNAL_H
+#define CONVERT_INTERNAL_H
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdio.h>
+
+#include "clause_set.h"
+#include "cnf_encoder.h"
+#include "dnf_converter.h"
+#include "expr_arena.h"
+#include "var_map.h"
+
+// Interno da biblioteca, fora da API pública: o que dnf_converter.c
+// compartilha com os módulos construídos sobre ele.
+
+// --- Instrumentação ---
+// STATS_ON() é a constante false quando LOGICA_STATS não está definido, e
+// o compilador descarta os ganchos inteiros
+
+#if defined(_MSC_VER)
+#define THREAD_LOCAL __declspec(thread)
+#else
+#define THREAD_LOCAL __thread
+#endif
+
+extern THREAD_LOCAL ConvertStats g_stats;
+
+#ifdef LOGICA_STATS
+extern bool g_stats_enabled;
+#define STATS_ON() (g_stats_enabled)
+#else
+#define STATS_ON() false
+#endif
+
+#define STAT_ADD(field, n)               \
+  do {                                   \
+    if (STATS_ON()) g_stats.field += (n); \
+  } while (0)
+
+// Início de uma fase: instante e nós já criados na arena (se houver)
+typedef struct {
+  double start_;
+  size_t nodes_;
+} PhaseMark;
+
+PhaseMark PhaseBegin(const ExprArena* arena);
+void PhaseEnd(ConvertPhase phase, PhaseMark mark, const ExprArena* arena);
+
+// Libera a arena contabilizando seus nós
+void ReleaseArena(ExprArena* arena);
+
+// --- Passos sobre a árvore ---
+// Cada passo aloca o resultado na arena recebida e nunca libera a
+// entrada. Visit memoiza por id de nó, para que cada subexpressão do DAG
+// seja reescrita uma vez.
+
+typedef struct PassContext PassContext;
+typedef ExprNode* (*PassFn)(PassContext* ctx, ExprNode* node);
+
+struct PassContext {
+  ExprArena* arena_;
+  ExprMemo memo_;
+  PassFn rewrite_;
+  long long depth_;  // Visit aninhadas no momento
+  const signed char* fixed_;  // PropagateLiterals: valor por variável
+  int num_fixed_;
+  ExprNode** deferred_;  // nós adiados por profundidade, mais novo no topo
+  int num_deferred_;
+  int deferred_cap_;
+  bool blocked_;  // a reescrita atual foi abandonada; desfaz até VisitDeep
+};
+
+// rewrite_ aplicado a node, uma vez por nó; variáveis voltam como estão
+ExprNode* Visit(PassContext* ctx, ExprNode* node);
+// Visit sem limite de profundidade; é a entrada de cada passo
+ExprNode* VisitDeep(PassContext* ctx, ExprNode* node);
+void PassContextFree(PassContext* ctx);
+
+ExprNode* NormalizeOperators(ExprArena* arena, ExprNode* node);  // sem x, >
+ExprNode* PushNegations(ExprArena* arena, ExprNode* node);       // NNF
+ExprNode* DistributeDNF(ExprArena* arena, ExprNode* node);
+ExprNode* DistributeCNF(ExprArena* arena, ExprNode* node);
+
+// Literais do topo de uma sentença em NNF propagados para o resto
+// (preprocess.c); o resultado é equivalente à entrada
+ExprNode* PropagateLiterals(ExprArena* arena, ExprNode* root);
+
+// Passos da forma normal de *root, comuns a ConvertToCNF/DNF e à saída
+// DIMACS: normalização, NNF, propagação de literais e distribuição; na
+// DNF simplificada os cubos saem direto da NNF. *root recebe a última
+// árvore. Fora de MINIMIZE_NONE os termos simplificados no nível pedido
+// vão para terms, sobre as variáveis de vars (ambos já iniciados), e
+// retorna true; false com MINIMIZE_NONE ou se a árvore não der termos.
+bool NormalFormTerms(ExprArena* arena, ExprNode** root, bool cnf,
+                     MinimizeLevel level, VarMap* vars, ClauseSet* terms);
+
+// --- Resolvedor ---
+
+// CDCL sobre enc->cnf_ (que pode ser simplificada no caminho); se
+// satisfatível, values[original] recebe o modelo das entradas de enc
+bool SatByCdcl(CnfEncoding* enc, bool* values);
+
+// --- Texto ---
+
+// Buffer de texto que cresce conforme necessário; com out_ o conteúdo vai
+// para o arquivo sempre que passaria de TEXT_FLUSH_BYTES, e o buffer só
+// guarda o trecho ainda não escrito
+typedef struct {
+  char* data_;
+  size_t size_;
+  size_t cap_;
+  FILE* out_;
+} TextBuffer;
+
+#define TEXT_FLUSH_BYTES (64 * 1024)
+
+void FlushText(TextBuffer* buf);
+void AppendText(TextBuffer* buf, const char* text, size_t len);
+
+// --- Conversões sem cache ---
+// Implementações das funções principais (dnf_converter.h) que calculam o
+// resultado direto da entrada; cached_convert.c as chama numa falta do
+// cache de resultados, ou sempre, com o cache desligado
+
+char* ConvertToNormalForm(const char* input, bool cnf, MinimizeLevel level);
+char* ConvertToEncodedCNF(const char* input, CnfMode mode);
+char* CountModelsUncached(const char* input);
+bool CheckEquivalenceUncached(const char* input1, const char* input2,
+                              bool** counterexample, int* size);
+bool FindSatisfyingModelUncached(const char* input, bool** model,
+                                 int* model_size);
+
+// --- Termos da DNF ---
+
+// Cubos da NNF em root, acrescentados a terms com CoverAddTerm sobre as
+// variáveis de vars. A variável mais à esquerda é registrada primeiro,
+// para "(x a nx)" quando não há cubos. false se root não estiver em NNF.
+bool CollectDnfCubes(const ExprNode* root, VarMap* vars, ClauseSet* terms);
+
+#endif  // CONVERT_INTERNAL_H
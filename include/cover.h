@@ -0,0 +1,40 @@
+#ifndef COVER_H
+#define COVER_H
+
+#include <stdbool.h>
+
+#include "clause_set.h"
+#include "dnf_converter.h"
+#include "var_map.h"
+
+// Formas de dois níveis como conjuntos de termos: cada termo (cláusula na
+// CNF, cubo na DNF) é um vetor de literais DIMACS sem repetição, ordenado
+// pela variável, guardado em um ClauseSet. Na CNF o conjunto vazio de
+// termos é verdadeiro e o termo vazio é falso; na DNF, o contrário.
+
+// Até este número de variáveis a minimização é exata (Quine-McCluskey)
+#define COVER_EXACT_MAX_VARS 10
+
+// Extrai os termos de uma árvore já distribuída: outer = NODE_AND para CNF
+// (conjunção de cláusulas) ou NODE_OR para DNF (disjunção de cubos). As
+// variáveis são numeradas com VarMapGet em `vars`; termos com l e nl
+// (tautologias na CNF, contradições na DNF) são descartados. Retorna false
+// se a árvore não estiver na forma esperada.
+bool CoverFromTree(const ExprNode* root, NodeType outer, VarMap* vars,
+                   ClauseSet* terms);
+
+// Acrescenta um termo: lits (alterado) é ordenado e perde as repetições; o
+// termo é descartado se tiver l e nl
+void CoverAddTerm(ClauseSet* terms, int* lits, int size);
+
+// Remove termos que contêm todos os literais de outro (subsunção),
+// inclusive duplicatas; a ordem dos restantes é mantida
+void CoverRemoveSubsumed(ClauseSet* terms);
+
+// Minimização de dois níveis: primos de Quine-McCluskey com cobertura
+// gulosa após os essenciais até COVER_EXACT_MAX_VARS variáveis; acima
+// disso, EXPAND + IRREDUNDANT no estilo do Espresso. Com cnf = true os
+// termos são cláusulas e a minimização é feita sobre o complemento.
+void CoverMinimize(ClauseSet* terms, bool cnf);
+
+#endif  // COVER_H
@@ -0,0 +1,54 @@
+#ifndef DIMACS_H
+#define DIMACS_H
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdio.h>
+
+#include "clause_set.h"
+
+// Formato DIMACS, para trocar instâncias com outros resolvedores:
+//
+//   c comentário
+//   p cnf <variáveis> <cláusulas>
+//   1 -2 3 0
+//
+// WCNF (MaxSAT) no formato clássico, "p wcnf <vars> <cláusulas> <top>" com
+// o peso antes de cada cláusula (peso >= top: rígida), ou no formato sem
+// cabeçalho, com "h" antes das rígidas e o peso antes das demais. Um '%'
+// no início de linha encerra a leitura (arquivos do SATLIB).
+
+typedef struct {
+  ClauseSet clauses_;     // numeração da entrada
+  long long* weights_;    // WCNF: peso de cada cláusula; NULL em CNF
+  size_t weights_cap_;
+  long long top_;         // WCNF: peso a partir do qual a cláusula é rígida
+  int declared_vars_;     // do cabeçalho (0 se não houver)
+  int declared_clauses_;
+} DimacsFormula;
+
+void DimacsFormulaInit(DimacsFormula* f);
+void DimacsFormulaFree(DimacsFormula* f);
+
+static inline bool DimacsIsHard(const DimacsFormula* f, int i) {
+  return !f->weights_ || f->weights_[i] >= f->top_;
+}
+
+// Lê data[0..size) direto para o armazenamento plano, sem cópia nem malloc
+// por cláusula. Retorna false em erro de sintaxe; *error_line (se não
+// NULL) recebe a linha, começando em 1. Em erro f fica zerada, sem memória
+// alocada; em sucesso deve ser liberada com DimacsFormulaFree.
+bool DimacsParse(const char* data, size_t size, DimacsFormula* f,
+                 long long* error_line);
+
+// O mesmo sobre um arquivo mapeado em memória (mapped_file.h);
+// *error_line recebe -1 se o arquivo não puder ser aberto
+bool DimacsReadFile(const char* path, DimacsFormula* f,
+                    long long* error_line);
+
+// Escreve o cabeçalho e as cláusulas com um buffer próprio (sem fprintf
+// por literal). O cabeçalho traz o maior número de variáveis entre o
+// declarado e o usado. Retorna false se a escrita falhar.
+bool DimacsWrite(FILE* out, const DimacsFormula* f);
+
+#endif  // DIMACS_H
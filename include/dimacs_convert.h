@@ -0,0 +1,26 @@
+#ifndef DIMACS_CONVERT_H
+#define DIMACS_CONVERT_H
+
+#include <stdbool.h>
+#include <stdio.h>
+
+#include "dnf_converter.h"
+
+// Funções principais sobre o formato DIMACS, para trocar instâncias com
+// outros resolvedores (leitura e escrita em dimacs.h); o cache de
+// resultados não se aplica.
+
+// (iv) para um arquivo DIMACS CNF mapeado em memória; em WCNF vale só a
+// parte rígida. O modelo (se model não for NULL) é indexado pela variável
+// do arquivo, como em FindSatisfyingModel. Se error_line não for NULL
+// recebe 0, ou, quando o arquivo não pôde ser lido (e o retorno é false),
+// a linha do erro de sintaxe ou -1.
+bool FindSatisfyingModelDimacs(const char* path, bool** model,
+                               int* model_size, long long* error_line);
+
+// (ii) em DIMACS: a FNC de ConvertToCNFMode, com as mesmas variáveis, vai
+// para out por um buffer. Retorna false se a sentença for inválida ou se
+// a escrita falhar.
+bool WriteCNFDimacs(const char* input, CnfMode mode, FILE* out);
+
+#endif  // DIMACS_CONVERT_H
@@ -2,6 +2,7 @@
 #define DNF_CONVERTER_H
 
 #include <stdbool.h>
+#include <stdio.h>
 
 typedef enum {
   NODE_VAR,     // Variável (1, 2, 3)
@@ -12,31 +13,147 @@ typedef enum {
   NODE_IMPLIES  // Implicação (>)
 } NodeType;
 
+typedef struct ExprArena ExprArena;  // ver expr_arena.h
+
 typedef struct ExprNode {
   NodeType type_;
   int variable_;
   struct ExprNode* left_;
   struct ExprNode* right_;
+  int id_;  // id único na arena (0 para nós alocados com malloc)
 } ExprNode;
 
+// Modo de saída de ConvertToCNFMode
+typedef enum {
+  CNF_EQUIVALENT,         // Distributiva: equivalente, pode crescer 2^n
+  CNF_TSEITIN,            // Equisatisfatível, linear (bi-implicações)
+  CNF_PLAISTED_GREENBAUM  // Equisatisfatível, linear (só a polaridade usada)
+} CnfMode;
+
+// Simplificação da saída de ConvertToCNFMinimized / ConvertToDNFMinimized
+typedef enum {
+  MINIMIZE_NONE,       // árvore distribuída como está
+  MINIMIZE_SIMPLIFY,   // sem literais repetidos, tautologias, contradições
+                       // e termos subsumidos (padrão de CNF/DNF)
+  MINIMIZE_TWO_LEVEL   // também minimização de dois níveis (ver cover.h)
+} MinimizeLevel;
+
 // --- Funções Principais do Projeto ---
+// Com o cache de resultados ligado (ResultCacheSetBudget, result_cache.h),
+// as funções abaixo, exceto FindSatisfyingModelFile, reaproveitam
+// resultados de sentenças iguais a menos de nomes de variáveis e da ordem
+// de operandos comutativos; a saída pode então diferir da versão sem cache
+// na ordem dos termos, mas não no significado.
 
 // (i) Verifica se duas expressões são equivalentes
 bool AreEquivalent(const char* input1, const char* input2);
 
+// (i) com contraexemplo: se não forem equivalentes, *counterexample recebe
+// um vetor (liberar com free) indexado pelo número da variável com uma
+// atribuição em que as duas diferem, e *size = maior variável + 1.
+// Recebe NULL se forem equivalentes ou a entrada for inválida.
+bool CheckEquivalence(const char* input1, const char* input2,
+                      bool** counterexample, int* size);
+
+// Os BDDs das verificações de equivalência ficam numa estrutura por
+// thread, reaproveitada entre consultas; threads que fazem verificações
+// devem chamar ConvertThreadRelease antes de terminar
+void ConvertThreadRelease(void);
+
 // (ii) Converte para Forma Normal Conjuntiva (FNC/CNF)
 char* ConvertToCNF(const char* input);
 
+// (ii) com escolha do modo; nos modos equisatisfatíveis as variáveis
+// auxiliares são numeradas a partir da maior variável da entrada + 1
+char* ConvertToCNFMode(const char* input, CnfMode mode);
+
 // (iii) Converte para Forma Normal Disjuntiva (FND/DNF)
 char* ConvertToDNF(const char* input);
 
+// (ii)/(iii) com escolha do nível de simplificação dos termos
+char* ConvertToCNFMinimized(const char* input, MinimizeLevel level);
+char* ConvertToDNFMinimized(const char* input, MinimizeLevel level);
+
 // (iv) Verifica se é Satisfatível (SAT)
 bool IsSatisfiable(const char* input);
 
+// (iv) com modelo: se satisfatível, *model recebe um vetor (liberar com free)
+// indexado pelo número da variável e *model_size = maior variável + 1
+bool FindSatisfyingModel(const char* input, bool** model, int* model_size);
+
+// (iv) com a sentença lida de um arquivo mapeado em memória (sem cópia)
+bool FindSatisfyingModelFile(const char* path, bool** model,
+                             int* model_size);
+
+// (iv) Número de atribuições das variáveis que aparecem na sentença que a
+// satisfazem, em decimal (liberar com free); NULL se a entrada for inválida
+char* CountModels(const char* input);
+
+// --- Instrumentação (opcional) ---
+// Contadores e tempos por fase das funções principais. Vêm desligados: sem
+// ConvertStatsEnable(true) cada gancho custa só o teste de uma flag, e com
+// LOGICA_STATS desligado no CMake nem é compilado. Os contadores são por
+// thread (cada trabalhador do modo em lote acumula os seus).
+
+typedef enum {
+  PHASE_PARSE,
+  PHASE_NORMALIZE,       // NormalizeOperators
+  PHASE_PUSH_NEGATIONS,  // PushNegations
+  PHASE_PREPROCESS,      // propagação de literais e simplificação da CNF
+  PHASE_DISTRIBUTE,      // DistributeDNF / DistributeCNF
+  PHASE_SIMPLIFY,        // extração e simplificação dos termos (cover.h)
+  PHASE_ENCODE,          // codificação Tseitin / Plaisted-Greenbaum
+  PHASE_SOLVE,           // varredura, BDD ou CDCL
+  PHASE_TO_STRING,
+  NUM_CONVERT_PHASES
+} ConvertPhase;
+
+typedef struct {
+  long long nodes_allocated_;      // nós criados (na arena ou com malloc)
+  long long nodes_freed_;
+  long long nodes_shared_;         // criações resolvidas pela tabela única
+  long long peak_nodes_;           // maior número de nós em uma chamada
+  long long clone_calls_;          // CloneTree / CloneTreeArena
+  long long clone_bytes_;
+  long long distribute_rewrites_;  // aplicações da distributiva
+  long long max_depth_;            // maior recursão dos passos sobre a árvore
+  long long evaluate_calls_;       // EvaluateTree, contando a recursão
+  long long output_bytes_;         // texto gerado pelas conversões
+  long long removed_vars_;         // pré-processamento (preprocess.h)
+  long long removed_clauses_;
+  long long phase_calls_[NUM_CONVERT_PHASES];
+  long long phase_nodes_[NUM_CONVERT_PHASES];  // nós criados na fase
+  double phase_seconds_[NUM_CONVERT_PHASES];   // tempo de parede
+} ConvertStats;
+
+// Liga ou desliga a coleta em todas as threads (chamar antes de iniciar o
+// trabalho); retorna false se a instrumentação não foi compilada
+bool ConvertStatsEnable(bool enabled);
+bool ConvertStatsEnabled(void);
+
+// Zera / copia os contadores da thread atual
+void ConvertStatsReset(void);
+void ConvertStatsGet(ConvertStats* stats);
+
+const char* ConvertPhaseName(ConvertPhase phase);
+
 // --- Funções Auxiliares de Manipulação ---
+// O parser é iterativo e respeita a precedência n > a > v > > > x (ver
+// expr_table.h); retorna NULL se faltar um operando
 ExprNode* ParseExpression(const char* input, int* pos);
 void FreeExprTree(ExprNode* node);
 int TreeToString(ExprNode* node, char* buffer, int size);
 ExprNode* CloneTree(ExprNode* node);
 
+// Valor da sentença na atribuição vars_mask (variável v no bit v - 1, até
+// a variável 31); uma atribuição por vez, como oráculo dos testes
+bool EvaluateTree(ExprNode* node, int vars_mask);
+
+// Variantes que alocam os nós na arena (sem FreeExprTree; ver expr_arena.h)
+ExprNode* ParseExpressionArena(ExprArena* arena, const char* input, int* pos);
+ExprNode* CloneTreeArena(ExprArena* arena, ExprNode* node);
+
+// Sentença lida de um arquivo mapeado em memória, com os nós na arena
+ExprNode* ParseExpressionFile(ExprArena* arena, const char* path);
+
 #endif  // DNF_CONVERTER_H
\ No newline at end of file
@@ -0,0 +1,36 @@
+#ifndef DNF_CUBES_H
+#define DNF_CUBES_H
+
+#include <stdbool.h>
+#include <stdio.h>
+
+#include "dnf_converter.h"
+
+// Termos da FND sob demanda, sem montar a árvore distribuída: a memória
+// cresce com a sentença, não com o número de cubos. Cada cubo é uma lista
+// de literais (+v / -v, com os números de variável da sentença) sem
+// repetições nem l e nl juntos; ao contrário de ConvertToDNF, cubos
+// repetidos ou subsumidos não são removidos.
+typedef struct DnfCubeIterator DnfCubeIterator;
+
+// Retorna NULL se a sentença for inválida
+DnfCubeIterator* DnfCubeIteratorCreate(const char* input);
+void DnfCubeIteratorDestroy(DnfCubeIterator* it);
+
+// Próximo cubo, válido até a próxima chamada, ou NULL quando acabarem
+// (um cubo vazio é a constante verdadeira)
+const int* DnfCubeIteratorNext(DnfCubeIterator* it, int* size);
+
+// Chama callback para cada cubo até ele retornar false; retorna o número
+// de cubos visitados ou -1 se a sentença for inválida
+typedef bool (*DnfCubeCallback)(const int* lits, int size, void* user);
+long long ForEachDnfCube(const char* input, DnfCubeCallback callback,
+                         void* user);
+
+// Escreve a FND em out como "(1 a n2) v (3) v ...", em blocos, sem montar
+// o texto inteiro; no máximo max_cubes cubos (todos se max_cubes <= 0).
+// Sem cubos escreve "(x a nx)". Retorna o número de cubos escritos ou -1
+// se a sentença for inválida (nada é escrito).
+long long WriteDnfCubes(const char* input, FILE* out, long long max_cubes);
+
+#endif  // DNF_CUBES_H
@@ -0,0 +1,57 @@
+#ifndef EXPR_ARENA_H
+#define EXPR_ARENA_H
+
+#include <stddef.h>
+
+#include "dnf_converter.h"
+
+// Arena de nós: os nós são alocados sequencialmente em blocos contíguos
+// alinhados à linha de cache e liberados todos de uma vez. Nós da arena
+// nunca devem ser passados para FreeExprTree.
+//
+// A arena também é uma fábrica com hash-consing: uma tabela única indexada
+// por (tipo, variável, filhos) garante que subexpressões estruturalmente
+// iguais sejam o mesmo nó. Assim a árvore vira um DAG, cópias são apenas
+// ponteiros e igualdade estrutural é comparação de ponteiros. Os nós são
+// imutáveis e recebem ids densos (1, 2, ...) usados para memoização.
+
+typedef struct ExprArenaBlock {
+  struct ExprArenaBlock* next_;
+  void* raw_;  // ponteiro devolvido pelo malloc (antes do alinhamento)
+  size_t capacity_;
+} ExprArenaBlock;
+
+struct ExprArena {
+  ExprArenaBlock* blocks_;  // bloco atual primeiro
+  ExprNode* next_;          // próximo nó livre do bloco atual
+  ExprNode* end_;
+  size_t num_nodes_;
+  size_t num_blocks_;
+
+  ExprNode** table_;  // tabela única (endereçamento aberto)
+  size_t table_cap_;  // potência de 2
+  size_t num_lookups_;
+  size_t num_hits_;
+};
+
+void ExprArenaInit(ExprArena* arena);
+
+// Libera todos os nós alocados na arena
+void ExprArenaRelease(ExprArena* arena);
+
+ExprNode* ArenaNode(ExprArena* arena, NodeType type, ExprNode* left,
+                    ExprNode* right);
+ExprNode* ArenaVar(ExprArena* arena, int var);
+
+// Resultados de um passo indexados pelo id do nó de entrada
+typedef struct {
+  ExprNode** results_;
+  size_t cap_;
+} ExprMemo;
+
+void ExprMemoInit(ExprMemo* memo);
+void ExprMemoFree(ExprMemo* memo);
+ExprNode* ExprMemoGet(const ExprMemo* memo, const ExprNode* node);
+void ExprMemoSet(ExprMemo* memo, const ExprNode* node, ExprNode* result);
+
+#endif  // EXPR_ARENA_H
@@ -0,0 +1,54 @@
+#ifndef EXPR_TABLE_H
+#define EXPR_TABLE_H
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+
+#include "dnf_converter.h"
+
+// Tabela plana de nós produzida pelo parser iterativo: estrutura de vetores
+// (struct-of-arrays) com filhos como índices de 32 bits em vez de
+// ponteiros. Os nós são emitidos em pós-ordem, então os filhos sempre têm
+// índice menor que o pai e a raiz é o último nó: qualquer passo de baixo
+// para cima é um único laço sobre os vetores, sem recursão.
+//
+// A tabela não é reescrita: ParseExpressionArena a converte, num laço, no
+// DAG da arena (expr_arena.h), que é a representação usada pelos passos.
+//
+// Sintaxe: variáveis são inteiros positivos, n (not) é prefixo, ( ) agrupa
+// e os operadores binários, do mais forte para o mais fraco, são
+//   a (and)  >  v (or)  >  > (implies)  >  x (xor)
+// a, v e x associam à esquerda; > associa à direita.
+
+#define EXPR_TABLE_NONE UINT32_MAX  // filho ausente
+
+typedef struct {
+  uint8_t* types_;   // NodeType
+  int32_t* vars_;    // NODE_VAR: número da variável
+  uint32_t* left_;   // NODE_NOT usa só left_
+  uint32_t* right_;
+  uint32_t count_;
+  uint32_t cap_;
+} ExprTable;
+
+void ExprTableInit(ExprTable* table);
+void ExprTableFree(ExprTable* table);
+
+static inline uint32_t ExprTableRoot(const ExprTable* table) {
+  return table->count_ - 1;
+}
+
+// Analisa input[0 .. len) (não precisa terminar em '\0'), substituindo o
+// conteúdo da tabela. A análise para no primeiro caractere que não pode
+// continuar a expressão e *end recebe sua posição; parênteses não fechados
+// no fim da entrada são aceitos. Retorna false se faltar um operando ou
+// se aparecer a variável 0 (literais são codificados como +-v).
+bool ExprTableParse(ExprTable* table, const char* input, size_t len,
+                    size_t* end);
+
+// Analisa um arquivo mapeado em memória (sem copiar o texto); além da
+// expressão o arquivo só pode conter espaços e quebras de linha
+bool ExprTableParseFile(ExprTable* table, const char* path);
+
+#endif  // EXPR_TABLE_H
@@ -0,0 +1,20 @@
+#ifndef MAPPED_FILE_H
+#define MAPPED_FILE_H
+
+#include <stdbool.h>
+#include <stddef.h>
+
+// Arquivo somente leitura mapeado em memória (mmap / MapViewOfFile): o
+// conteúdo é lido direto das páginas do arquivo, sem cópia para um buffer.
+// Os dados não terminam em '\0'; use sempre size_.
+typedef struct {
+  const char* data_;
+  size_t size_;
+  void* handle_;  // Win32: objeto de mapeamento
+} MappedFile;
+
+// Retorna false se o arquivo não puder ser aberto ou mapeado
+bool MappedFileOpen(MappedFile* file, const char* path);
+void MappedFileClose(MappedFile* file);
+
+#endif  // MAPPED_FILE_H
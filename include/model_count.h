@@ -0,0 +1,43 @@
+#ifndef MODEL_COUNT_H
+#define MODEL_COUNT_H
+
+#include <stdbool.h>
+#include <stdint.h>
+
+#include "clause_set.h"
+
+// Contagem exata de modelos (#SAT) de uma CNF: DPLL que, após cada
+// propagação, separa as cláusulas ainda abertas em componentes conexos
+// (sem variáveis em comum) e multiplica as contagens deles. Cada
+// componente contado é guardado em cache pela lista ordenada das suas
+// variáveis e cláusulas, que determina a subfórmula restante.
+
+// Acima deste número de palavras de chave o cache é esvaziado
+#define MODEL_COUNT_CACHE_WORDS (1 << 24)
+
+// Natural de precisão arbitrária (palavras de 32 bits, menos
+// significativa primeiro; size_ = 0 representa o zero)
+typedef struct {
+  uint32_t* limbs_;
+  int size_;
+  int cap_;
+} BigNat;
+
+void BigNatInit(BigNat* n);
+void BigNatFree(BigNat* n);
+void BigNatSetU64(BigNat* n, uint64_t value);
+void BigNatCopy(BigNat* dst, const BigNat* src);
+void BigNatAdd(BigNat* dst, const BigNat* src);            // dst += src
+void BigNatMul(BigNat* dst, const BigNat* a, const BigNat* b);  // dst != a, b
+void BigNatShiftLeft(BigNat* n, int bits);                 // n *= 2^bits
+
+static inline bool BigNatIsZero(const BigNat* n) { return n->size_ == 0; }
+
+// Representação decimal (liberar com free)
+char* BigNatToString(const BigNat* n);
+
+// Número de atribuições das variáveis 1..num_vars que satisfazem `cnf`
+// (variáveis sem ocorrência contam em dobro)
+void ModelCountClauses(const ClauseSet* cnf, int num_vars, BigNat* count);
+
+#endif  // MODEL_COUNT_H
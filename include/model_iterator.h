@@ -0,0 +1,22 @@
+#ifndef MODEL_ITERATOR_H
+#define MODEL_ITERATOR_H
+
+#include <stdbool.h>
+
+#include "dnf_converter.h"
+
+// (iv) Enumeração de todos os modelos, um por chamada: cada modelo achado
+// é bloqueado antes de procurar o próximo, no mesmo resolvedor. Os modelos
+// diferem nas variáveis que aparecem na sentença (as demais posições
+// ficam false).
+typedef struct ModelIterator ModelIterator;
+
+// Retorna NULL se a sentença for inválida
+ModelIterator* ModelIteratorCreate(const char* input);
+void ModelIteratorDestroy(ModelIterator* it);
+
+// Próximo modelo, indexado pelo número da variável e válido até a próxima
+// chamada (*model_size = maior variável + 1), ou NULL quando acabarem
+const bool* ModelIteratorNext(ModelIterator* it, int* model_size);
+
+#endif  // MODEL_ITERATOR_H
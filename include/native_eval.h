@@ -0,0 +1,51 @@
+#ifndef NATIVE_EVAL_H
+#define NATIVE_EVAL_H
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+
+#include "bit_eval.h"
+
+// Avaliação nativa de sentenças fixas: o programa de bit_eval.h vira C em
+// linha reta, sem desvios, sobre palavras de 64 bits (uma atribuição por
+// bit), compilado pelo compilador local em uma biblioteca compartilhada e
+// carregado com dlopen. As bibliotecas ficam em disco com o hash do código
+// gerado, do compilador, das opções e da CPU no nome, ao lado do código
+// (comparado com o gerado antes da carga), então a mesma sentença só é
+// compilada uma vez. Se não houver compilador, se o diretório não for
+// privado (ou no Windows), a avaliação usa o interpretador de bit_eval.h
+// com o mesmo resultado.
+//
+// Compilador: variável de ambiente CC (padrão "cc"). Diretório das
+// bibliotecas: o argumento cache_dir, senão LOGICA_NATIVE_CACHE, senão
+// $TMPDIR/logica-<uid> (ou /tmp/logica-<uid>), criado com modo 0700. Só
+// são carregados arquivos do usuário efetivo, num diretório dele, que
+// grupo e outros não podem alterar.
+
+// Acima deste número de instruções não vale a pena esperar o compilador
+#define NATIVE_EVAL_MAX_INSTRS (1 << 18)
+
+// columns[i] aponta as num_words palavras da variável densa i + 1 (ver
+// prog_.vars_); out recebe as num_words palavras do resultado
+typedef void (*NativeEvalFn)(const uint64_t* const* columns, uint64_t* out,
+                             size_t num_words);
+
+typedef struct {
+  BitProgram prog_;  // numeração das variáveis e interpretador
+  NativeEvalFn fn_;  // NULL quando a compilação não foi possível
+  void* library_;
+  uint64_t hash_;    // hash do código, do compilador, das opções e da CPU
+} NativeEval;
+
+// Retorna false apenas se a árvore estiver malformada; a falta de
+// compilador não é erro (fn_ fica NULL)
+bool NativeEvalCompile(const ExprNode* root, const char* cache_dir,
+                       NativeEval* eval);
+void NativeEvalFree(NativeEval* eval);
+
+// Avalia com a função nativa ou, sem ela, com o interpretador
+void NativeEvalRun(const NativeEval* eval, const uint64_t* const* columns,
+                   uint64_t* out, size_t num_words);
+
+#endif  // NATIVE_EVAL_H
@@ -0,0 +1,57 @@
+#ifndef PREPROCESS_H
+#define PREPROCESS_H
+
+#include <stdbool.h>
+
+#include "clause_set.h"
+
+// Simplificação de uma CNF antes do resolvedor, no estilo do SatELite:
+// - propagação de unidades e eliminação de literais puros
+// - substituição de literais equivalentes (componentes fortemente conexos
+//   do grafo de implicações das cláusulas binárias)
+// - subsunção e auto-subsunção (remoção de literais)
+// - eliminação de variáveis por resolução quando o número de cláusulas
+//   não aumenta
+// A CNF resultante é só equisatisfatível: as cláusulas removidas vão para
+// uma pilha de reconstrução que estende qualquer modelo da CNF simplificada
+// a um modelo da original.
+
+// Eliminação só de variáveis com até este número de ocorrências (somando
+// as duas polaridades) e resolventes com até este número de literais
+#define PREPROCESS_ELIM_MAX_OCC 16
+#define PREPROCESS_MAX_RESOLVENT 20
+
+// Subsunção só a partir de cláusulas cujo literal menos frequente aparece
+// em até este número de cláusulas
+#define PREPROCESS_SUBSUME_MAX_OCC 256
+
+// Rodadas de equivalências + subsunção + eliminação enquanto houver ganho
+#define PREPROCESS_MAX_ROUNDS 4
+
+// Conflitos que o CDCL tenta antes de pré-processar (instâncias fáceis
+// saem antes e não pagam a simplificação)
+#define PREPROCESS_AFTER_CONFLICTS 1000
+
+// A CNF simplificada só substitui a original no resolvedor se tiver ao
+// menos esta porcentagem de cláusulas a menos
+#define PREPROCESS_MIN_REMOVED_PERCENT 10
+
+typedef struct {
+  ClauseSet clauses_;  // cláusulas removidas; o primeiro literal é a
+                       // testemunha, ligada se a cláusula estiver falsa
+  int removed_vars_;   // variáveis fixadas, substituídas ou eliminadas
+} CnfReconstruction;
+
+// Simplifica cnf no lugar, sobre as variáveis 1..num_vars e com a mesma
+// numeração (as removidas deixam de aparecer; cnf->num_vars_ continua
+// num_vars). Retorna false se provar a CNF insatisfatível. rec é sempre
+// inicializada.
+bool PreprocessClauses(ClauseSet* cnf, int num_vars, CnfReconstruction* rec);
+
+// model (num_vars + 1 posições, indexado pela variável) satisfaz a CNF
+// simplificada; na volta satisfaz a original
+void CnfReconstructModel(const CnfReconstruction* rec, bool* model);
+
+void CnfReconstructionFree(CnfReconstruction* rec);
+
+#endif  // PREPROCESS_H
@@ -0,0 +1,44 @@
+#ifndef RESULT_CACHE_H
+#define RESULT_CACHE_H
+
+#include <stdbool.h>
+#include <stddef.h>
+
+// Cache de resultados compartilhado pelo processo: chaves e valores são
+// bytes opacos (as funções de dnf_converter.h usam a operação seguida da
+// forma canônica da sentença, ver canonical.h). Dividido em
+// RESULT_CACHE_SHARDS partes com trava própria, escolhidas pelo hash da
+// chave; cada parte respeita sua fração do orçamento e descarta entradas
+// pelo algoritmo do relógio (CLOCK, aproximação de LRU).
+
+#define RESULT_CACHE_SHARDS 16
+
+typedef struct {
+  long long hits_;
+  long long misses_;
+  long long insertions_;
+  long long evictions_;
+  long long entries_;
+  size_t bytes_;   // chaves, valores e metadados das entradas
+  size_t budget_;
+} ResultCacheStats;
+
+// Orçamento de memória em bytes; 0 (padrão) desliga e esvazia o cache.
+// Como ConvertStatsEnable, deve ser chamada antes de iniciar o trabalho.
+void ResultCacheSetBudget(size_t bytes);
+bool ResultCacheEnabled(void);
+
+void ResultCacheClear(void);
+void ResultCacheGetStats(ResultCacheStats* stats);
+
+// Se a chave estiver no cache, *value recebe uma cópia do valor (liberar
+// com free) e *value_len o tamanho
+bool ResultCacheLookup(const void* key, size_t key_len, void** value,
+                       size_t* value_len);
+
+// Insere (ou mantém, se a chave já existir) e descarta entradas até a
+// parte voltar ao orçamento
+void ResultCacheStore(const void* key, size_t key_len, const void* value,
+                      size_t value_len);
+
+#endif  // RESULT_CACHE_H
@@ -0,0 +1,37 @@
+#ifndef SAT_SESSION_H
+#define SAT_SESSION_H
+
+#include <stdbool.h>
+
+#include "dnf_converter.h"
+
+// Consultas incrementais: uma sessão carrega uma sentença base uma vez e
+// responde várias consultas relacionadas. A base é codificada uma só vez e
+// o resolvedor mantém as cláusulas aprendidas e as atividades entre as
+// chamadas. As restrições de SatSessionAdd valem até o Pop do nível em que
+// foram incluídas (as incluídas fora de qualquer Push são permanentes).
+
+typedef struct SatSession SatSession;
+
+// Retorna NULL se a base for inválida
+SatSession* SatSessionCreate(const char* base);
+void SatSessionDestroy(SatSession* session);
+
+// Restrição extra no nível atual; false se a sentença for inválida
+bool SatSessionAdd(SatSession* session, const char* formula);
+void SatSessionPush(SatSession* session);
+bool SatSessionPop(SatSession* session);  // false sem nível aberto
+
+// Base e restrições ativas com os literais de `assumptions` (+v / -v
+// sobre as variáveis originais, v >= 1) supostos verdadeiros. Modelo como
+// em FindSatisfyingModel (model pode ser NULL).
+bool SatSessionSolve(SatSession* session, const int* assumptions,
+                     int num_assumptions, bool** model, int* model_size);
+
+// true se `candidate` for equivalente à base em todas as atribuições que
+// satisfazem as restrições ativas; senão *counterexample recebe uma delas
+// (ver CheckEquivalence). Retorna false se a candidata for inválida.
+bool SatSessionCompare(SatSession* session, const char* candidate,
+                       bool** counterexample, int* size);
+
+#endif  // SAT_SESSION_H
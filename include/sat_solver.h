@@ -0,0 +1,66 @@
+#ifndef SAT_SOLVER_H
+#define SAT_SOLVER_H
+
+#include <stdbool.h>
+
+#include "clause_set.h"
+
+// Resolvedor CDCL (conflict-driven clause learning):
+// - propagação com dois literais vigiados (two-watched literals)
+// - heurística de decisão VSIDS com salvamento de fase
+// - reinícios pela sequência de Luby
+// - redução periódica da base de cláusulas aprendidas (por LBD/atividade)
+// Literais na interface seguem a convenção DIMACS (+v / -v, v >= 1).
+
+typedef enum {
+  SAT_UNKNOWN = 0,
+  SAT_SATISFIABLE = 10,
+  SAT_UNSATISFIABLE = 20
+} SatResult;
+
+typedef struct {
+  long long conflicts_;
+  long long decisions_;
+  long long propagations_;
+  long long restarts_;
+  long long reductions_;
+} SatSolverStats;
+
+typedef struct SatSolver SatSolver;
+
+SatSolver* SatSolverCreate(void);
+void SatSolverDestroy(SatSolver* solver);
+
+// Cria uma nova variável e retorna seu índice (1-based)
+int SatSolverNewVar(SatSolver* solver);
+int SatSolverNumVars(const SatSolver* solver);
+
+// Retorna false se a fórmula já se tornou insatisfatível
+bool SatSolverAddClause(SatSolver* solver, const int* lits, int size);
+bool SatSolverAddClauseSet(SatSolver* solver, const ClauseSet* cs);
+
+// Com limite >= 0, cada chamada de Solve desiste após esse número de
+// conflitos e retorna SAT_UNKNOWN; a próxima continua com as cláusulas
+// aprendidas. -1 (o padrão) remove o limite.
+void SatSolverSetConflictLimit(SatSolver* solver, long long max_conflicts);
+
+SatResult SatSolverSolve(SatSolver* solver);
+
+// Resolve supondo os literais de `assumptions` verdadeiros. As cláusulas
+// aprendidas, as atividades e as fases são mantidas entre as chamadas, e
+// uma resposta UNSAT causada só pelas suposições não torna o resolvedor
+// inconsistente: basta chamar de novo com outras suposições.
+SatResult SatSolverSolveAssuming(SatSolver* solver, const int* assumptions,
+                                 int num_assumptions);
+
+// Após SAT_UNSATISFIABLE por causa das suposições: subconjunto delas que
+// já é inconsistente com as cláusulas (vazio se as cláusulas sozinhas
+// forem insatisfatíveis)
+const int* SatSolverFailedAssumptions(const SatSolver* solver, int* size);
+
+// Valor da variável no último modelo encontrado (true/false)
+bool SatSolverModelValue(const SatSolver* solver, int var);
+
+const SatSolverStats* SatSolverGetStats(const SatSolver* solver);
+
+#endif  // SAT_SOLVER_H
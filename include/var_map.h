@@ -0,0 +1,24 @@
+#ifndef VAR_MAP_H
+#define VAR_MAP_H
+
+// Mapeia os números de variável da entrada (quaisquer inteiros >= 0) para
+// índices densos 1..count_, na ordem da primeira ocorrência.
+typedef struct {
+  int* keys_;
+  int* values_;
+  int capacity_;  // potência de 2
+  int count_;
+  int* originals_;  // originals_[i] = variável original do índice denso i
+  int originals_cap_;
+} VarMap;
+
+void VarMapInit(VarMap* map);
+void VarMapFree(VarMap* map);
+
+// Retorna o índice denso de `var`, criando um novo se necessário
+int VarMapGet(VarMap* map, int var);
+
+// Retorna o índice denso de `var` ou 0 se a variável não foi mapeada
+int VarMapFind(const VarMap* map, int var);
+
+#endif  // VAR_MAP_H
@@ -0,0 +1,62 @@
+#ifndef XOR_SYSTEM_H
+#define XOR_SYSTEM_H
+
+#include <stdbool.h>
+
+#include "clause_set.h"
+#include "dnf_converter.h"
+
+// Restrições de paridade como sistema linear sobre GF(2): cada equação é
+// x_a ^ x_b ^ ... = rhs. Cadeias de x viram uma equação em vez da
+// expansão (A a nB) v (nA a B), que dobra de tamanho a cada operando; a
+// eliminação de Gauss-Jordan decide o sistema de uma vez.
+
+// Literais por bloco na codificação em cláusulas (2^(k-1) cláusulas de k
+// literais cada)
+#define XOR_CHUNK_SIZE 4
+
+// Acima deste custo estimado (linhas * posto * palavras por linha) a
+// eliminação desiste e retorna XOR_TOO_LARGE
+#define XOR_GAUSS_MAX_WORD_OPS (1ll << 32)
+
+typedef enum { XOR_CONSISTENT, XOR_INCONSISTENT, XOR_TOO_LARGE } XorStatus;
+
+typedef struct {
+  ClauseSet rows_;  // variáveis (>= 1) de cada equação
+  bool* rhs_;
+  int rhs_cap_;
+  int num_vars_;  // maior variável
+} XorSystem;
+
+void XorSystemInit(XorSystem* sys);
+void XorSystemFree(XorSystem* sys);
+
+// Acrescenta vars[0] ^ ... ^ vars[size - 1] = rhs; variáveis repetidas se
+// cancelam aos pares
+void XorSystemAdd(XorSystem* sys, const int* vars, int size, bool rhs);
+
+// Eliminação de Gauss-Jordan numa matriz de bits com uma coluna por
+// variável presente. Se consistente, reduced (se não NULL) recebe as
+// equações da forma escalonada reduzida, uma por pivô (o posto é
+// reduced->rows_.num_clauses_), e values (se não NULL, num_vars_ + 1
+// posições) uma solução com as variáveis livres em false.
+XorStatus XorSystemSolve(const XorSystem* sys, XorSystem* reduced,
+                         bool* values);
+
+// Folhas da cadeia de x que começa em root, atravessando também as
+// negações: *leaves (realocado, *cap posições) recebe os nós que não são
+// x nem n e *parity o número de negações removidas módulo 2, ou seja,
+// root = leaves[0] x ... x leaves[size - 1] x parity. Retorna false se a
+// árvore estiver malformada.
+bool XorChainLeaves(const ExprNode* root, const ExprNode*** leaves,
+                    int* size, int* cap, bool* parity);
+
+// Cláusulas de lits[0] ^ ... ^ lits[size - 1] = rhs (literais DIMACS). Até
+// XOR_CHUNK_SIZE literais a codificação é direta; cadeias maiores são
+// cortadas em blocos ligados por auxiliares novas (++*num_vars), cada uma
+// igual ao XOR do seu bloco, então o tamanho é linear e as auxiliares são
+// funções das variáveis originais.
+void XorEncodeClauses(const int* lits, int size, bool rhs, int* num_vars,
+                      ClauseSet* out);
+
+#endif  // XOR_SYSTEM_H
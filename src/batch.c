@@ -0,0 +1,444 @@
+#include "../include/batch.h"
+
+#include <stdbool.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "../include/dnf_converter.h"
+#include "../include/expr_table.h"
+
+#ifdef _WIN32
+#include <windows.h>
+#else
+#include <pthread.h>
+#include <unistd.h>
+#endif
+
+// --- Primitivas de Thread (Win32 / POSIX) ---
+
+#ifdef _WIN32
+typedef HANDLE Thread;
+typedef CRITICAL_SECTION Mutex;
+typedef CONDITION_VARIABLE CondVar;
+
+static void MutexInit(Mutex* m) { InitializeCriticalSection(m); }
+static void MutexDestroy(Mutex* m) { DeleteCriticalSection(m); }
+static void MutexLock(Mutex* m) { EnterCriticalSection(m); }
+static void MutexUnlock(Mutex* m) { LeaveCriticalSection(m); }
+static void CondInit(CondVar* c) { InitializeConditionVariable(c); }
+static void CondDestroy(CondVar* c) { (void)c; }
+static void CondWait(CondVar* c, Mutex* m) {
+  SleepConditionVariableCS(c, m, INFINITE);
+}
+static void CondSignal(CondVar* c) { WakeConditionVariable(c); }
+static void CondBroadcast(CondVar* c) { WakeAllConditionVariable(c); }
+
+static int NumProcessors(void) {
+  SYSTEM_INFO info;
+  GetSystemInfo(&info);
+  return (int)info.dwNumberOfProcessors;
+}
+#else
+typedef pthread_t Thread;
+typedef pthread_mutex_t Mutex;
+typedef pthread_cond_t CondVar;
+
+static void MutexInit(Mutex* m) { pthread_mutex_init(m, NULL); }
+static void MutexDestroy(Mutex* m) { pthread_mutex_destroy(m); }
+static void MutexLock(Mutex* m) { pthread_mutex_lock(m); }
+static void MutexUnlock(Mutex* m) { pthread_mutex_unlock(m); }
+static void CondInit(CondVar* c) { pthread_cond_init(c, NULL); }
+static void CondDestroy(CondVar* c) { pthread_cond_destroy(c); }
+static void CondWait(CondVar* c, Mutex* m) { pthread_cond_wait(c, m); }
+static void CondSignal(CondVar* c) { pthread_cond_signal(c); }
+static void CondBroadcast(CondVar* c) { pthread_cond_broadcast(c); }
+
+static int NumProcessors(void) { return (int)sysconf(_SC_NPROCESSORS_ONLN); }
+#endif
+
+// --- Texto JSON ---
+
+typedef struct {
+  char* data_;
+  size_t size_;
+  size_t cap_;
+} JsonBuffer;
+
+static void JsonAppend(JsonBuffer* buf, const char* text, size_t len) {
+  if (buf->size_ + len + 1 > buf->cap_) {
+    while (buf->size_ + len + 1 > buf->cap_) buf->cap_ *= 2;
+    buf->data_ = (char*)realloc(buf->data_, buf->cap_);
+  }
+  memcpy(buf->data_ + buf->size_, text, len);
+  buf->size_ += len;
+  buf->data_[buf->size_] = '\0';
+}
+
+static void JsonText(JsonBuffer* buf, const char* text) {
+  JsonAppend(buf, text, strlen(text));
+}
+
+static void JsonString(JsonBuffer* buf, const char* text) {
+  JsonAppend(buf, "\"", 1);
+  for (const char* p = text; *p; p++) {
+    char esc[8];
+    if (*p == '"' || *p == '\\') {
+      esc[0] = '\\';
+      esc[1] = *p;
+      JsonAppend(buf, esc, 2);
+    } else if ((unsigned char)*p < 0x20) {
+      JsonAppend(buf, esc, sprintf(esc, "\\u%04x", (unsigned char)*p));
+    } else {
+      JsonAppend(buf, p, 1);
+    }
+  }
+  JsonAppend(buf, "\"", 1);
+}
+
+// Atribuição como lista de literais DIMACS: [1,-2,3]
+static void JsonModel(JsonBuffer* buf, const bool* model, int size) {
+  char lit[16];
+  JsonAppend(buf, "[", 1);
+  for (int v = 1; v < size; v++) {
+    int len = sprintf(lit, "%s%d", v > 1 ? "," : "", model[v] ? v : -v);
+    JsonAppend(buf, lit, len);
+  }
+  JsonAppend(buf, "]", 1);
+}
+
+// Contadores da tarefa (ver ConvertStats): tempos em microssegundos e só
+// as fases executadas
+static void JsonStats(JsonBuffer* buf, const ConvertStats* st) {
+  char text[512];
+  int len = sprintf(text,
+                    ",\"stats\":{\"nodes_allocated\":%lld,"
+                    "\"nodes_freed\":%lld,\"nodes_shared\":%lld,"
+                    "\"peak_nodes\":%lld,",
+                    st->nodes_allocated_, st->nodes_freed_, st->nodes_shared_,
+                    st->peak_nodes_);
+  JsonAppend(buf, text, len);
+  len = sprintf(text,
+                "\"clone_calls\":%lld,\"clone_bytes\":%lld,"
+                "\"distribute_rewrites\":%lld,\"max_depth\":%lld,"
+                "\"evaluate_calls\":%lld,\"output_bytes\":%lld,"
+                "\"removed_vars\":%lld,\"removed_clauses\":%lld,\"phases\":{",
+                st->clone_calls_, st->clone_bytes_, st->distribute_rewrites_,
+                st->max_depth_, st->evaluate_calls_, st->output_bytes_,
+                st->removed_vars_, st->removed_clauses_);
+  JsonAppend(buf, text, len);
+  bool first = true;
+  for (int p = 0; p < NUM_CONVERT_PHASES; p++) {
+    if (st->phase_calls_[p] == 0) continue;
+    len = sprintf(text,
+                  "%s\"%s\":{\"calls\":%lld,\"nodes\":%lld,\"us\":%.1f}",
+                  first ? "" : ",", ConvertPhaseName((ConvertPhase)p),
+                  st->phase_calls_[p], st->phase_nodes_[p],
+                  st->phase_seconds_[p] * 1e6);
+    JsonAppend(buf, text, len);
+    first = false;
+  }
+  JsonAppend(buf, "}}", 2);
+}
+
+// --- Tarefas ---
+
+static const char* SkipSpaces(const char* p) {
+  while (*p == ' ' || *p == '\t') p++;
+  return p;
+}
+
+// Aceita a sentença com o mesmo parser das funções principais: a tarefa
+// responde com "error" em vez de "sat":false para uma entrada inválida
+static bool ValidFormula(const char* formula, size_t len) {
+  ExprTable table;
+  ExprTableInit(&table);
+  size_t end;
+  bool ok = ExprTableParse(&table, formula, len, &end);
+  ExprTableFree(&table);
+  return ok;
+}
+
+char* BatchRunJob(const char* line, long long id) {
+  if (ConvertStatsEnabled()) ConvertStatsReset();
+  JsonBuffer buf = {(char*)malloc(128), 0, 128};
+  char head[48];
+  JsonAppend(&buf, head, sprintf(head, "{\"id\":%lld", id));
+
+  const char* p = SkipSpaces(line);
+  const char* op = p;
+  while (*p && *p != ' ' && *p != '\t') p++;
+  size_t op_len = (size_t)(p - op);
+  const char* formula = SkipSpaces(p);
+
+  if (op_len > 0 && op_len < 16) {
+    JsonText(&buf, ",\"op\":");
+    memcpy(head, op, op_len);
+    head[op_len] = '\0';
+    JsonString(&buf, head);
+  }
+
+  if (op_len == 5 && !strncmp(op, "equiv", 5)) {
+    const char* sep = strchr(formula, ';');
+    if (!sep) {
+      JsonText(&buf, ",\"error\":\"equiv espera <sentenca1> ; <sentenca2>\"}");
+      return buf.data_;
+    }
+    size_t len1 = (size_t)(sep - formula);
+    if (!ValidFormula(formula, len1) ||
+        !ValidFormula(sep + 1, strlen(sep + 1))) {
+      JsonText(&buf, ",\"error\":\"sentenca invalida\"}");
+      return buf.data_;
+    }
+    char* first = (char*)malloc(len1 + 1);
+    memcpy(first, formula, len1);
+    first[len1] = '\0';
+
+    bool* counterexample;
+    int size;
+    bool equivalent = CheckEquivalence(first, sep + 1, &counterexample, &size);
+    JsonText(&buf,
+             equivalent ? ",\"equivalent\":true" : ",\"equivalent\":false");
+    if (!equivalent && counterexample) {
+      JsonText(&buf, ",\"counterexample\":");
+      JsonModel(&buf, counterexample, size);
+    }
+    free(counterexample);
+    free(first);
+  } else if (op_len == 3 && !strncmp(op, "sat", 3)) {
+    bool* model;
+    int size;
+    if (!ValidFormula(formula, strlen(formula))) {
+      JsonText(&buf, ",\"error\":\"sentenca invalida\"");
+    } else if (FindSatisfyingModel(formula, &model, &size)) {
+      JsonText(&buf, ",\"sat\":true,\"model\":");
+      JsonModel(&buf, model, size);
+      free(model);
+    } else {
+      JsonText(&buf, ",\"sat\":false");
+    }
+  } else if (op_len == 5 && !strncmp(op, "count", 5)) {
+    char* count = CountModels(formula);
+    if (count) {
+      JsonText(&buf, ",\"count\":");
+      JsonString(&buf, count);
+      free(count);
+    } else {
+      JsonText(&buf, ",\"error\":\"sentenca invalida\"");
+    }
+  } else if ((op_len == 3 && !strncmp(op, "cnf", 3)) ||
+             (op_len == 3 && !strncmp(op, "dnf", 3)) ||
+             (op_len == 6 && !strncmp(op, "mincnf", 6)) ||
+             (op_len == 6 && !strncmp(op, "mindnf", 6)) ||
+             (op_len == 7 && !strncmp(op, "tseitin", 7))) {
+    char* result;
+    if (op[0] == 't')
+      result = ConvertToCNFMode(formula, CNF_TSEITIN);
+    else if (op[0] == 'm' && op[3] == 'c')
+      result = ConvertToCNFMinimized(formula, MINIMIZE_TWO_LEVEL);
+    else if (op[0] == 'm')
+      result = ConvertToDNFMinimized(formula, MINIMIZE_TWO_LEVEL);
+    else
+      result = op[0] == 'd' ? ConvertToDNF(formula) : ConvertToCNF(formula);
+    if (result) {
+      JsonText(&buf, ",\"result\":");
+      JsonString(&buf, result);
+      free(result);
+    } else {
+      JsonText(&buf, ",\"error\":\"sentenca invalida\"");
+    }
+  } else {
+    JsonText(&buf, ",\"error\":\"operacao desconhecida\"");
+  }
+  if (ConvertStatsEnabled()) {
+    ConvertStats stats;
+    ConvertStatsGet(&stats);
+    JsonStats(&buf, &stats);
+  }
+  JsonAppend(&buf, "}", 1);
+  return buf.data_;
+}
+
+// --- Leitura de Linhas (até BATCH_MAX_LINE bytes) ---
+
+// Retorna a próxima linha sem '\n' (liberar com free) ou NULL no fim. Uma
+// linha com mais de BATCH_MAX_LINE bytes é descartada até o '\n': retorna
+// NULL com *too_long = true.
+static char* ReadLine(FILE* in, bool* too_long) {
+  size_t cap = 256, size = 0;
+  char* line = (char*)malloc(cap);
+  *too_long = false;
+  for (;;) {
+    if (!fgets(line + size, (int)(cap - size), in)) {
+      if (size == 0) {
+        free(line);
+        return NULL;
+      }
+      break;
+    }
+    size += strlen(line + size);
+    if (size > 0 && line[size - 1] == '\n') break;
+    if (size > BATCH_MAX_LINE) {
+      int c;
+      while ((c = fgetc(in)) != EOF && c != '\n') continue;
+      free(line);
+      *too_long = true;
+      return NULL;
+    }
+    if (size + 1 == cap) {
+      cap *= 2;
+      line = (char*)realloc(line, cap);
+    }
+  }
+  while (size > 0 && (line[size - 1] == '\n' || line[size - 1] == '\r'))
+    line[--size] = '\0';
+  if (size > BATCH_MAX_LINE) {
+    free(line);
+    *too_long = true;
+    return NULL;
+  }
+  return line;
+}
+
+// --- Pool de Trabalhadores ---
+// Anel de tarefas: a thread principal lê a entrada e escreve os resultados
+// em ordem; os trabalhadores pegam a próxima tarefa ainda não iniciada.
+// O anel limita quantas tarefas ficam em memória ao mesmo tempo.
+
+#define JOBS_PER_THREAD 64
+
+typedef struct {
+  char* line_;  // NULL: linha longa demais
+  char* output_;
+  long long id_;
+  bool done_;
+} BatchJob;
+
+typedef struct {
+  BatchJob* ring_;
+  long long cap_;
+  long long head_;  // próxima a escrever
+  long long next_;  // próxima a processar
+  long long tail_;  // próxima posição livre
+  bool eof_;
+  Mutex lock_;
+  CondVar work_;  // há tarefa nova ou fim da entrada
+  CondVar done_;  // alguma tarefa terminou
+} BatchQueue;
+
+static char* LineTooLong(long long id) {
+  char* text = (char*)malloc(64);
+  sprintf(text, "{\"id\":%lld,\"error\":\"linha longa demais\"}", id);
+  return text;
+}
+
+#ifdef _WIN32
+static DWORD WINAPI Worker(LPVOID arg) {
+#else
+static void* Worker(void* arg) {
+#endif
+  BatchQueue* q = (BatchQueue*)arg;
+  MutexLock(&q->lock_);
+  for (;;) {
+    while (q->next_ == q->tail_ && !q->eof_) CondWait(&q->work_, &q->lock_);
+    if (q->next_ == q->tail_) break;
+    BatchJob* job = &q->ring_[q->next_++ % q->cap_];
+    MutexUnlock(&q->lock_);
+
+    char* output = job->line_ ? BatchRunJob(job->line_, job->id_)
+                              : LineTooLong(job->id_);
+
+    MutexLock(&q->lock_);
+    free(job->line_);
+    job->line_ = NULL;
+    job->output_ = output;
+    job->done_ = true;
+    CondSignal(&q->done_);
+  }
+  MutexUnlock(&q->lock_);
+  ConvertThreadRelease();
+  return 0;
+}
+
+long long BatchRun(FILE* in, FILE* out, int num_threads) {
+  if (num_threads <= 0) num_threads = NumProcessors();
+  if (num_threads <= 0) num_threads = 1;
+
+  BatchQueue q;
+  q.cap_ = (long long)num_threads * JOBS_PER_THREAD;
+  q.ring_ = (BatchJob*)calloc((size_t)q.cap_, sizeof(BatchJob));
+  q.head_ = q.next_ = q.tail_ = 0;
+  q.eof_ = false;
+  MutexInit(&q.lock_);
+  CondInit(&q.work_);
+  CondInit(&q.done_);
+
+  Thread* threads = (Thread*)malloc(sizeof(Thread) * num_threads);
+  for (int i = 0; i < num_threads; i++) {
+#ifdef _WIN32
+    threads[i] = CreateThread(NULL, 0, Worker, &q, 0, NULL);
+#else
+    pthread_create(&threads[i], NULL, Worker, &q);
+#endif
+  }
+
+  long long line_number = 0;
+  MutexLock(&q.lock_);
+  for (;;) {
+    // Escreve em ordem tudo o que já terminou
+    while (q.head_ < q.tail_ && q.ring_[q.head_ % q.cap_].done_) {
+      BatchJob* job = &q.ring_[q.head_++ % q.cap_];
+      char* output = job->output_;
+      job->output_ = NULL;
+      MutexUnlock(&q.lock_);
+      fputs(output, out);
+      fputc('\n', out);
+      free(output);
+      MutexLock(&q.lock_);
+    }
+    if (q.eof_ || q.tail_ - q.head_ == q.cap_) {
+      if (q.eof_ && q.head_ == q.tail_) break;
+      CondWait(&q.done_, &q.lock_);
+      continue;
+    }
+    MutexUnlock(&q.lock_);
+
+    bool too_long;
+    char* line = ReadLine(in, &too_long);
+    if (line || too_long) line_number++;
+    const char* start = line ? SkipSpaces(line) : NULL;
+    bool skip = line && (*start == '\0' || *start == '#');
+
+    MutexLock(&q.lock_);
+    if (!line && !too_long) {
+      q.eof_ = true;
+      CondBroadcast(&q.work_);
+    } else if (skip) {
+      free(line);
+    } else {
+      BatchJob* job = &q.ring_[q.tail_++ % q.cap_];
+      job->line_ = line;
+      job->output_ = NULL;
+      job->id_ = line_number;
+      job->done_ = false;
+      CondSignal(&q.work_);
+    }
+  }
+  long long total = q.tail_;
+  MutexUnlock(&q.lock_);
+
+  for (int i = 0; i < num_threads; i++) {
+#ifdef _WIN32
+    WaitForSingleObject(threads[i], INFINITE);
+    CloseHandle(threads[i]);
+#else
+    pthread_join(threads[i], NULL);
+#endif
+  }
+  fflush(out);
+  free(threads);
+  free(q.ring_);
+  CondDestroy(&q.work_);
+  CondDestroy(&q.done_);
+  MutexDestroy(&q.lock_);
+  return total;
+}
@@ -0,0 +1,478 @@
+#include "../include/bdd.h"
+
+#include <limits.h>
+#include <stdint.h>
+#include <stdlib.h>
+#include <string.h>
+
+// --- Representação Interna ---
+// Nós ficam em um vetor e são referenciados pelo índice; 0 e 1 são os
+// terminais. Nós livres (var_ = -1) formam uma lista pelo campo next_.
+
+#define FIRST_NODES 1024
+#define FIRST_CACHE 4096
+#define MAX_CACHE (1 << 22)
+#define GC_MIN_NODES 65536
+
+typedef struct {
+  int var_;  // 0 nos terminais, -1 em nós livres
+  BddRef low_;
+  BddRef high_;
+  BddRef next_;  // encadeamento na tabela única ou na lista livre
+} BddNode;
+
+typedef struct {
+  BddRef f_;
+  BddRef g_;
+  BddRef h_;
+  BddRef r_;
+} IteEntry;
+
+struct BddManager {
+  BddNode* nodes_;
+  int* refs_;  // referências externas (BddIncRef)
+  unsigned char* marks_;
+  int nodes_cap_;
+  int num_used_;  // nós já tocados (índices < num_used_)
+  BddRef free_list_;
+
+  BddRef* buckets_;  // tabela única; potência de 2
+  int buckets_cap_;
+
+  IteEntry* cache_;
+  int cache_cap_;  // potência de 2
+
+  int* level_;  // level_[v]: nível da variável v
+  int num_vars_;
+  int vars_cap_;
+  int next_level_;
+
+  int node_limit_;
+  long long gc_threshold_;
+  BddStats stats_;
+};
+
+static inline unsigned HashTriple(int a, int b, int c) {
+  uint64_t h = (uint64_t)(unsigned)a * 0x9E3779B97F4A7C15ull;
+  h ^= (uint64_t)(unsigned)b * 0xC2B2AE3D27D4EB4Full + (h >> 29);
+  h ^= (uint64_t)(unsigned)c * 0x165667B19E3779F9ull + (h >> 31);
+  return (unsigned)(h ^ (h >> 32));
+}
+
+static inline int Level(const BddManager* m, BddRef f) {
+  return f < 2 ? INT_MAX : m->level_[m->nodes_[f].var_];
+}
+
+// --- Criação / Destruição ---
+
+static void ClearCache(BddManager* m) {
+  memset(m->cache_, 0xFF, sizeof(IteEntry) * m->cache_cap_);
+}
+
+BddManager* BddManagerCreate(void) {
+  BddManager* m = (BddManager*)calloc(1, sizeof(BddManager));
+  m->nodes_cap_ = FIRST_NODES;
+  m->nodes_ = (BddNode*)malloc(sizeof(BddNode) * m->nodes_cap_);
+  m->refs_ = (int*)calloc(m->nodes_cap_, sizeof(int));
+  m->marks_ = (unsigned char*)calloc(m->nodes_cap_, 1);
+  for (int i = 0; i < 2; i++) {
+    m->nodes_[i].var_ = 0;
+    m->nodes_[i].low_ = m->nodes_[i].high_ = i;
+    m->nodes_[i].next_ = BDD_INVALID;
+  }
+  m->num_used_ = 2;
+  m->free_list_ = BDD_INVALID;
+
+  m->buckets_cap_ = FIRST_NODES;
+  m->buckets_ = (BddRef*)malloc(sizeof(BddRef) * m->buckets_cap_);
+  memset(m->buckets_, 0xFF, sizeof(BddRef) * m->buckets_cap_);
+
+  m->cache_cap_ = FIRST_CACHE;
+  m->cache_ = (IteEntry*)malloc(sizeof(IteEntry) * m->cache_cap_);
+  ClearCache(m);
+
+  m->level_ = (int*)malloc(sizeof(int) * 16);
+  m->vars_cap_ = 16;
+  m->gc_threshold_ = GC_MIN_NODES;
+  m->stats_.nodes_ = m->stats_.peak_nodes_ = 2;
+  return m;
+}
+
+void BddManagerDestroy(BddManager* m) {
+  if (!m) return;
+  free(m->nodes_);
+  free(m->refs_);
+  free(m->marks_);
+  free(m->buckets_);
+  free(m->cache_);
+  free(m->level_);
+  free(m);
+}
+
+static void GrowVars(BddManager* m, int num_vars) {
+  if (num_vars <= m->num_vars_) return;
+  if (num_vars >= m->vars_cap_) {
+    while (m->vars_cap_ <= num_vars) m->vars_cap_ *= 2;
+    m->level_ = (int*)realloc(m->level_, sizeof(int) * m->vars_cap_);
+  }
+  for (int v = m->num_vars_ + 1; v <= num_vars; v++)
+    m->level_[v] = m->next_level_++;
+  m->num_vars_ = num_vars;
+}
+
+bool BddSetVarOrder(BddManager* m, const int* order, int size) {
+  if (m->stats_.nodes_ > 2) return false;
+  int max_var = m->num_vars_;
+  for (int i = 0; i < size; i++) {
+    if (order[i] < 1) return false;
+    if (order[i] > max_var) max_var = order[i];
+  }
+  // Valida tudo antes de mexer no gerenciador: com uma variável repetida a
+  // ordem anterior continua valendo
+  bool* seen = (bool*)calloc(max_var + 1, sizeof(bool));
+  bool ok = true;
+  for (int i = 0; i < size && ok; i++) {
+    ok = !seen[order[i]];
+    seen[order[i]] = true;
+  }
+  free(seen);
+  if (!ok) return false;
+  GrowVars(m, max_var);
+
+  for (int v = 1; v <= m->num_vars_; v++) m->level_[v] = -1;
+  for (int i = 0; i < size; i++) m->level_[order[i]] = i;
+  m->next_level_ = size;
+  for (int v = 1; v <= m->num_vars_; v++)
+    if (m->level_[v] < 0) m->level_[v] = m->next_level_++;
+  return true;
+}
+
+void BddSetNodeLimit(BddManager* m, int limit) { m->node_limit_ = limit; }
+
+int BddNumVars(const BddManager* m) { return m->num_vars_; }
+
+const BddStats* BddGetStats(const BddManager* m) { return &m->stats_; }
+
+// --- Tabela Única ---
+
+static void InsertBucket(BddManager* m, BddRef f) {
+  const BddNode* n = &m->nodes_[f];
+  unsigned h = HashTriple(n->var_, n->low_, n->high_) & (m->buckets_cap_ - 1);
+  m->nodes_[f].next_ = m->buckets_[h];
+  m->buckets_[h] = f;
+}
+
+static void Rehash(BddManager* m, int cap) {
+  m->buckets_cap_ = cap;
+  m->buckets_ = (BddRef*)realloc(m->buckets_, sizeof(BddRef) * cap);
+  memset(m->buckets_, 0xFF, sizeof(BddRef) * cap);
+  for (int i = 2; i < m->num_used_; i++)
+    if (m->nodes_[i].var_ > 0) InsertBucket(m, i);
+}
+
+static void GrowNodes(BddManager* m) {
+  int cap = m->nodes_cap_ * 2;
+  m->nodes_ = (BddNode*)realloc(m->nodes_, sizeof(BddNode) * cap);
+  m->refs_ = (int*)realloc(m->refs_, sizeof(int) * cap);
+  m->marks_ = (unsigned char*)realloc(m->marks_, cap);
+  memset(m->refs_ + m->nodes_cap_, 0, sizeof(int) * (cap - m->nodes_cap_));
+  memset(m->marks_ + m->nodes_cap_, 0, cap - m->nodes_cap_);
+  m->nodes_cap_ = cap;
+
+  // O cache acompanha o número de nós até MAX_CACHE entradas
+  if (m->cache_cap_ < cap && m->cache_cap_ < MAX_CACHE) {
+    m->cache_cap_ *= 2;
+    m->cache_ =
+        (IteEntry*)realloc(m->cache_, sizeof(IteEntry) * m->cache_cap_);
+    ClearCache(m);
+  }
+}
+
+static BddRef MakeNode(BddManager* m, int var, BddRef low, BddRef high) {
+  if (low == high) return low;
+
+  unsigned h = HashTriple(var, low, high) & (m->buckets_cap_ - 1);
+  for (BddRef f = m->buckets_[h]; f != BDD_INVALID; f = m->nodes_[f].next_) {
+    const BddNode* n = &m->nodes_[f];
+    if (n->var_ == var && n->low_ == low && n->high_ == high) return f;
+  }
+
+  if (m->node_limit_ > 0 && m->stats_.nodes_ >= m->node_limit_)
+    return BDD_INVALID;
+
+  BddRef f = m->free_list_;
+  if (f != BDD_INVALID) {
+    m->free_list_ = m->nodes_[f].next_;
+  } else {
+    if (m->num_used_ == m->nodes_cap_) GrowNodes(m);
+    f = m->num_used_++;
+  }
+  BddNode* n = &m->nodes_[f];
+  n->var_ = var;
+  n->low_ = low;
+  n->high_ = high;
+  n->next_ = m->buckets_[h];
+  m->buckets_[h] = f;
+
+  if (++m->stats_.nodes_ > m->stats_.peak_nodes_)
+    m->stats_.peak_nodes_ = m->stats_.nodes_;
+  // Mantém fator de carga abaixo de 1
+  if (m->stats_.nodes_ > m->buckets_cap_) Rehash(m, m->buckets_cap_ * 2);
+  return f;
+}
+
+// --- Coleta de Lixo ---
+
+void BddIncRef(BddManager* m, BddRef f) {
+  if (f >= 2) m->refs_[f]++;
+}
+
+void BddDecRef(BddManager* m, BddRef f) {
+  if (f >= 2 && m->refs_[f] > 0) m->refs_[f]--;
+}
+
+void BddCollectGarbage(BddManager* m) {
+  // Marcação iterativa a partir das raízes externas
+  BddRef* stack = NULL;
+  int size = 0, cap = 0;
+  for (int i = 2; i < m->num_used_; i++) {
+    if (m->nodes_[i].var_ <= 0 || !m->refs_[i] || m->marks_[i]) continue;
+    m->marks_[i] = 1;
+    if (size == cap) {
+      cap = cap ? cap * 2 : 64;
+      stack = (BddRef*)realloc(stack, sizeof(BddRef) * cap);
+    }
+    stack[size++] = i;
+    while (size > 0) {
+      const BddNode* n = &m->nodes_[stack[--size]];
+      BddRef kids[2] = {n->low_, n->high_};
+      for (int k = 0; k < 2; k++) {
+        if (kids[k] < 2 || m->marks_[kids[k]]) continue;
+        m->marks_[kids[k]] = 1;
+        if (size == cap) {
+          cap *= 2;
+          stack = (BddRef*)realloc(stack, sizeof(BddRef) * cap);
+        }
+        stack[size++] = kids[k];
+      }
+    }
+  }
+  free(stack);
+
+  // Varredura: não marcados vão para a lista livre
+  memset(m->buckets_, 0xFF, sizeof(BddRef) * m->buckets_cap_);
+  m->free_list_ = BDD_INVALID;
+  long long live = 2;
+  for (int i = m->num_used_ - 1; i >= 2; i--) {
+    BddNode* n = &m->nodes_[i];
+    if (n->var_ > 0 && m->marks_[i]) {
+      InsertBucket(m, i);
+      live++;
+    } else {
+      n->var_ = -1;
+      n->next_ = m->free_list_;
+      m->free_list_ = i;
+    }
+    m->marks_[i] = 0;
+  }
+  ClearCache(m);
+
+  m->stats_.nodes_ = live;
+  m->stats_.gc_runs_++;
+  m->gc_threshold_ = live * 2 > GC_MIN_NODES ? live * 2 : GC_MIN_NODES;
+}
+
+// Só é chamada no início das operações públicas: nenhum resultado
+// intermediário de uma operação em andamento fica sem referência
+static void MaybeCollect(BddManager* m, BddRef f, BddRef g, BddRef h) {
+  if (m->stats_.nodes_ < m->gc_threshold_) return;
+  BddIncRef(m, f);
+  BddIncRef(m, g);
+  BddIncRef(m, h);
+  BddCollectGarbage(m);
+  BddDecRef(m, f);
+  BddDecRef(m, g);
+  BddDecRef(m, h);
+}
+
+// --- ITE ---
+
+static BddRef IteRec(BddManager* m, BddRef f, BddRef g, BddRef h) {
+  if (f == BDD_TRUE) return g;
+  if (f == BDD_FALSE) return h;
+  if (g == f) g = BDD_TRUE;
+  if (h == f) h = BDD_FALSE;
+  if (g == h) return g;
+  if (g == BDD_TRUE && h == BDD_FALSE) return f;
+
+  unsigned slot = HashTriple(f, g, h) & (m->cache_cap_ - 1);
+  IteEntry* e = &m->cache_[slot];
+  m->stats_.cache_lookups_++;
+  if (e->f_ == f && e->g_ == g && e->h_ == h) {
+    m->stats_.cache_hits_++;
+    return e->r_;
+  }
+
+  int top = Level(m, f);
+  if (Level(m, g) < top) top = Level(m, g);
+  if (Level(m, h) < top) top = Level(m, h);
+
+  BddRef args[3] = {f, g, h};
+  BddRef lo[3], hi[3];
+  int var = 0;
+  for (int k = 0; k < 3; k++) {
+    if (Level(m, args[k]) == top) {
+      var = m->nodes_[args[k]].var_;
+      lo[k] = m->nodes_[args[k]].low_;
+      hi[k] = m->nodes_[args[k]].high_;
+    } else {
+      lo[k] = hi[k] = args[k];
+    }
+  }
+
+  BddRef t = IteRec(m, hi[0], hi[1], hi[2]);
+  if (t == BDD_INVALID) return BDD_INVALID;
+  BddRef el = IteRec(m, lo[0], lo[1], lo[2]);
+  if (el == BDD_INVALID) return BDD_INVALID;
+  BddRef r = MakeNode(m, var, el, t);
+  if (r == BDD_INVALID) return BDD_INVALID;
+
+  // MakeNode pode ter realocado o cache
+  e = &m->cache_[HashTriple(f, g, h) & (m->cache_cap_ - 1)];
+  e->f_ = f;
+  e->g_ = g;
+  e->h_ = h;
+  e->r_ = r;
+  return r;
+}
+
+BddRef BddIte(BddManager* m, BddRef f, BddRef g, BddRef h) {
+  if (f == BDD_INVALID || g == BDD_INVALID || h == BDD_INVALID)
+    return BDD_INVALID;
+  MaybeCollect(m, f, g, h);
+  return IteRec(m, f, g, h);
+}
+
+BddRef BddVar(BddManager* m, int var) {
+  if (var < 1) return BDD_INVALID;
+  GrowVars(m, var);
+  return MakeNode(m, var, BDD_FALSE, BDD_TRUE);
+}
+
+BddRef BddNot(BddManager* m, BddRef f) {
+  return BddIte(m, f, BDD_FALSE, BDD_TRUE);
+}
+
+BddRef BddAnd(BddManager* m, BddRef f, BddRef g) {
+  return BddIte(m, f, g, BDD_FALSE);
+}
+
+BddRef BddOr(BddManager* m, BddRef f, BddRef g) {
+  return BddIte(m, f, BDD_TRUE, g);
+}
+
+BddRef BddXor(BddManager* m, BddRef f, BddRef g) {
+  if (f == BDD_INVALID || g == BDD_INVALID) return BDD_INVALID;
+  MaybeCollect(m, f, g, BDD_FALSE);
+  BddRef not_g = IteRec(m, g, BDD_FALSE, BDD_TRUE);
+  if (not_g == BDD_INVALID) return BDD_INVALID;
+  return IteRec(m, f, not_g, g);
+}
+
+// --- Construção a partir de ExprNode (pós-ordem iterativa) ---
+
+static BddRef ApplyGate(BddManager* m, NodeType type, BddRef l, BddRef r) {
+  switch (type) {
+    case NODE_NOT:
+      return IteRec(m, l, BDD_FALSE, BDD_TRUE);
+    case NODE_AND:
+      return IteRec(m, l, r, BDD_FALSE);
+    case NODE_OR:
+      return IteRec(m, l, BDD_TRUE, r);
+    case NODE_IMPLIES:
+      return IteRec(m, l, r, BDD_TRUE);
+    case NODE_XOR: {
+      BddRef not_r = IteRec(m, r, BDD_FALSE, BDD_TRUE);
+      if (not_r == BDD_INVALID) return BDD_INVALID;
+      return IteRec(m, l, not_r, r);
+    }
+    default:
+      return BDD_INVALID;
+  }
+}
+
+typedef struct {
+  const ExprNode* node_;
+  bool expanded_;
+} BuildFrame;
+
+BddRef BddFromExpr(BddManager* m, const ExprNode* root, VarMap* vars) {
+  MaybeCollect(m, BDD_FALSE, BDD_FALSE, BDD_FALSE);
+
+  int frames_cap = 64, num_frames = 0;
+  int values_cap = 64, num_values = 0;
+  BuildFrame* frames = (BuildFrame*)malloc(sizeof(BuildFrame) * frames_cap);
+  BddRef* values = (BddRef*)malloc(sizeof(BddRef) * values_cap);
+  bool ok = true;
+
+  frames[num_frames].node_ = root;
+  frames[num_frames++].expanded_ = false;
+
+  while (num_frames > 0 && ok) {
+    BuildFrame* f = &frames[num_frames - 1];
+    const ExprNode* node = f->node_;
+    if (!node) {  // árvore malformada
+      ok = false;
+      break;
+    }
+
+    if (node->type_ != NODE_VAR && !f->expanded_) {
+      f->expanded_ = true;
+      if (num_frames + 2 > frames_cap) {
+        frames_cap *= 2;
+        frames = (BuildFrame*)realloc(frames, sizeof(BuildFrame) * frames_cap);
+      }
+      if (node->type_ != NODE_NOT) {
+        frames[num_frames].node_ = node->right_;
+        frames[num_frames++].expanded_ = false;
+      }
+      frames[num_frames].node_ = node->left_;
+      frames[num_frames++].expanded_ = false;
+      continue;
+    }
+    num_frames--;
+
+    if (num_values == values_cap) {
+      values_cap *= 2;
+      values = (BddRef*)realloc(values, sizeof(BddRef) * values_cap);
+    }
+    BddRef v;
+    if (node->type_ == NODE_VAR) {
+      v = BddVar(m, VarMapGet(vars, node->variable_));
+    } else {
+      BddRef r = node->type_ == NODE_NOT ? BDD_FALSE : values[--num_values];
+      BddRef l = values[--num_values];
+      v = ApplyGate(m, node->type_, l, r);
+    }
+    ok = v != BDD_INVALID;
+    values[num_values++] = v;
+  }
+
+  BddRef result = ok ? values[0] : BDD_INVALID;
+  free(frames);
+  free(values);
+  return result;
+}
+
+// --- Extração de Modelos ---
+
+bool BddPickSat(const BddManager* m, BddRef f, bool* values) {
+  for (int v = 1; v <= m->num_vars_; v++) values[v] = false;
+  if (f < 0) return false;
+  while (f >= 2) {
+    const BddNode* n = &m->nodes_[f];
+    values[n->var_] = n->high_ != BDD_FALSE;
+    f = values[n->var_] ? n->high_ : n->low_;
+  }
+  return f == BDD_TRUE;
+}
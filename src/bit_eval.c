@@ -0,0 +1,296 @@
+#include "../include/bit_eval.h"
+
+#include <stdlib.h>
+
+#if defined(__AVX512F__) || defined(__AVX2__)
+#include <immintrin.h>
+#endif
+
+// --- Compilação (pós-ordem iterativa) ---
+
+typedef struct {
+  const ExprNode* node_;
+  bool expanded_;
+} CompileFrame;
+
+static void Emit(BitProgram* prog, int* cap, BitOpCode op, int dst, int a,
+                 int b) {
+  if (prog->size_ == *cap) {
+    *cap = *cap ? *cap * 2 : 32;
+    prog->code_ = (BitInstr*)realloc(prog->code_, sizeof(BitInstr) * *cap);
+  }
+  BitInstr* in = &prog->code_[prog->size_++];
+  in->op_ = op;
+  in->dst_ = dst;
+  in->a_ = a;
+  in->b_ = b;
+}
+
+// Primeira passada: numera as variáveis para saber onde começam os temporários
+static bool NumberVariables(const ExprNode* root, VarMap* vars) {
+  const ExprNode** stack = NULL;
+  int size = 0, cap = 0;
+  bool ok = true;
+  const ExprNode* node = root;
+  for (;;) {
+    if (!node) {
+      ok = false;
+      break;
+    }
+    if (node->type_ == NODE_VAR) {
+      VarMapGet(vars, node->variable_);
+    } else {
+      if (node->type_ != NODE_NOT) {
+        if (size == cap) {
+          cap = cap ? cap * 2 : 64;
+          stack = (const ExprNode**)realloc(stack, sizeof(*stack) * cap);
+        }
+        stack[size++] = node->right_;
+      }
+      node = node->left_;
+      continue;
+    }
+    if (size == 0) break;
+    node = stack[--size];
+  }
+  free(stack);
+  return ok;
+}
+
+bool BitProgramCompile(const ExprNode* root, BitProgram* prog) {
+  prog->code_ = NULL;
+  prog->size_ = 0;
+  prog->num_regs_ = 0;
+  prog->result_ = 0;
+  VarMapInit(&prog->vars_);
+  if (!root || !NumberVariables(root, &prog->vars_)) return false;
+  int nv = prog->num_vars_ = prog->vars_.count_;
+
+  CompileFrame* frames = NULL;
+  int* values = NULL;  // slots dos resultados pendentes
+  int num_frames = 0, frames_cap = 0, num_values = 0, values_cap = 0;
+  int code_cap = 0;
+  int live_temps = 0;
+
+#define PUSH_FRAME(n)                                                      \
+  do {                                                                     \
+    if (num_frames == frames_cap) {                                        \
+      frames_cap = frames_cap ? frames_cap * 2 : 64;                       \
+      frames = (CompileFrame*)realloc(frames, sizeof(*frames) * frames_cap); \
+    }                                                                      \
+    frames[num_frames].node_ = (n);                                        \
+    frames[num_frames].expanded_ = false;                                  \
+    num_frames++;                                                          \
+  } while (0)
+
+  PUSH_FRAME(root);
+  while (num_frames > 0) {
+    CompileFrame* f = &frames[num_frames - 1];
+    const ExprNode* node = f->node_;
+
+    if (node->type_ != NODE_VAR && !f->expanded_) {
+      f->expanded_ = true;
+      if (node->type_ != NODE_NOT) PUSH_FRAME(node->right_);
+      PUSH_FRAME(node->left_);
+      continue;
+    }
+    num_frames--;
+
+    if (values_cap < num_values + 1) {
+      values_cap = values_cap ? values_cap * 2 : 64;
+      values = (int*)realloc(values, sizeof(int) * values_cap);
+    }
+    if (node->type_ == NODE_VAR) {
+      values[num_values++] = VarMapFind(&prog->vars_, node->variable_) - 1;
+      continue;
+    }
+
+    // Operandos no topo da pilha; temporários liberados são reutilizados
+    int b = node->type_ == NODE_NOT ? -1 : values[--num_values];
+    int a = values[--num_values];
+    if (a >= nv) live_temps--;
+    if (b >= nv) live_temps--;
+    int dst = nv + live_temps++;
+    if (live_temps > prog->num_regs_) prog->num_regs_ = live_temps;
+
+    BitOpCode op = BIT_NOT;
+    if (node->type_ == NODE_AND) op = BIT_AND;
+    if (node->type_ == NODE_OR) op = BIT_OR;
+    if (node->type_ == NODE_XOR) op = BIT_XOR;
+    if (node->type_ == NODE_IMPLIES) op = BIT_IMPLIES;
+    Emit(prog, &code_cap, op, dst, a, b);
+    values[num_values++] = dst;
+  }
+#undef PUSH_FRAME
+
+  prog->result_ = values[0];
+  free(frames);
+  free(values);
+  return true;
+}
+
+void BitProgramFree(BitProgram* prog) {
+  free(prog->code_);
+  prog->code_ = NULL;
+  VarMapFree(&prog->vars_);
+}
+
+// --- Execução ---
+
+static inline void ExecInstr(const BitInstr* in, BitBlock* slots) {
+  uint64_t* d = slots[in->dst_].w_;
+  const uint64_t* a = slots[in->a_].w_;
+  const uint64_t* b = in->b_ >= 0 ? slots[in->b_].w_ : a;
+#if defined(__AVX512F__)
+  __m512i va = _mm512_loadu_si512((const void*)a);
+  __m512i vb = _mm512_loadu_si512((const void*)b);
+  __m512i r;
+  switch (in->op_) {
+    case BIT_NOT:
+      r = _mm512_ternarylogic_epi64(va, va, va, 0x55);
+      break;
+    case BIT_AND:
+      r = _mm512_and_si512(va, vb);
+      break;
+    case BIT_OR:
+      r = _mm512_or_si512(va, vb);
+      break;
+    case BIT_XOR:
+      r = _mm512_xor_si512(va, vb);
+      break;
+    default:  // nA v B
+      r = _mm512_ternarylogic_epi64(va, vb, vb, 0xCF);
+      break;
+  }
+  _mm512_storeu_si512((void*)d, r);
+#elif defined(__AVX2__)
+  __m256i ones = _mm256_set1_epi64x(-1);
+  for (int k = 0; k < BIT_BLOCK_WORDS; k += 4) {
+    __m256i va = _mm256_loadu_si256((const __m256i*)(a + k));
+    __m256i vb = _mm256_loadu_si256((const __m256i*)(b + k));
+    __m256i r;
+    switch (in->op_) {
+      case BIT_NOT:
+        r = _mm256_xor_si256(va, ones);
+        break;
+      case BIT_AND:
+        r = _mm256_and_si256(va, vb);
+        break;
+      case BIT_OR:
+        r = _mm256_or_si256(va, vb);
+        break;
+      case BIT_XOR:
+        r = _mm256_xor_si256(va, vb);
+        break;
+      default:
+        r = _mm256_or_si256(_mm256_xor_si256(va, ones), vb);
+        break;
+    }
+    _mm256_storeu_si256((__m256i*)(d + k), r);
+  }
+#else
+  switch (in->op_) {
+    case BIT_NOT:
+      for (int k = 0; k < BIT_BLOCK_WORDS; k++) d[k] = ~a[k];
+      break;
+    case BIT_AND:
+      for (int k = 0; k < BIT_BLOCK_WORDS; k++) d[k] = a[k] & b[k];
+      break;
+    case BIT_OR:
+      for (int k = 0; k < BIT_BLOCK_WORDS; k++) d[k] = a[k] | b[k];
+      break;
+    case BIT_XOR:
+      for (int k = 0; k < BIT_BLOCK_WORDS; k++) d[k] = a[k] ^ b[k];
+      break;
+    case BIT_IMPLIES:
+      for (int k = 0; k < BIT_BLOCK_WORDS; k++) d[k] = ~a[k] | b[k];
+      break;
+  }
+#endif
+}
+
+const BitBlock* BitProgramEvalBlock(const BitProgram* prog, BitBlock* slots) {
+  for (int i = 0; i < prog->size_; i++) ExecInstr(&prog->code_[i], slots);
+  return &slots[prog->result_];
+}
+
+// --- Varredura Exaustiva ---
+
+// Padrões das variáveis dentro de uma palavra de 64 bits
+static const uint64_t kWordPatterns[6] = {
+    0xAAAAAAAAAAAAAAAAull, 0xCCCCCCCCCCCCCCCCull, 0xF0F0F0F0F0F0F0F0ull,
+    0xFF00FF00FF00FF00ull, 0xFFFF0000FFFF0000ull, 0xFFFFFFFF00000000ull};
+
+// Índice da atribuição = bloco * BIT_BLOCK_BITS + palavra * 64 + bit.
+// Variáveis 0..5 variam dentro da palavra, 6..8 entre as palavras do bloco
+// e as demais apenas de um bloco para o outro.
+static void FillColumn(BitBlock* col, int var, long long block) {
+  for (int k = 0; k < BIT_BLOCK_WORDS; k++) {
+    if (var < 6)
+      col->w_[k] = kWordPatterns[var];
+    else if (var < 9)
+      col->w_[k] = ((k >> (var - 6)) & 1) ? ~0ull : 0;
+    else
+      col->w_[k] = ((block >> (var - 9)) & 1) ? ~0ull : 0;
+  }
+}
+
+// Contagem de bits de uma palavra (SWAR, sem depender do compilador)
+static int PopCount64(uint64_t x) {
+  x -= (x >> 1) & 0x5555555555555555ull;
+  x = (x & 0x3333333333333333ull) + ((x >> 2) & 0x3333333333333333ull);
+  x = (x + (x >> 4)) & 0x0F0F0F0F0F0F0F0Full;
+  return (int)((x * 0x0101010101010101ull) >> 56);
+}
+
+// Percorre as atribuições em ordem; com count = false para na primeira em
+// que o programa vale `target` e retorna o índice dela (ou -1), senão
+// retorna quantas valem `target`
+static long long Sweep(const BitProgram* prog, bool target, bool count) {
+  int nv = prog->num_vars_;
+  if (nv > 62) return -1;
+
+  int num_slots = nv + prog->num_regs_;
+  BitBlock* slots = (BitBlock*)malloc(sizeof(BitBlock) * (num_slots + 1));
+  for (int v = 0; v < nv && v < 9; v++) FillColumn(&slots[v], v, 0);
+
+  long long total = 1ll << nv;
+  long long num_blocks = (total + BIT_BLOCK_BITS - 1) / BIT_BLOCK_BITS;
+  long long found = count ? 0 : -1;
+
+  for (long long block = 0; block < num_blocks && (count || found < 0);
+       block++) {
+    // Colunas acima da 9ª só mudam quando o bit correspondente do bloco muda
+    for (int v = 9; v < nv; v++) {
+      if (block == 0 || ((block ^ (block - 1)) >> (v - 9)) & 1)
+        FillColumn(&slots[v], v, block);
+    }
+    const BitBlock* res = BitProgramEvalBlock(prog, slots);
+
+    long long base = block * BIT_BLOCK_BITS;
+    for (int k = 0; k < BIT_BLOCK_WORDS; k++) {
+      uint64_t word = target ? res->w_[k] : ~res->w_[k];
+      long long first = base + 64ll * k;
+      if (first >= total) break;
+      if (total - first < 64) word &= (1ull << (total - first)) - 1;
+      if (count) {
+        found += PopCount64(word);
+      } else if (word) {
+        int bit = 0;
+        while (!((word >> bit) & 1)) bit++;
+        found = first + bit;
+        break;
+      }
+    }
+  }
+  free(slots);
+  return found;
+}
+
+long long BitProgramFindAssignment(const BitProgram* prog, bool target) {
+  return Sweep(prog, target, false);
+}
+
+long long BitProgramCountAssignments(const BitProgram* prog, bool target) {
+  return Sweep(prog, target, true);
+}
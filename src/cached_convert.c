@@ -0,0 +1,205 @@
+#include "../include/dnf_converter.h"
+
+#include <stdlib.h>
+#include <string.h>
+
+#include "../include/canonical.h"
+#include "../include/convert_internal.h"
+#include "../include/expr_arena.h"
+#include "../include/result_cache.h"
+
+// Com o cache ligado (result_cache.h), cada resultado é calculado sobre a
+// forma canônica da sentença (canonical.h) e traduzido de volta para as
+// variáveis de quem chamou. Um acerto pula toda a conversão, e a resposta
+// é a mesma de uma falta. A chave é a operação, o nível de minimização e
+// o texto canônico.
+
+typedef enum {
+  CACHED_CNF,
+  CACHED_DNF,
+  CACHED_TSEITIN,
+  CACHED_PLAISTED_GREENBAUM,
+  CACHED_COUNT,
+  CACHED_SAT,
+  CACHED_EQUIV
+} CachedOp;
+
+static char* ComputeText(const char* input, CachedOp op, MinimizeLevel level) {
+  switch (op) {
+    case CACHED_CNF:
+      return ConvertToNormalForm(input, true, level);
+    case CACHED_DNF:
+      return ConvertToNormalForm(input, false, level);
+    case CACHED_TSEITIN:
+      return ConvertToEncodedCNF(input, CNF_TSEITIN);
+    case CACHED_PLAISTED_GREENBAUM:
+      return ConvertToEncodedCNF(input, CNF_PLAISTED_GREENBAUM);
+    default:
+      return CountModelsUncached(input);
+  }
+}
+
+// Forma canônica de uma ou duas sentenças; false se alguma for inválida
+static bool CanonicalizeInputs(const char* const* inputs, int num_inputs,
+                               CanonicalForm* form) {
+  ExprArena arena;
+  ExprArenaInit(&arena);
+  ExprNode* roots[2];
+  PhaseMark mark = PhaseBegin(&arena);
+  bool ok = true;
+  for (int i = 0; i < num_inputs && ok; i++) {
+    int pos = 0;
+    roots[i] = ParseExpressionArena(&arena, inputs[i], &pos);
+    ok = roots[i] != NULL;
+  }
+  PhaseEnd(PHASE_PARSE, mark, &arena);
+  if (ok) {
+    mark = PhaseBegin(NULL);
+    CanonicalizeTrees(&arena, roots, num_inputs, true, form);
+    PhaseEnd(PHASE_NORMALIZE, mark, NULL);
+  }
+  ReleaseArena(&arena);
+  return ok;
+}
+
+static char* CacheKey(CachedOp op, MinimizeLevel level,
+                      const CanonicalForm* form, size_t* key_len) {
+  *key_len = form->len_ + 2;
+  char* key = (char*)malloc(*key_len);
+  key[0] = (char)op;
+  key[1] = (char)level;
+  memcpy(key + 2, form->text_, form->len_);
+  return key;
+}
+
+static char* CachedText(const char* input, CachedOp op, MinimizeLevel level) {
+  if (!ResultCacheEnabled()) return ComputeText(input, op, level);
+
+  CanonicalForm form;
+  if (!CanonicalizeInputs(&input, 1, &form)) return NULL;
+  size_t key_len, value_len;
+  char* key = CacheKey(op, level, &form, &key_len);
+  void* value;
+  char* canonical;
+  if (ResultCacheLookup(key, key_len, &value, &value_len)) {
+    canonical = (char*)value;
+  } else {
+    canonical = ComputeText(form.text_, op, level);
+    if (canonical)
+      ResultCacheStore(key, key_len, canonical, strlen(canonical) + 1);
+  }
+
+  // A contagem não menciona variáveis
+  char* result = canonical;
+  if (canonical && op != CACHED_COUNT) {
+    result = CanonicalMapText(&form, canonical);
+    free(canonical);
+  }
+  free(key);
+  CanonicalFormFree(&form);
+  return result;
+}
+
+// SAT e equivalência: o valor guardado é o resultado seguido de um byte
+// por variável canônica com o modelo / contraexemplo, se houver
+static bool CachedModel(const char* const* inputs, CachedOp op, bool** model,
+                        int* model_size) {
+  CanonicalForm form;
+  if (!CanonicalizeInputs(inputs, op == CACHED_EQUIV ? 2 : 1, &form)) {
+    if (op == CACHED_EQUIV && model) {
+      *model = NULL;
+      *model_size = 0;
+    }
+    return false;
+  }
+  size_t key_len, value_len;
+  char* key = CacheKey(op, MINIMIZE_NONE, &form, &key_len);
+  unsigned char* value;
+  if (!ResultCacheLookup(key, key_len, (void**)&value, &value_len)) {
+    bool* values = NULL;
+    int size = 0;
+    bool result;
+    if (op == CACHED_EQUIV) {
+      // Os dois lados canônicos vêm separados por " ; "
+      char* sep = strstr(form.text_, " ; ");
+      *sep = '\0';
+      result = CheckEquivalenceUncached(form.text_, sep + 3, &values, &size);
+      *sep = ' ';
+    } else {
+      result = FindSatisfyingModelUncached(form.text_, &values, &size);
+    }
+    value_len = 1 + (values ? (size_t)form.num_vars_ : 0);
+    value = (unsigned char*)malloc(value_len);
+    value[0] = result;
+    for (int i = 1; values && i <= form.num_vars_; i++)
+      value[i] = i < size && values[i];
+    free(values);
+    ResultCacheStore(key, key_len, value, value_len);
+  }
+
+  bool result = value[0] != 0;
+  if (model) {
+    *model = NULL;
+    *model_size = 0;
+    if (value_len > 1) {
+      *model = (bool*)calloc(form.max_var_ + 1, sizeof(bool));
+      *model_size = form.max_var_ + 1;
+      for (int i = 1; i <= form.num_vars_; i++)
+        (*model)[form.names_[i]] = value[i] != 0;
+    }
+  }
+  free(value);
+  free(key);
+  CanonicalFormFree(&form);
+  return result;
+}
+
+char* ConvertToDNF(const char* input) {
+  return CachedText(input, CACHED_DNF, MINIMIZE_SIMPLIFY);
+}
+
+char* ConvertToDNFMinimized(const char* input, MinimizeLevel level) {
+  return CachedText(input, CACHED_DNF, level);
+}
+
+char* ConvertToCNF(const char* input) {
+  return CachedText(input, CACHED_CNF, MINIMIZE_SIMPLIFY);
+}
+
+char* ConvertToCNFMinimized(const char* input, MinimizeLevel level) {
+  return CachedText(input, CACHED_CNF, level);
+}
+
+char* ConvertToCNFMode(const char* input, CnfMode mode) {
+  if (mode == CNF_EQUIVALENT) return ConvertToCNF(input);
+  return CachedText(input,
+                    mode == CNF_TSEITIN ? CACHED_TSEITIN
+                                        : CACHED_PLAISTED_GREENBAUM,
+                    MINIMIZE_NONE);
+}
+
+char* CountModels(const char* input) {
+  return CachedText(input, CACHED_COUNT, MINIMIZE_NONE);
+}
+
+bool CheckEquivalence(const char* input1, const char* input2,
+                      bool** counterexample, int* size) {
+  if (!ResultCacheEnabled())
+    return CheckEquivalenceUncached(input1, input2, counterexample, size);
+  const char* inputs[2] = {input1, input2};
+  return CachedModel(inputs, CACHED_EQUIV, counterexample, size);
+}
+
+bool AreEquivalent(const char* input1, const char* input2) {
+  return CheckEquivalence(input1, input2, NULL, NULL);
+}
+
+bool FindSatisfyingModel(const char* input, bool** model, int* model_size) {
+  if (!ResultCacheEnabled())
+    return FindSatisfyingModelUncached(input, model, model_size);
+  return CachedModel(&input, CACHED_SAT, model, model_size);
+}
+
+bool IsSatisfiable(const char* input) {
+  return FindSatisfyingModel(input, NULL, NULL);
+}
@@ -0,0 +1,241 @@
+#include "../include/canonical.h"
+
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "../include/var_map.h"
+
+// As travessias usam pilhas explícitas, como em cnf_encoder.c
+
+typedef struct {
+  ExprNode* node_;
+  int state_;  // filhos já visitados (hash) ou emitidos (texto)
+} CanonFrame;
+
+typedef struct {
+  CanonFrame* data_;
+  int size_;
+  int cap_;
+} CanonStack;
+
+typedef struct {
+  char* data_;
+  size_t size_;
+  size_t cap_;
+} CanonText;
+
+static void Push(CanonStack* st, ExprNode* node) {
+  if (st->size_ == st->cap_) {
+    st->cap_ = st->cap_ ? st->cap_ * 2 : 64;
+    st->data_ = (CanonFrame*)realloc(st->data_, sizeof(CanonFrame) * st->cap_);
+  }
+  st->data_[st->size_].node_ = node;
+  st->data_[st->size_].state_ = 0;
+  st->size_++;
+}
+
+static void Append(CanonText* t, const char* text, size_t len) {
+  if (t->size_ + len + 1 > t->cap_) {
+    while (t->size_ + len + 1 > t->cap_) t->cap_ = t->cap_ ? t->cap_ * 2 : 256;
+    t->data_ = (char*)realloc(t->data_, t->cap_);
+  }
+  memcpy(t->data_ + t->size_, text, len);
+  t->size_ += len;
+  t->data_[t->size_] = '\0';
+}
+
+static uint64_t Mix(uint64_t h) {
+  h ^= h >> 33;
+  h *= 0xFF51AFD7ED558CCDull;
+  h ^= h >> 33;
+  h *= 0xC4CEB9FE1A85EC53ull;
+  return h ^ (h >> 33);
+}
+
+static bool IsCommutative(NodeType type) {
+  return type == NODE_AND || type == NODE_OR || type == NODE_XOR;
+}
+
+// Hash de forma de cada nó alcançável, indexado pelo id: depende só dos
+// operadores e da estrutura, com os filhos de operadores comutativos em
+// ordem de hash
+static void ShapeHashes(ExprNode* const* roots, int num_roots,
+                        uint64_t* hash, bool* done) {
+  CanonStack st = {NULL, 0, 0};
+  for (int r = 0; r < num_roots; r++) {
+    Push(&st, roots[r]);
+    while (st.size_ > 0) {
+      CanonFrame* f = &st.data_[st.size_ - 1];
+      ExprNode* node = f->node_;
+      if (done[node->id_]) {
+        st.size_--;
+        continue;
+      }
+      if (node->type_ != NODE_VAR) {
+        if (f->state_ == 0) {
+          f->state_ = 1;
+          Push(&st, node->left_);
+          continue;
+        }
+        if (f->state_ == 1 && node->type_ != NODE_NOT) {
+          f->state_ = 2;
+          Push(&st, node->right_);
+          continue;
+        }
+      }
+
+      uint64_t h = Mix((uint64_t)node->type_ + 1);
+      if (node->type_ == NODE_NOT) {
+        h = Mix(h ^ hash[node->left_->id_]);
+      } else if (node->type_ != NODE_VAR) {
+        uint64_t a = hash[node->left_->id_], b = hash[node->right_->id_];
+        if (IsCommutative(node->type_) && b < a) {
+          uint64_t tmp = a;
+          a = b;
+          b = tmp;
+        }
+        h = Mix(Mix(h ^ a) + b);
+      }
+      hash[node->id_] = h;
+      done[node->id_] = true;
+      st.size_--;
+    }
+  }
+  free(st.data_);
+}
+
+// Filho emitido primeiro / depois
+static void OrderChildren(const ExprNode* node, const uint64_t* hash,
+                          ExprNode** first, ExprNode** second) {
+  *first = node->left_;
+  *second = node->right_;
+  if (IsCommutative(node->type_) &&
+      hash[node->right_->id_] < hash[node->left_->id_]) {
+    *first = node->right_;
+    *second = node->left_;
+  }
+}
+
+static void EmitTree(ExprNode* root, const uint64_t* hash, VarMap* vars,
+                     CanonText* out) {
+  CanonStack st = {NULL, 0, 0};
+  char token[16];
+  Push(&st, root);
+  while (st.size_ > 0) {
+    CanonFrame* f = &st.data_[st.size_ - 1];
+    ExprNode* node = f->node_;
+    if (node->type_ == NODE_VAR) {
+      int len = sprintf(token, "%d", VarMapGet(vars, node->variable_));
+      Append(out, token, len);
+      st.size_--;
+      continue;
+    }
+    if (node->type_ == NODE_NOT) {
+      if (f->state_++ == 0) {
+        Append(out, "n", 1);
+        Push(&st, node->left_);
+      } else {
+        st.size_--;
+      }
+      continue;
+    }
+
+    ExprNode *first, *second;
+    OrderChildren(node, hash, &first, &second);
+    if (f->state_ == 0) {
+      f->state_ = 1;
+      Append(out, "(", 1);
+      Push(&st, first);
+    } else if (f->state_ == 1) {
+      f->state_ = 2;
+      char op = node->type_ == NODE_AND   ? 'a'
+                : node->type_ == NODE_OR  ? 'v'
+                : node->type_ == NODE_XOR ? 'x'
+                                          : '>';
+      int len = sprintf(token, " %c ", op);
+      Append(out, token, len);
+      Push(&st, second);
+    } else {
+      Append(out, ")", 1);
+      st.size_--;
+    }
+  }
+  free(st.data_);
+}
+
+void CanonicalizeTrees(const ExprArena* arena, ExprNode* const* roots,
+                       int num_roots, bool commutative, CanonicalForm* form) {
+  size_t num_ids = arena->num_nodes_ + 1;
+  uint64_t* hash = (uint64_t*)malloc(sizeof(uint64_t) * num_ids);
+  bool* done = (bool*)calloc(num_ids, sizeof(bool));
+  ShapeHashes(roots, num_roots, hash, done);
+
+  // Ordem das partes (inserção: são poucas)
+  int* order = (int*)malloc(sizeof(int) * (num_roots > 0 ? num_roots : 1));
+  for (int i = 0; i < num_roots; i++) {
+    int j = i;
+    while (commutative && j > 0 &&
+           hash[roots[order[j - 1]]->id_] > hash[roots[i]->id_]) {
+      order[j] = order[j - 1];
+      j--;
+    }
+    order[j] = i;
+  }
+
+  VarMap vars;
+  VarMapInit(&vars);
+  CanonText out = {NULL, 0, 0};
+  Append(&out, "", 0);
+  for (int i = 0; i < num_roots; i++) {
+    if (i > 0) Append(&out, " ; ", 3);
+    EmitTree(roots[order[i]], hash, &vars, &out);
+  }
+
+  form->text_ = out.data_;
+  form->len_ = out.size_;
+  form->num_vars_ = vars.count_;
+  form->names_ = (int*)malloc(sizeof(int) * (vars.count_ + 1));
+  form->names_[0] = 0;
+  form->max_var_ = 0;
+  for (int i = 1; i <= vars.count_; i++) {
+    form->names_[i] = vars.originals_[i];
+    if (vars.originals_[i] > form->max_var_) form->max_var_ = vars.originals_[i];
+  }
+  VarMapFree(&vars);
+  free(order);
+  free(done);
+  free(hash);
+}
+
+void CanonicalFormFree(CanonicalForm* form) {
+  free(form->text_);
+  free(form->names_);
+  form->text_ = NULL;
+  form->names_ = NULL;
+}
+
+char* CanonicalMapText(const CanonicalForm* form, const char* text) {
+  CanonText out = {NULL, 0, 0};
+  char token[24];
+  Append(&out, "", 0);
+  const char* p = text;
+  while (*p) {
+    const char* start = p;
+    if (*p < '0' || *p > '9') {
+      while (*p && (*p < '0' || *p > '9')) p++;
+      Append(&out, start, (size_t)(p - start));
+      continue;
+    }
+    long long v = 0;
+    while (*p >= '0' && *p <= '9') v = v * 10 + (*p++ - '0');
+    if (v >= 1 && v <= form->num_vars_)
+      v = form->names_[v];
+    else if (v > form->num_vars_)
+      v = form->max_var_ + (v - form->num_vars_);
+    int len = sprintf(token, "%lld", v);
+    Append(&out, token, len);
+  }
+  return out.data_;
+}
@@ -0,0 +1,86 @@
+#include "../include/clause_set.h"
+
+#include <limits.h>
+#include <stdint.h>
+#include <stdlib.h>
+
+// Nova capacidade (em elementos de `size` bytes) para `need` elementos: o
+// dobro da atual (64 se vazia) ou `need`, o que for maior. Aborta se o
+// tamanho em bytes não couber em size_t, em vez de realocar a menos.
+static size_t GrowCapacity(size_t cap, size_t need, size_t size) {
+  size_t max = SIZE_MAX / size;
+  if (need > max) abort();
+  cap = !cap ? 64 : cap > max / 2 ? max : cap * 2;
+  return cap > need ? cap : need;
+}
+
+void ClauseSetInit(ClauseSet* cs) {
+  cs->num_vars_ = 0;
+  cs->num_clauses_ = 0;
+  cs->lits_ = NULL;
+  cs->num_lits_ = 0;
+  cs->lits_cap_ = 0;
+  cs->starts_cap_ = 16;
+  cs->starts_ = (size_t*)malloc(sizeof(size_t) * cs->starts_cap_);
+  cs->starts_[0] = 0;
+}
+
+void ClauseSetFree(ClauseSet* cs) {
+  free(cs->lits_);
+  free(cs->starts_);
+  cs->lits_ = NULL;
+  cs->starts_ = NULL;
+  cs->num_clauses_ = 0;
+  cs->num_lits_ = 0;
+  cs->lits_cap_ = 0;
+  cs->starts_cap_ = 0;
+}
+
+void ClauseSetClear(ClauseSet* cs) {
+  cs->num_vars_ = 0;
+  cs->num_clauses_ = 0;
+  cs->num_lits_ = 0;
+  cs->starts_[0] = 0;
+}
+
+void ClauseSetReserve(ClauseSet* cs, size_t num_clauses, size_t num_lits) {
+  if (num_clauses == SIZE_MAX) abort();
+  if (num_clauses + 1 > cs->starts_cap_) {
+    cs->starts_cap_ =
+        GrowCapacity(cs->starts_cap_, num_clauses + 1, sizeof(size_t));
+    cs->starts_ =
+        (size_t*)realloc(cs->starts_, sizeof(size_t) * cs->starts_cap_);
+  }
+  if (num_lits > cs->lits_cap_) {
+    cs->lits_cap_ = GrowCapacity(cs->lits_cap_, num_lits, sizeof(int));
+    cs->lits_ = (int*)realloc(cs->lits_, sizeof(int) * cs->lits_cap_);
+  }
+}
+
+void ClauseSetPushLit(ClauseSet* cs, int lit) {
+  if (cs->num_lits_ == cs->lits_cap_) {
+    cs->lits_cap_ = GrowCapacity(cs->lits_cap_, cs->num_lits_ + 1,
+                                 sizeof(int));
+    cs->lits_ = (int*)realloc(cs->lits_, sizeof(int) * cs->lits_cap_);
+  }
+  cs->lits_[cs->num_lits_++] = lit;
+  int var = lit < 0 ? -lit : lit;
+  if (var > cs->num_vars_) cs->num_vars_ = var;
+}
+
+void ClauseSetEndClause(ClauseSet* cs) {
+  if (cs->num_clauses_ == INT_MAX) abort();  // num_clauses_ é int
+  if ((size_t)cs->num_clauses_ + 2 > cs->starts_cap_) {
+    cs->starts_cap_ = GrowCapacity(cs->starts_cap_,
+                                   (size_t)cs->num_clauses_ + 2,
+                                   sizeof(size_t));
+    cs->starts_ =
+        (size_t*)realloc(cs->starts_, sizeof(size_t) * cs->starts_cap_);
+  }
+  cs->starts_[++cs->num_clauses_] = cs->num_lits_;
+}
+
+void ClauseSetAdd(ClauseSet* cs, const int* lits, int size) {
+  for (int i = 0; i < size; i++) ClauseSetPushLit(cs, lits[i]);
+  ClauseSetEndClause(cs);
+}
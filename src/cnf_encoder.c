@@ -0,0 +1,497 @@
+#include "../include/cnf_encoder.h"
+
+#include <stdint.h>
+#include <stdlib.h>
+
+#include "../include/xor_system.h"
+
+// Todas as travessias usam pilhas explícitas: fórmulas com milhares de
+// operadores encadeados não estouram a pilha de chamadas.
+
+// Polaridade com que uma subfórmula aparece (Plaisted-Greenbaum)
+#define POL_POS 1
+#define POL_NEG 2
+#define POL_BOTH 3
+
+typedef struct {
+  const ExprNode* node_;
+  int flag_;  // Encode: filhos já visitados; Assert/Collect: sinal
+  int pol_;   // Encode: polaridade exigida da porta
+} Frame;
+
+typedef struct {
+  Frame* data_;
+  int size_;
+  int cap_;
+} FrameStack;
+
+typedef struct {
+  int* data_;
+  int size_;
+  int cap_;
+} LitStack;
+
+static inline int FlipPol(int pol) {
+  return ((pol & POL_POS) << 1) | ((pol & POL_NEG) >> 1);
+}
+
+static void PushFrame(FrameStack* st, const ExprNode* node, int flag,
+                      int pol) {
+  if (st->size_ == st->cap_) {
+    st->cap_ = st->cap_ ? st->cap_ * 2 : 64;
+    st->data_ = (Frame*)realloc(st->data_, sizeof(Frame) * st->cap_);
+  }
+  st->data_[st->size_].node_ = node;
+  st->data_[st->size_].flag_ = flag;
+  st->data_[st->size_].pol_ = pol;
+  st->size_++;
+}
+
+static void PushLit(LitStack* st, int lit) {
+  if (st->size_ == st->cap_) {
+    st->cap_ = st->cap_ ? st->cap_ * 2 : 64;
+    st->data_ = (int*)realloc(st->data_, sizeof(int) * st->cap_);
+  }
+  st->data_[st->size_++] = lit;
+}
+
+typedef struct {
+  CnfEncoding* enc_;
+  FrameStack frames_;
+  LitStack values_;
+  LitStack clause_;
+  bool full_;  // Tseitin (bi-implicação) ou só a direção exigida
+  bool ok_;
+
+  // Portas já codificadas, por id de nó: subexpressões compartilhadas
+  // (hash-consing da arena) recebem uma única variável auxiliar
+  int* gate_lit_;
+  unsigned char* gate_pol_;  // direções já emitidas
+  int gate_cap_;
+
+  CnfIncremental* inc_;  // NULL na codificação de uma sentença só
+  int guard_;            // literal acrescentado às cláusulas de AssertRoot
+} Encoder;
+
+// Variável de uma variável da entrada. Na codificação incremental as
+// entradas não ocupam 1..n: recebem a próxima variável livre quando
+// aparecem pela primeira vez.
+static int InputVar(Encoder* e, int var) {
+  int index = VarMapGet(&e->enc_->vars_, var);
+  CnfIncremental* inc = e->inc_;
+  if (!inc) return index;
+  if (index >= inc->input_cap_) {
+    int cap = inc->input_cap_ ? inc->input_cap_ : 64;
+    while (cap <= index) cap *= 2;
+    inc->input_var_ = (int*)realloc(inc->input_var_, sizeof(int) * cap);
+    inc->input_cap_ = cap;
+  }
+  if (index > e->enc_->num_inputs_) {
+    inc->input_var_[index] = ++e->enc_->num_vars_;
+    e->enc_->num_inputs_ = index;
+  }
+  return inc->input_var_[index];
+}
+
+static void ReserveGate(Encoder* e, int id) {
+  if (id < e->gate_cap_) return;
+  int cap = e->gate_cap_ ? e->gate_cap_ : 256;
+  while (cap <= id) cap *= 2;
+  e->gate_lit_ = (int*)realloc(e->gate_lit_, sizeof(int) * cap);
+  e->gate_pol_ = (unsigned char*)realloc(e->gate_pol_, cap);
+  for (int i = e->gate_cap_; i < cap; i++) {
+    e->gate_lit_[i] = 0;
+    e->gate_pol_[i] = 0;
+  }
+  e->gate_cap_ = cap;
+}
+
+static void EmitClause(Encoder* e, const int* lits, int size) {
+  ClauseSetAdd(&e->enc_->cnf_, lits, size);
+}
+
+// Define a variável auxiliar x como a porta (op l r). Com POL_POS basta
+// x > porta; com POL_NEG basta porta > x.
+static void EmitGate(Encoder* e, NodeType op, int x, int l, int r, int pol) {
+  if (e->full_) pol = POL_BOTH;
+  if (op == NODE_IMPLIES) {
+    op = NODE_OR;
+    l = -l;
+  }
+  if (op == NODE_AND) {
+    int c1[] = {-x, l};
+    int c2[] = {-x, r};
+    int c3[] = {x, -l, -r};
+    if (pol & POL_POS) {
+      EmitClause(e, c1, 2);
+      EmitClause(e, c2, 2);
+    }
+    if (pol & POL_NEG) EmitClause(e, c3, 3);
+  } else if (op == NODE_OR) {
+    int c1[] = {x, -l};
+    int c2[] = {x, -r};
+    int c3[] = {-x, l, r};
+    if (pol & POL_POS) EmitClause(e, c3, 3);
+    if (pol & POL_NEG) {
+      EmitClause(e, c1, 2);
+      EmitClause(e, c2, 2);
+    }
+  } else if (op == NODE_XOR) {
+    int c1[] = {-x, l, r};
+    int c2[] = {-x, -l, -r};
+    int c3[] = {x, -l, r};
+    int c4[] = {x, l, -r};
+    if (pol & POL_POS) {
+      EmitClause(e, c1, 3);
+      EmitClause(e, c2, 3);
+    }
+    if (pol & POL_NEG) {
+      EmitClause(e, c3, 3);
+      EmitClause(e, c4, 3);
+    }
+  }
+}
+
+// Retorna o literal que representa `root` (pós-ordem iterativa)
+static int EncodeNode(Encoder* e, const ExprNode* root, int pol) {
+  FrameStack* st = &e->frames_;
+  int base = st->size_;
+  PushFrame(st, root, 0, pol);
+
+  while (st->size_ > base) {
+    Frame* f = &st->data_[st->size_ - 1];
+    const ExprNode* node = f->node_;
+    if (!node) {
+      e->ok_ = false;
+      st->size_ = base;
+      return 1;
+    }
+
+    if (node->type_ == NODE_VAR) {
+      st->size_--;
+      PushLit(&e->values_, InputVar(e, node->variable_));
+      continue;
+    }
+    if (!f->flag_) {
+      // Porta já codificada: só falta emitir as direções ainda ausentes
+      if (node->id_ > 0 && node->type_ != NODE_NOT) {
+        ReserveGate(e, node->id_);
+        int missing = f->pol_ & ~e->gate_pol_[node->id_];
+        if (e->gate_lit_[node->id_] && (!missing || e->full_)) {
+          st->size_--;
+          PushLit(&e->values_, e->gate_lit_[node->id_]);
+          continue;
+        }
+        if (e->gate_lit_[node->id_]) f->pol_ = missing;
+      }
+      f->flag_ = 1;
+      int pol = f->pol_;
+      int left_pol = pol;
+      int right_pol = pol;
+      if (node->type_ == NODE_NOT || node->type_ == NODE_IMPLIES)
+        left_pol = FlipPol(pol);
+      if (node->type_ == NODE_XOR) left_pol = right_pol = POL_BOTH;
+
+      if (node->type_ != NODE_NOT) PushFrame(st, node->right_, 0, right_pol);
+      PushFrame(st, node->left_, 0, left_pol);
+      continue;
+    }
+
+    int pol = f->pol_;
+    st->size_--;
+    if (node->type_ == NODE_NOT) {
+      e->values_.data_[e->values_.size_ - 1] *= -1;
+      continue;
+    }
+    int r = e->values_.data_[--e->values_.size_];
+    int l = e->values_.data_[--e->values_.size_];
+    int x = node->id_ > 0 ? e->gate_lit_[node->id_] : 0;
+    if (!x) x = ++e->enc_->num_vars_;
+    EmitGate(e, node->type_, x, l, r, pol);
+    if (node->id_ > 0) {
+      e->gate_lit_[node->id_] = x;
+      e->gate_pol_[node->id_] |= e->full_ ? POL_BOTH : pol;
+    }
+    PushLit(&e->values_, x);
+  }
+  return e->values_.data_[--e->values_.size_];
+}
+
+// Reúne os disjuntos de (pol ? node : n node) em uma única cláusula
+static void CollectClause(Encoder* e, const ExprNode* root, int pol) {
+  FrameStack* st = &e->frames_;
+  int base = st->size_;
+  PushFrame(st, root, pol, 0);
+
+  while (st->size_ > base && e->ok_) {
+    Frame f = st->data_[--st->size_];
+    const ExprNode* node = f.node_;
+    if (!node) {
+      e->ok_ = false;
+      break;
+    }
+    bool pos = f.flag_ != 0;
+
+    if (node->type_ == NODE_NOT) {
+      PushFrame(st, node->left_, !pos, 0);
+    } else if ((pos && node->type_ == NODE_OR) ||
+               (!pos && node->type_ == NODE_AND)) {
+      PushFrame(st, node->right_, pos, 0);
+      PushFrame(st, node->left_, pos, 0);
+    } else if (pos && node->type_ == NODE_IMPLIES) {
+      PushFrame(st, node->right_, 1, 0);
+      PushFrame(st, node->left_, 0, 0);
+    } else {
+      int lit = EncodeNode(e, node, pos ? POL_POS : POL_NEG);
+      PushLit(&e->clause_, pos ? lit : -lit);
+    }
+  }
+  st->size_ = base;
+}
+
+static int CompareVars(const void* a, const void* b) {
+  int x = *(const int*)a, y = *(const int*)b;
+  return (x > y) - (x < y);
+}
+
+static int CompareNodes(const void* a, const void* b) {
+  uintptr_t x = (uintptr_t)*(const ExprNode* const*)a;
+  uintptr_t y = (uintptr_t)*(const ExprNode* const*)b;
+  return (x > y) - (x < y);
+}
+
+// Afirma uma cadeia de x como uma única restrição de paridade sobre as
+// folhas (literais repetidos se cancelam), em blocos de tamanho linear
+// em vez de uma auxiliar por porta
+static void AssertXor(Encoder* e, const ExprNode* root, bool pos) {
+  const ExprNode** leaves = NULL;
+  int size = 0, cap = 0;
+  bool parity;
+  if (!XorChainLeaves(root, &leaves, &size, &cap, &parity)) {
+    e->ok_ = false;
+    free(leaves);
+    return;
+  }
+  // Na arena, folhas iguais são o mesmo nó e se cancelam antes de serem
+  // codificadas; as demais repetições se cancelam pelos literais
+  qsort(leaves, size, sizeof(*leaves), CompareNodes);
+  int kept = 0;
+  for (int i = 0; i < size; i++) {
+    if (i + 1 < size && leaves[i] == leaves[i + 1])
+      i++;
+    else
+      leaves[kept++] = leaves[i];
+  }
+  size = kept;
+
+  int* vars = (int*)malloc(sizeof(int) * (size > 0 ? size : 1));
+  for (int i = 0; i < size && e->ok_; i++) {
+    int lit = EncodeNode(e, leaves[i], POL_BOTH);
+    parity ^= lit < 0;
+    vars[i] = lit < 0 ? -lit : lit;
+  }
+  free(leaves);
+  if (!e->ok_) {
+    free(vars);
+    return;
+  }
+  qsort(vars, size, sizeof(int), CompareVars);
+  int n = 0;
+  for (int i = 0; i < size; i++) {
+    if (i + 1 < size && vars[i] == vars[i + 1])
+      i++;
+    else
+      vars[n++] = vars[i];
+  }
+
+  ClauseSet clauses;
+  ClauseSetInit(&clauses);
+  XorEncodeClauses(vars, n, pos != parity, &e->enc_->num_vars_, &clauses);
+  for (int i = 0; i < clauses.num_clauses_; i++) {
+    e->clause_.size_ = 0;
+    const int* lits = ClauseSetClause(&clauses, i);
+    for (int j = 0; j < ClauseSetSize(&clauses, i); j++)
+      PushLit(&e->clause_, lits[j]);
+    if (e->guard_) PushLit(&e->clause_, e->guard_);
+    EmitClause(e, e->clause_.data_, e->clause_.size_);
+  }
+  ClauseSetFree(&clauses);
+  free(vars);
+}
+
+// Afirma a raiz: conjunções no topo viram restrições separadas,
+// disjunções de literais viram cláusulas diretamente, sem auxiliares, e
+// cadeias de x viram restrições de paridade (AssertXor).
+static void AssertRoot(Encoder* e, const ExprNode* root) {
+  FrameStack pending = {NULL, 0, 0};
+  PushFrame(&pending, root, 1, 0);
+
+  while (pending.size_ > 0 && e->ok_) {
+    Frame f = pending.data_[--pending.size_];
+    const ExprNode* node = f.node_;
+    if (!node) {
+      e->ok_ = false;
+      break;
+    }
+    bool pos = f.flag_ != 0;
+
+    if (node->type_ == NODE_NOT) {
+      PushFrame(&pending, node->left_, !pos, 0);
+    } else if ((pos && node->type_ == NODE_AND) ||
+               (!pos && node->type_ == NODE_OR)) {
+      PushFrame(&pending, node->right_, pos, 0);
+      PushFrame(&pending, node->left_, pos, 0);
+    } else if (!pos && node->type_ == NODE_IMPLIES) {
+      PushFrame(&pending, node->right_, 0, 0);
+      PushFrame(&pending, node->left_, 1, 0);
+    } else if (node->type_ == NODE_XOR) {
+      AssertXor(e, node, pos);
+    } else {
+      e->clause_.size_ = 0;
+      CollectClause(e, node, pos);
+      if (e->guard_) PushLit(&e->clause_, e->guard_);
+      if (e->ok_) EmitClause(e, e->clause_.data_, e->clause_.size_);
+    }
+  }
+  free(pending.data_);
+}
+
+// Registra as variáveis da entrada primeiro para que ocupem 1..n
+static bool CollectInputs(const ExprNode* root, VarMap* vars) {
+  FrameStack st = {NULL, 0, 0};
+  bool ok = true;
+  PushFrame(&st, root, 0, 0);
+  while (st.size_ > 0) {
+    const ExprNode* node = st.data_[--st.size_].node_;
+    if (!node) {
+      ok = false;
+      break;
+    }
+    if (node->type_ == NODE_VAR) {
+      VarMapGet(vars, node->variable_);
+      continue;
+    }
+    if (node->type_ != NODE_NOT) PushFrame(&st, node->right_, 0, 0);
+    PushFrame(&st, node->left_, 0, 0);
+  }
+  free(st.data_);
+  return ok;
+}
+
+static bool Encode(const ExprNode* root, bool full, CnfEncoding* enc) {
+  VarMapInit(&enc->vars_);
+  ClauseSetInit(&enc->cnf_);
+  enc->num_inputs_ = 0;
+  enc->num_vars_ = 0;
+
+  if (!root || !CollectInputs(root, &enc->vars_)) return false;
+  enc->num_inputs_ = enc->vars_.count_;
+  enc->num_vars_ = enc->num_inputs_;
+
+  Encoder e = {enc,  {NULL, 0, 0}, {NULL, 0, 0}, {NULL, 0, 0}, full,
+               true, NULL,         NULL,         0,            NULL, 0};
+  AssertRoot(&e, root);
+  free(e.gate_lit_);
+  free(e.gate_pol_);
+  free(e.frames_.data_);
+  free(e.values_.data_);
+  free(e.clause_.data_);
+
+  if (enc->cnf_.num_vars_ < enc->num_vars_) enc->cnf_.num_vars_ = enc->num_vars_;
+  return e.ok_;
+}
+
+bool EncodeTseitin(const ExprNode* root, CnfEncoding* enc) {
+  return Encode(root, true, enc);
+}
+
+bool EncodePlaistedGreenbaum(const ExprNode* root, CnfEncoding* enc) {
+  return Encode(root, false, enc);
+}
+
+void CnfEncodingFree(CnfEncoding* enc) {
+  VarMapFree(&enc->vars_);
+  ClauseSetFree(&enc->cnf_);
+}
+
+// --- Codificação Incremental ---
+
+void CnfIncrementalInit(CnfIncremental* inc) {
+  VarMapInit(&inc->enc_.vars_);
+  ClauseSetInit(&inc->enc_.cnf_);
+  inc->enc_.num_inputs_ = 0;
+  inc->enc_.num_vars_ = 0;
+  inc->input_var_ = NULL;
+  inc->input_cap_ = 0;
+  inc->gate_lit_ = NULL;
+  inc->gate_pol_ = NULL;
+  inc->gate_cap_ = 0;
+}
+
+void CnfIncrementalFree(CnfIncremental* inc) {
+  CnfEncodingFree(&inc->enc_);
+  free(inc->input_var_);
+  free(inc->gate_lit_);
+  free(inc->gate_pol_);
+  inc->input_var_ = NULL;
+  inc->input_cap_ = 0;
+  inc->gate_lit_ = NULL;
+  inc->gate_pol_ = NULL;
+  inc->gate_cap_ = 0;
+}
+
+// O codificador trabalha com as portas da sessão e as devolve no fim
+static void BeginIncremental(Encoder* e, CnfIncremental* inc, int guard) {
+  Encoder init = {&inc->enc_,     {NULL, 0, 0},    {NULL, 0, 0},
+                  {NULL, 0, 0},   false,           true,
+                  inc->gate_lit_, inc->gate_pol_,  inc->gate_cap_,
+                  inc,            guard};
+  *e = init;
+}
+
+static bool EndIncremental(Encoder* e) {
+  e->inc_->gate_lit_ = e->gate_lit_;
+  e->inc_->gate_pol_ = e->gate_pol_;
+  e->inc_->gate_cap_ = e->gate_cap_;
+  free(e->frames_.data_);
+  free(e->values_.data_);
+  free(e->clause_.data_);
+  CnfEncoding* enc = e->enc_;
+  if (enc->cnf_.num_vars_ < enc->num_vars_) enc->cnf_.num_vars_ = enc->num_vars_;
+  return e->ok_;
+}
+
+int CnfIncrementalInput(CnfIncremental* inc, int var) {
+  Encoder e;
+  BeginIncremental(&e, inc, 0);
+  int x = InputVar(&e, var);
+  EndIncremental(&e);
+  return x;
+}
+
+int CnfIncrementalFind(const CnfIncremental* inc, int var) {
+  int index = VarMapFind(&inc->enc_.vars_, var);
+  return index ? inc->input_var_[index] : 0;
+}
+
+int CnfIncrementalNewVar(CnfIncremental* inc) {
+  return ++inc->enc_.num_vars_;
+}
+
+bool CnfIncrementalLiteral(CnfIncremental* inc, const ExprNode* root,
+                           bool both, int* lit) {
+  if (!root) return false;
+  Encoder e;
+  BeginIncremental(&e, inc, 0);
+  *lit = EncodeNode(&e, root, both ? POL_BOTH : POL_POS);
+  return EndIncremental(&e);
+}
+
+bool CnfIncrementalAssert(CnfIncremental* inc, const ExprNode* root,
+                          int guard) {
+  if (!root) return false;
+  Encoder e;
+  BeginIncremental(&e, inc, guard);
+  AssertRoot(&e, root);
+  return EndIncremental(&e);
+}
@@ -0,0 +1,575 @@
+#include "../include/cover.h"
+
+#include <stdint.h>
+#include <stdlib.h>
+#include <string.h>
+
+// --- Termos a partir da Árvore ---
+
+typedef struct {
+  const ExprNode** data_;
+  int size_;
+  int cap_;
+} NodeStack;
+
+static void PushNode(NodeStack* st, const ExprNode* node) {
+  if (st->size_ == st->cap_) {
+    st->cap_ = st->cap_ ? st->cap_ * 2 : 64;
+    st->data_ =
+        (const ExprNode**)realloc(st->data_, sizeof(ExprNode*) * st->cap_);
+  }
+  st->data_[st->size_++] = node;
+}
+
+static int CompareLits(const void* a, const void* b) {
+  int x = *(const int*)a, y = *(const int*)b;
+  int ax = abs(x), ay = abs(y);
+  if (ax != ay) return (ax > ay) - (ax < ay);
+  return (x > y) - (x < y);
+}
+
+void CoverAddTerm(ClauseSet* terms, int* lits, int size) {
+  qsort(lits, size, sizeof(int), CompareLits);
+  int j = 0;
+  for (int i = 0; i < size; i++) {
+    if (j > 0 && lits[i] == lits[j - 1]) continue;
+    if (j > 0 && lits[i] == -lits[j - 1]) return;
+    lits[j++] = lits[i];
+  }
+  ClauseSetAdd(terms, lits, j);
+}
+
+static int LiteralOf(const ExprNode* node, VarMap* vars) {
+  if (node->type_ == NODE_VAR) return VarMapGet(vars, node->variable_);
+  if (node->type_ == NODE_NOT && node->left_ &&
+      node->left_->type_ == NODE_VAR)
+    return -VarMapGet(vars, node->left_->variable_);
+  return 0;
+}
+
+bool CoverFromTree(const ExprNode* root, NodeType outer, VarMap* vars,
+                   ClauseSet* terms) {
+  NodeType inner = outer == NODE_AND ? NODE_OR : NODE_AND;
+  NodeStack outer_st = {NULL, 0, 0};
+  NodeStack inner_st = {NULL, 0, 0};
+  int* lits = NULL;
+  int num_lits = 0, lits_cap = 0;
+  // Nós de `outer` já visitados: a árvore distribuída é um DAG e repetir
+  // um conjunto de termos não muda a fórmula
+  unsigned char* seen = NULL;
+  int seen_cap = 0;
+  bool ok = true;
+
+  PushNode(&outer_st, root);
+  while (ok && outer_st.size_ > 0) {
+    const ExprNode* node = outer_st.data_[--outer_st.size_];
+    if (!node) {
+      ok = false;
+      break;
+    }
+    if (node->type_ == outer) {
+      if (node->id_ > 0) {
+        if (node->id_ >= seen_cap) {
+          int cap = seen_cap ? seen_cap : 256;
+          while (cap <= node->id_) cap *= 2;
+          seen = (unsigned char*)realloc(seen, cap);
+          memset(seen + seen_cap, 0, cap - seen_cap);
+          seen_cap = cap;
+        }
+        if (seen[node->id_]) continue;
+        seen[node->id_] = 1;
+      }
+      PushNode(&outer_st, node->right_);
+      PushNode(&outer_st, node->left_);
+      continue;
+    }
+
+    // Um termo: reúne os literais sob `inner`
+    num_lits = 0;
+    PushNode(&inner_st, node);
+    while (ok && inner_st.size_ > 0) {
+      const ExprNode* n = inner_st.data_[--inner_st.size_];
+      if (n && n->type_ == inner) {
+        PushNode(&inner_st, n->right_);
+        PushNode(&inner_st, n->left_);
+        continue;
+      }
+      int lit = n ? LiteralOf(n, vars) : 0;
+      if (!lit) {
+        ok = false;
+        break;
+      }
+      if (num_lits == lits_cap) {
+        lits_cap = lits_cap ? lits_cap * 2 : 16;
+        lits = (int*)realloc(lits, sizeof(int) * lits_cap);
+      }
+      lits[num_lits++] = lit;
+    }
+    if (ok) CoverAddTerm(terms, lits, num_lits);
+  }
+
+  free(outer_st.data_);
+  free(inner_st.data_);
+  free(lits);
+  free(seen);
+  return ok;
+}
+
+// --- Subsunção ---
+
+static inline int LitIndex(int lit) {
+  return lit > 0 ? 2 * lit : 2 * -lit + 1;
+}
+
+// a e b ordenados por CompareLits
+static bool IsSubset(const int* a, int asize, const int* b, int bsize) {
+  if (asize > bsize) return false;
+  int j = 0;
+  for (int i = 0; i < asize; i++) {
+    while (j < bsize && CompareLits(&b[j], &a[i]) < 0) j++;
+    if (j == bsize || b[j] != a[i]) return false;
+    j++;
+  }
+  return true;
+}
+
+typedef struct {
+  int size_;
+  int index_;
+} TermKey;
+
+static int CompareKeys(const void* a, const void* b) {
+  const TermKey* x = (const TermKey*)a;
+  const TermKey* y = (const TermKey*)b;
+  if (x->size_ != y->size_) return x->size_ - y->size_;
+  return x->index_ - y->index_;
+}
+
+static void KeepTerms(ClauseSet* terms, const bool* keep) {
+  ClauseSet out;
+  ClauseSetInit(&out);
+  for (int i = 0; i < terms->num_clauses_; i++)
+    if (keep[i])
+      ClauseSetAdd(&out, ClauseSetClause(terms, i), ClauseSetSize(terms, i));
+  ClauseSetFree(terms);
+  *terms = out;
+}
+
+// Termos mantidos ficam indexados por um único literal (o menos frequente):
+// se S está contido em T, esse literal de S aparece em T, então basta
+// percorrer as listas dos literais de T
+void CoverRemoveSubsumed(ClauseSet* terms) {
+  int n = terms->num_clauses_;
+  if (n == 0) return;
+  int num_idx = 2 * terms->num_vars_ + 2;
+  int* count = (int*)calloc(num_idx, sizeof(int));
+  int* head = (int*)malloc(sizeof(int) * num_idx);
+  int* next = (int*)malloc(sizeof(int) * n);
+  uint64_t* sig = (uint64_t*)malloc(sizeof(uint64_t) * n);
+  TermKey* order = (TermKey*)malloc(sizeof(TermKey) * n);
+  bool* keep = (bool*)calloc(n, sizeof(bool));
+
+  for (int i = 0; i < num_idx; i++) head[i] = -1;
+  for (int i = 0; i < n; i++) {
+    const int* t = ClauseSetClause(terms, i);
+    int size = ClauseSetSize(terms, i);
+    sig[i] = 0;
+    for (int k = 0; k < size; k++) {
+      count[LitIndex(t[k])]++;
+      sig[i] |= 1ull << (LitIndex(t[k]) & 63);
+    }
+    order[i].size_ = size;
+    order[i].index_ = i;
+  }
+  qsort(order, n, sizeof(TermKey), CompareKeys);
+
+  bool has_empty = false;
+  for (int k = 0; k < n; k++) {
+    int i = order[k].index_;
+    const int* t = ClauseSetClause(terms, i);
+    int size = ClauseSetSize(terms, i);
+    bool subsumed = has_empty;
+    for (int a = 0; a < size && !subsumed; a++) {
+      for (int s = head[LitIndex(t[a])]; s >= 0 && !subsumed; s = next[s]) {
+        subsumed = (sig[s] & ~sig[i]) == 0 &&
+                   IsSubset(ClauseSetClause(terms, s), ClauseSetSize(terms, s),
+                            t, size);
+      }
+    }
+    if (subsumed) continue;
+
+    keep[i] = true;
+    if (size == 0) {
+      has_empty = true;
+      continue;
+    }
+    int best = LitIndex(t[0]);
+    for (int a = 1; a < size; a++)
+      if (count[LitIndex(t[a])] < count[best]) best = LitIndex(t[a]);
+    next[i] = head[best];
+    head[best] = i;
+  }
+  KeepTerms(terms, keep);
+
+  free(count);
+  free(head);
+  free(next);
+  free(sig);
+  free(order);
+  free(keep);
+}
+
+// --- Quine-McCluskey (poucas variáveis) ---
+// Implicante = (val, dc): dc marca as variáveis livres e val os valores das
+// demais (bit j = variável j + 1). impl[dc << n | val] indica implicante.
+
+static int PopCount(uint32_t x) {
+  int count = 0;
+  for (; x; x &= x - 1) count++;
+  return count;
+}
+
+static void MinimizeExact(ClauseSet* cubes, int n) {
+  uint32_t full = (1u << n) - 1;
+  size_t num_minterms = (size_t)1 << n;
+  unsigned char* on = (unsigned char*)calloc(num_minterms, 1);
+  for (int i = 0; i < cubes->num_clauses_; i++) {
+    const int* c = ClauseSetClause(cubes, i);
+    uint32_t val = 0, fixed = 0;
+    for (int k = 0; k < ClauseSetSize(cubes, i); k++) {
+      uint32_t bit = 1u << (abs(c[k]) - 1);
+      fixed |= bit;
+      if (c[k] > 0) val |= bit;
+    }
+    uint32_t free_bits = full & ~fixed;
+    for (uint32_t s = free_bits;; s = (s - 1) & free_bits) {
+      on[val | s] = 1;
+      if (!s) break;
+    }
+  }
+
+  size_t total = (size_t)1 << (2 * n);
+  unsigned char* impl = (unsigned char*)calloc(total, 1);
+  unsigned char* merged = (unsigned char*)calloc(total, 1);
+  memcpy(impl, on, num_minterms);
+
+  // dc crescente: (val, dc) já está completo quando é combinado
+  for (uint32_t dc = 0; dc <= full; dc++) {
+    uint32_t free_bits = full & ~dc;
+    for (uint32_t val = free_bits;; val = (val - 1) & free_bits) {
+      size_t id = (size_t)dc << n | val;
+      if (impl[id]) {
+        for (uint32_t rest = free_bits & ~val; rest; rest &= rest - 1) {
+          uint32_t bit = rest & -rest;
+          size_t other = (size_t)dc << n | (val | bit);
+          if (!impl[other]) continue;
+          impl[(size_t)(dc | bit) << n | val] = 1;
+          merged[id] = merged[other] = 1;
+        }
+      }
+      if (!val) break;
+    }
+  }
+
+  uint32_t* pv = NULL;
+  uint32_t* pd = NULL;
+  int num_primes = 0, primes_cap = 0;
+  for (size_t id = 0; id < total; id++) {
+    if (!impl[id] || merged[id]) continue;
+    if (num_primes == primes_cap) {
+      primes_cap = primes_cap ? primes_cap * 2 : 64;
+      pv = (uint32_t*)realloc(pv, sizeof(uint32_t) * primes_cap);
+      pd = (uint32_t*)realloc(pd, sizeof(uint32_t) * primes_cap);
+    }
+    pv[num_primes] = (uint32_t)(id & full);
+    pd[num_primes] = (uint32_t)(id >> n);
+    num_primes++;
+  }
+  free(impl);
+  free(merged);
+
+  // Cobertura: primeiro os primos essenciais, depois o que cobrir mais
+  // mintermos ainda descobertos (empate: menos literais)
+  bool* chosen = (bool*)calloc(num_primes ? num_primes : 1, sizeof(bool));
+  unsigned char* uncovered = on;
+  for (size_t m = 0; m < num_minterms; m++) {
+    if (!uncovered[m]) continue;
+    int hits = 0, last = -1;
+    for (int p = 0; p < num_primes && hits < 2; p++) {
+      if ((m & ~pd[p]) == pv[p]) {
+        hits++;
+        last = p;
+      }
+    }
+    if (hits == 1) chosen[last] = true;
+  }
+  for (;;) {
+    for (int p = 0; p < num_primes; p++) {
+      if (!chosen[p]) continue;
+      for (uint32_t s = pd[p];; s = (s - 1) & pd[p]) {
+        uncovered[pv[p] | s] = 0;
+        if (!s) break;
+      }
+    }
+    int best = -1, best_gain = 0;
+    for (int p = 0; p < num_primes; p++) {
+      if (chosen[p]) continue;
+      int gain = 0;
+      for (uint32_t s = pd[p];; s = (s - 1) & pd[p]) {
+        gain += uncovered[pv[p] | s];
+        if (!s) break;
+      }
+      if (gain > best_gain ||
+          (gain == best_gain && gain > 0 &&
+           PopCount(pd[p]) > PopCount(pd[best]))) {
+        best = p;
+        best_gain = gain;
+      }
+    }
+    if (best < 0) break;
+    chosen[best] = true;
+  }
+
+  ClauseSetClear(cubes);
+  for (int p = 0; p < num_primes; p++) {
+    if (!chosen[p]) continue;
+    for (int j = 0; j < n; j++) {
+      uint32_t bit = 1u << j;
+      if (pd[p] & bit) continue;
+      ClauseSetPushLit(cubes, (pv[p] & bit) ? j + 1 : -(j + 1));
+    }
+    ClauseSetEndClause(cubes);
+  }
+  free(chosen);
+  free(pv);
+  free(pd);
+  free(on);
+}
+
+// --- Espresso (EXPAND + IRREDUNDANT) ---
+// Notação posicional: 2 bits por variável (bit 2j = pode valer 0,
+// bit 2j + 1 = pode valer 1); 11 é "livre" e 00 nunca é armazenado.
+
+#define EVEN_BITS 0x5555555555555555ull
+
+typedef struct {
+  uint64_t* bits_;
+  int num_cubes_;
+  int cap_;
+  int words_;
+} CubeList;
+
+static void CubeListInit(CubeList* l, int words) {
+  l->bits_ = NULL;
+  l->num_cubes_ = 0;
+  l->cap_ = 0;
+  l->words_ = words;
+}
+
+static uint64_t* CubeListPush(CubeList* l) {
+  if (l->num_cubes_ == l->cap_) {
+    l->cap_ = l->cap_ ? l->cap_ * 2 : 16;
+    l->bits_ = (uint64_t*)realloc(l->bits_,
+                                  sizeof(uint64_t) * l->words_ * l->cap_);
+  }
+  return l->bits_ + (size_t)l->words_ * l->num_cubes_++;
+}
+
+static inline uint64_t* CubeAt(const CubeList* l, int i) {
+  return l->bits_ + (size_t)l->words_ * i;
+}
+
+static inline int Field(const uint64_t* c, int v) {
+  return (int)((c[v >> 5] >> (2 * (v & 31))) & 3);
+}
+
+// Máscara dos bits válidos (2 * nv bits ao todo)
+static void ValidMask(uint64_t* mask, int words, int nv) {
+  for (int w = 0; w < words; w++) {
+    int bits = 2 * nv - 64 * w;
+    mask[w] = bits >= 64 ? ~0ull : (1ull << bits) - 1;
+  }
+}
+
+static bool IsUniversal(const uint64_t* c, const uint64_t* mask, int words) {
+  for (int w = 0; w < words; w++)
+    if (c[w] != mask[w]) return false;
+  return true;
+}
+
+// Cofator de f em relação ao cubo c: descarta cubos disjuntos de c e
+// libera as variáveis fixadas por c
+static void Cofactor(const CubeList* f, const uint64_t* c,
+                     const uint64_t* mask, CubeList* out) {
+  int words = f->words_;
+  for (int i = 0; i < f->num_cubes_; i++) {
+    const uint64_t* d = CubeAt(f, i);
+    bool disjoint = false;
+    for (int w = 0; w < words && !disjoint; w++) {
+      uint64_t x = d[w] & c[w];
+      disjoint = (~(x | (x >> 1)) & EVEN_BITS & mask[w]) != 0;
+    }
+    if (disjoint) continue;
+    uint64_t* r = CubeListPush(out);
+    for (int w = 0; w < words; w++) r[w] = (d[w] | ~c[w]) & mask[w];
+  }
+}
+
+static bool Tautology(const CubeList* f, const uint64_t* mask, int nv) {
+  if (f->num_cubes_ == 0) return false;
+  for (int i = 0; i < f->num_cubes_; i++)
+    if (IsUniversal(CubeAt(f, i), mask, f->words_)) return true;
+
+  // Divide pela variável mais binária; cobertura unate sem cubo universal
+  // não é tautologia
+  int best = -1, best_score = 0;
+  int* pos = (int*)calloc(nv, sizeof(int));
+  int* neg = (int*)calloc(nv, sizeof(int));
+  for (int i = 0; i < f->num_cubes_; i++) {
+    const uint64_t* c = CubeAt(f, i);
+    for (int v = 0; v < nv; v++) {
+      int fld = Field(c, v);
+      if (fld == 2) pos[v]++;
+      if (fld == 1) neg[v]++;
+    }
+  }
+  for (int v = 0; v < nv; v++) {
+    if (pos[v] && neg[v] && pos[v] + neg[v] > best_score) {
+      best = v;
+      best_score = pos[v] + neg[v];
+    }
+  }
+  free(pos);
+  free(neg);
+  if (best < 0) return false;
+
+  bool taut = true;
+  uint64_t* lit = (uint64_t*)malloc(sizeof(uint64_t) * f->words_);
+  for (int value = 0; value < 2 && taut; value++) {
+    memcpy(lit, mask, sizeof(uint64_t) * f->words_);
+    lit[best >> 5] &= ~(3ull << (2 * (best & 31)));
+    lit[best >> 5] |= (value ? 2ull : 1ull) << (2 * (best & 31));
+    CubeList half;
+    CubeListInit(&half, f->words_);
+    Cofactor(f, lit, mask, &half);
+    taut = Tautology(&half, mask, nv);
+    free(half.bits_);
+  }
+  free(lit);
+  return taut;
+}
+
+// c está contido na união dos cubos vivos de f (exceto `skip`)?
+static bool Covered(const CubeList* f, const bool* alive, int skip,
+                    const uint64_t* c, const uint64_t* mask, int nv) {
+  CubeList rest, cof;
+  CubeListInit(&rest, f->words_);
+  CubeListInit(&cof, f->words_);
+  for (int i = 0; i < f->num_cubes_; i++) {
+    if (i == skip || !alive[i]) continue;
+    memcpy(CubeListPush(&rest), CubeAt(f, i), sizeof(uint64_t) * f->words_);
+  }
+  Cofactor(&rest, c, mask, &cof);
+  bool covered = Tautology(&cof, mask, nv);
+  free(rest.bits_);
+  free(cof.bits_);
+  return covered;
+}
+
+static int CountLiterals(const uint64_t* c, int nv) {
+  int lits = 0;
+  for (int v = 0; v < nv; v++) lits += Field(c, v) != 3;
+  return lits;
+}
+
+static void MinimizeHeuristic(ClauseSet* cubes, int nv) {
+  int words = (2 * nv + 63) / 64;
+  uint64_t* mask = (uint64_t*)malloc(sizeof(uint64_t) * words);
+  ValidMask(mask, words, nv);
+
+  CubeList f;
+  CubeListInit(&f, words);
+  for (int i = 0; i < cubes->num_clauses_; i++) {
+    uint64_t* c = CubeListPush(&f);
+    memcpy(c, mask, sizeof(uint64_t) * words);
+    const int* lits = ClauseSetClause(cubes, i);
+    for (int k = 0; k < ClauseSetSize(cubes, i); k++) {
+      int v = abs(lits[k]) - 1;
+      c[v >> 5] &= ~(3ull << (2 * (v & 31)));
+      c[v >> 5] |= (lits[k] > 0 ? 2ull : 1ull) << (2 * (v & 31));
+    }
+  }
+  int n = f.num_cubes_;
+  bool* alive = (bool*)malloc(sizeof(bool) * (n ? n : 1));
+  for (int i = 0; i < n; i++) alive[i] = true;
+
+  // EXPAND: libera cada literal enquanto o cubo continuar dentro da função;
+  // cubos contidos no cubo expandido saem da cobertura
+  uint64_t* trial = (uint64_t*)malloc(sizeof(uint64_t) * words);
+  for (int i = 0; i < n; i++) {
+    if (!alive[i]) continue;
+    uint64_t* c = CubeAt(&f, i);
+    for (int v = 0; v < nv; v++) {
+      if (Field(c, v) == 3) continue;
+      memcpy(trial, c, sizeof(uint64_t) * words);
+      trial[v >> 5] |= 3ull << (2 * (v & 31));
+      if (Covered(&f, alive, -1, trial, mask, nv))
+        memcpy(c, trial, sizeof(uint64_t) * words);
+    }
+    for (int j = 0; j < n; j++) {
+      if (j == i || !alive[j]) continue;
+      const uint64_t* d = CubeAt(&f, j);
+      bool inside = true;
+      for (int w = 0; w < words && inside; w++) inside = (d[w] & ~c[w]) == 0;
+      if (inside) alive[j] = false;
+    }
+  }
+  free(trial);
+
+  // IRREDUNDANT: remove, começando pelos menores cubos, os que já estão
+  // cobertos pelos demais
+  TermKey* order = (TermKey*)malloc(sizeof(TermKey) * (n ? n : 1));
+  for (int i = 0; i < n; i++) {
+    order[i].size_ = -CountLiterals(CubeAt(&f, i), nv);
+    order[i].index_ = i;
+  }
+  qsort(order, n, sizeof(TermKey), CompareKeys);
+  for (int k = 0; k < n; k++) {
+    int i = order[k].index_;
+    if (alive[i] && Covered(&f, alive, i, CubeAt(&f, i), mask, nv))
+      alive[i] = false;
+  }
+  free(order);
+
+  ClauseSetClear(cubes);
+  for (int i = 0; i < n; i++) {
+    if (!alive[i]) continue;
+    const uint64_t* c = CubeAt(&f, i);
+    for (int v = 0; v < nv; v++) {
+      int fld = Field(c, v);
+      if (fld != 3) ClauseSetPushLit(cubes, fld == 2 ? v + 1 : -(v + 1));
+    }
+    ClauseSetEndClause(cubes);
+  }
+  free(alive);
+  free(f.bits_);
+  free(mask);
+}
+
+static void NegateLiterals(ClauseSet* terms) {
+  for (size_t i = 0; i < terms->num_lits_; i++) terms->lits_[i] = -terms->lits_[i];
+}
+
+void CoverMinimize(ClauseSet* terms, bool cnf) {
+  // Cláusulas da CNF de f são os cubos negados da DNF de nf
+  if (cnf) NegateLiterals(terms);
+  CoverRemoveSubsumed(terms);
+
+  int nv = terms->num_vars_;
+  if (nv <= COVER_EXACT_MAX_VARS)
+    MinimizeExact(terms, nv);
+  else
+    MinimizeHeuristic(terms, nv);
+
+  if (cnf) NegateLiterals(terms);
+}
@@ -0,0 +1,297 @@
+#include "../include/dimacs.h"
+
+#include <limits.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "../include/mapped_file.h"
+
+void DimacsFormulaInit(DimacsFormula* f) {
+  ClauseSetInit(&f->clauses_);
+  f->weights_ = NULL;
+  f->weights_cap_ = 0;
+  f->top_ = LLONG_MAX;
+  f->declared_vars_ = 0;
+  f->declared_clauses_ = 0;
+}
+
+void DimacsFormulaFree(DimacsFormula* f) {
+  ClauseSetFree(&f->clauses_);
+  free(f->weights_);
+  f->weights_ = NULL;
+  f->weights_cap_ = 0;
+}
+
+// --- Leitura ---
+
+typedef struct {
+  const char* data_;
+  size_t size_;
+  size_t pos_;
+  long long line_;
+} DimacsReader;
+
+static inline bool IsBlank(char c) {
+  return c == ' ' || c == '\t' || c == '\r' || c == '\f' || c == '\v';
+}
+
+static void SkipLine(DimacsReader* r) {
+  const char* end =
+      (const char*)memchr(r->data_ + r->pos_, '\n', r->size_ - r->pos_);
+  r->pos_ = end ? (size_t)(end - r->data_) : r->size_;
+}
+
+// Inteiro com sinal até o próximo espaço; false se não houver dígitos, se
+// vier colado a outro caractere ou se passar de LLONG_MAX
+static bool ReadNumber(DimacsReader* r, long long* value) {
+  const char* p = r->data_ + r->pos_;
+  const char* end = r->data_ + r->size_;
+  bool negative = p < end && *p == '-';
+  if (negative) p++;
+  const char* digits = p;
+  unsigned long long v = 0;
+  while (p < end && *p >= '0' && *p <= '9') {
+    unsigned d = (unsigned)(*p++ - '0');
+    if (v > ((unsigned long long)LLONG_MAX - d) / 10) return false;
+    v = v * 10 + d;
+  }
+  if (p == digits || (p < end && !IsBlank(*p) && *p != '\n')) return false;
+  r->pos_ = (size_t)(p - r->data_);
+  *value = negative ? -(long long)v : (long long)v;
+  return true;
+}
+
+// Campo seguinte da linha atual (pula brancos, mas não a quebra de linha)
+static bool NextField(DimacsReader* r, long long* value) {
+  while (r->pos_ < r->size_ && IsBlank(r->data_[r->pos_])) r->pos_++;
+  return ReadNumber(r, value);
+}
+
+static bool NextWord(DimacsReader* r, const char* word) {
+  while (r->pos_ < r->size_ && IsBlank(r->data_[r->pos_])) r->pos_++;
+  size_t len = strlen(word);
+  if (r->size_ - r->pos_ < len || memcmp(r->data_ + r->pos_, word, len))
+    return false;
+  r->pos_ += len;
+  return r->pos_ == r->size_ || IsBlank(r->data_[r->pos_]) ||
+         r->data_[r->pos_] == '\n';
+}
+
+static void PushWeight(DimacsFormula* f, long long weight) {
+  size_t i = (size_t)f->clauses_.num_clauses_;
+  if (i == f->weights_cap_) {
+    f->weights_cap_ = f->weights_cap_ ? f->weights_cap_ * 2 : 64;
+    f->weights_ = (long long*)realloc(f->weights_,
+                                      sizeof(long long) * f->weights_cap_);
+  }
+  f->weights_[i] = weight;
+}
+
+// Sem cabeçalho, o arquivo é WCNF no formato novo se alguma linha
+// começar com "h"
+static bool HasHardMarker(const char* data, size_t size) {
+  for (size_t i = 0; i < size; i++) {
+    while (i < size && IsBlank(data[i])) i++;
+    if (i < size && data[i] == 'h' &&
+        (i + 1 == size || IsBlank(data[i + 1])))
+      return true;
+    const char* end = (const char*)memchr(data + i, '\n', size - i);
+    if (!end) break;
+    i = (size_t)(end - data);
+  }
+  return false;
+}
+
+bool DimacsParse(const char* data, size_t size, DimacsFormula* f,
+                 long long* error_line) {
+  DimacsFormulaInit(f);
+  DimacsReader r = {data, size, 0, 1};
+  bool header = false, weighted = false, open = false;
+  bool ok = true;
+  int max_var = 0;
+
+  while (ok && r.pos_ < r.size_) {
+    char c = r.data_[r.pos_];
+    if (IsBlank(c)) {
+      r.pos_++;
+      continue;
+    }
+    if (c == '\n') {
+      r.pos_++;
+      r.line_++;
+      continue;
+    }
+    if (c == 'c') {
+      SkipLine(&r);
+      continue;
+    }
+    if (c == '%') break;
+
+    if (c == 'p') {
+      long long vars, clauses;
+      r.pos_++;
+      ok = !header && !open && f->clauses_.num_clauses_ == 0;
+      if (ok && NextWord(&r, "wcnf")) {
+        weighted = true;
+      } else {
+        ok = ok && NextWord(&r, "cnf");
+      }
+      ok = ok && NextField(&r, &vars) && NextField(&r, &clauses) &&
+           vars >= 0 && vars <= INT_MAX && clauses >= 0 &&
+           clauses <= INT_MAX;
+      if (!ok) break;
+      if (weighted) {
+        while (r.pos_ < r.size_ && IsBlank(r.data_[r.pos_])) r.pos_++;
+        if (r.pos_ < r.size_ && r.data_[r.pos_] != '\n')
+          ok = NextField(&r, &f->top_) && f->top_ > 0;
+      }
+      header = true;
+      f->declared_vars_ = (int)vars;
+      f->declared_clauses_ = (int)clauses;
+      max_var = f->declared_vars_;
+      // O cabeçalho é só uma dica: cada cláusula ocupa ao menos 2 bytes
+      // ("0" e o separador), então não se reserva além do que o resto do
+      // arquivo comporta. Literais: estimativa de 4 bytes por literal.
+      size_t rest = r.size_ - r.pos_;
+      size_t hint = (size_t)clauses < rest / 2 ? (size_t)clauses : rest / 2;
+      ClauseSetReserve(&f->clauses_, hint, rest / 4);
+      if (weighted) {
+        f->weights_cap_ = hint + 1;
+        f->weights_ =
+            (long long*)malloc(sizeof(long long) * f->weights_cap_);
+      }
+      continue;
+    }
+
+    // Início de cláusula sem cabeçalho: decide o formato uma vez
+    if (!header && !open && f->clauses_.num_clauses_ == 0 && !weighted) {
+      weighted = HasHardMarker(r.data_ + r.pos_, r.size_ - r.pos_);
+      f->top_ = weighted ? -1 : LLONG_MAX;  // no formato novo: no fim
+      header = true;
+    }
+
+    if (!open && weighted) {
+      open = true;
+      if (c == 'h' && f->top_ < 0) {
+        r.pos_++;
+        PushWeight(f, -1);
+        continue;
+      }
+      long long weight;
+      ok = ReadNumber(&r, &weight) && weight >= 0;
+      if (ok) PushWeight(f, weight);
+      continue;
+    }
+
+    long long lit;
+    ok = ReadNumber(&r, &lit) && lit >= -INT_MAX && lit <= INT_MAX;
+    if (!ok) break;
+    if (lit == 0) {
+      ClauseSetEndClause(&f->clauses_);
+      open = false;
+      continue;
+    }
+    ClauseSetPushLit(&f->clauses_, (int)lit);
+    open = true;
+  }
+
+  // Última cláusula sem o 0 final
+  if (ok && open) ClauseSetEndClause(&f->clauses_);
+  if (weighted && f->top_ < 0) {
+    // Formato novo: rígidas pesam mais que todas as flexíveis juntas
+    long long top = 1;
+    for (int i = 0; i < f->clauses_.num_clauses_; i++)
+      if (f->weights_[i] > 0)
+        top = f->weights_[i] > LLONG_MAX - top ? LLONG_MAX
+                                               : top + f->weights_[i];
+    f->top_ = top;
+    for (int i = 0; i < f->clauses_.num_clauses_; i++)
+      if (f->weights_[i] < 0) f->weights_[i] = top;
+  }
+  if (f->clauses_.num_vars_ < max_var) f->clauses_.num_vars_ = max_var;
+  if (!ok) {
+    if (error_line) *error_line = r.line_;
+    DimacsFormulaFree(f);
+    memset(f, 0, sizeof(*f));
+  }
+  return ok;
+}
+
+bool DimacsReadFile(const char* path, DimacsFormula* f,
+                    long long* error_line) {
+  MappedFile file;
+  if (!MappedFileOpen(&file, path)) {
+    memset(f, 0, sizeof(*f));
+    if (error_line) *error_line = -1;
+    return false;
+  }
+  bool ok = DimacsParse(file.data_, file.size_, f, error_line);
+  MappedFileClose(&file);
+  return ok;
+}
+
+// --- Escrita ---
+
+#define DIMACS_WRITE_BUFFER (64 * 1024)
+
+typedef struct {
+  FILE* out_;
+  char data_[DIMACS_WRITE_BUFFER];
+  size_t size_;
+  bool ok_;
+} DimacsWriter;
+
+static void WriterFlush(DimacsWriter* w) {
+  if (w->size_ && fwrite(w->data_, 1, w->size_, w->out_) != w->size_)
+    w->ok_ = false;
+  w->size_ = 0;
+}
+
+// Um número (até 20 caracteres) e o separador
+static void WriteNumber(DimacsWriter* w, long long value, char sep) {
+  if (w->size_ + 24 > DIMACS_WRITE_BUFFER) WriterFlush(w);
+  char digits[24];
+  int n = 0;
+  unsigned long long v = value < 0 ? 0ull - (unsigned long long)value
+                                   : (unsigned long long)value;
+  do {
+    digits[n++] = (char)('0' + v % 10);
+    v /= 10;
+  } while (v);
+  if (value < 0) w->data_[w->size_++] = '-';
+  while (n > 0) w->data_[w->size_++] = digits[--n];
+  w->data_[w->size_++] = sep;
+}
+
+static void WriteText(DimacsWriter* w, const char* text) {
+  size_t len = strlen(text);
+  if (w->size_ + len > DIMACS_WRITE_BUFFER) WriterFlush(w);
+  memcpy(w->data_ + w->size_, text, len);
+  w->size_ += len;
+}
+
+bool DimacsWrite(FILE* out, const DimacsFormula* f) {
+  DimacsWriter* w = (DimacsWriter*)malloc(sizeof(DimacsWriter));
+  w->out_ = out;
+  w->size_ = 0;
+  w->ok_ = true;
+
+  const ClauseSet* cs = &f->clauses_;
+  int num_vars = cs->num_vars_ > f->declared_vars_ ? cs->num_vars_
+                                                   : f->declared_vars_;
+  WriteText(w, f->weights_ ? "p wcnf " : "p cnf ");
+  WriteNumber(w, num_vars, ' ');
+  WriteNumber(w, cs->num_clauses_, f->weights_ ? ' ' : '\n');
+  if (f->weights_) WriteNumber(w, f->top_, '\n');
+  for (int i = 0; i < cs->num_clauses_; i++) {
+    if (f->weights_) WriteNumber(w, f->weights_[i], ' ');
+    const int* lits = ClauseSetClause(cs, i);
+    int size = ClauseSetSize(cs, i);
+    for (int j = 0; j < size; j++) WriteNumber(w, lits[j], ' ');
+    WriteNumber(w, 0, '\n');
+  }
+  WriterFlush(w);
+  bool ok = w->ok_;
+  free(w);
+  return ok;
+}
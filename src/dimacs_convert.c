@@ -0,0 +1,124 @@
+#include "../include/dimacs_convert.h"
+
+#include <stdlib.h>
+
+#include "../include/clause_set.h"
+#include "../include/cnf_encoder.h"
+#include "../include/convert_internal.h"
+#include "../include/dimacs.h"
+#include "../include/expr_arena.h"
+#include "../include/var_map.h"
+
+bool FindSatisfyingModelDimacs(const char* path, bool** model,
+                               int* model_size, long long* error_line) {
+  DimacsFormula f;
+  if (error_line) *error_line = 0;
+  PhaseMark mark = PhaseBegin(NULL);
+  bool ok = DimacsReadFile(path, &f, error_line);
+  PhaseEnd(PHASE_PARSE, mark, NULL);
+  if (!ok) return false;
+
+  // As variáveis do arquivo já são densas: a codificação é a identidade
+  CnfEncoding enc;
+  int n = f.clauses_.num_vars_;
+  VarMapInit(&enc.vars_);
+  for (int v = 1; v <= n; v++) VarMapGet(&enc.vars_, v);
+  enc.num_inputs_ = n;
+  enc.num_vars_ = n;
+  if (f.weights_) {
+    ClauseSetInit(&enc.cnf_);
+    for (int i = 0; i < f.clauses_.num_clauses_; i++)
+      if (DimacsIsHard(&f, i))
+        ClauseSetAdd(&enc.cnf_, ClauseSetClause(&f.clauses_, i),
+                     ClauseSetSize(&f.clauses_, i));
+    enc.cnf_.num_vars_ = n;
+    DimacsFormulaFree(&f);
+  } else {
+    enc.cnf_ = f.clauses_;  // sem cópia; liberada com enc
+  }
+
+  bool* values = (bool*)calloc(n + 1, sizeof(bool));
+  bool sat = SatByCdcl(&enc, values);
+  CnfEncodingFree(&enc);
+  if (sat && model) {
+    *model = values;
+    *model_size = n + 1;
+  } else {
+    free(values);
+  }
+  return sat;
+}
+
+// Copia os termos para out trocando cada variável v por names[v]
+static void AddNamedClauses(const ClauseSet* terms, const int* names,
+                            ClauseSet* out) {
+  ClauseSetReserve(out, out->num_clauses_ + terms->num_clauses_,
+                   out->num_lits_ + terms->num_lits_);
+  for (int i = 0; i < terms->num_clauses_; i++) {
+    const int* lits = ClauseSetClause(terms, i);
+    for (int j = 0; j < ClauseSetSize(terms, i); j++) {
+      int v = names[abs(lits[j])];
+      ClauseSetPushLit(out, lits[j] > 0 ? v : -v);
+    }
+    ClauseSetEndClause(out);
+  }
+}
+
+bool WriteCNFDimacs(const char* input, CnfMode mode, FILE* out) {
+  ExprArena arena;
+  ExprArenaInit(&arena);
+  int pos = 0;
+  PhaseMark mark = PhaseBegin(&arena);
+  ExprNode* root = ParseExpressionArena(&arena, input, &pos);
+  PhaseEnd(PHASE_PARSE, mark, &arena);
+  if (!root) {
+    ReleaseArena(&arena);
+    return false;
+  }
+
+  DimacsFormula f;
+  DimacsFormulaInit(&f);
+  bool ok;
+  if (mode == CNF_EQUIVALENT) {
+    // Mesmos passos de ConvertToCNF, sem a volta para texto
+    VarMap vars;
+    ClauseSet terms;
+    VarMapInit(&vars);
+    ClauseSetInit(&terms);
+    ok = NormalFormTerms(&arena, &root, true, MINIMIZE_SIMPLIFY, &vars,
+                         &terms);
+    if (ok) AddNamedClauses(&terms, vars.originals_, &f.clauses_);
+    ClauseSetFree(&terms);
+    VarMapFree(&vars);
+  } else {
+    CnfEncoding enc;
+    mark = PhaseBegin(NULL);
+    ok = mode == CNF_TSEITIN ? EncodeTseitin(root, &enc)
+                             : EncodePlaistedGreenbaum(root, &enc);
+    PhaseEnd(PHASE_ENCODE, mark, NULL);
+    if (ok) {
+      // Auxiliares depois da maior variável, como em EncodingToString
+      int max_var = 0;
+      for (int i = 1; i <= enc.num_inputs_; i++)
+        if (enc.vars_.originals_[i] > max_var)
+          max_var = enc.vars_.originals_[i];
+      int* names = (int*)malloc(sizeof(int) * (enc.num_vars_ + 1));
+      for (int v = 1; v <= enc.num_vars_; v++)
+        names[v] = v <= enc.num_inputs_ ? enc.vars_.originals_[v]
+                                        : max_var + (v - enc.num_inputs_);
+      AddNamedClauses(&enc.cnf_, names, &f.clauses_);
+      f.declared_vars_ = max_var + (enc.num_vars_ - enc.num_inputs_);
+      free(names);
+    }
+    CnfEncodingFree(&enc);
+  }
+  ReleaseArena(&arena);
+
+  if (ok) {
+    mark = PhaseBegin(NULL);
+    ok = DimacsWrite(out, &f);
+    PhaseEnd(PHASE_TO_STRING, mark, NULL);
+  }
+  DimacsFormulaFree(&f);
+  return ok;
+}
@@ -5,354 +5,1380 @@
 #include <stdlib.h>
 #include <string.h>
 
+#include "../include/bdd.h"
+#include "../include/bit_eval.h"
+#include "../include/cnf_encoder.h"
+#include "../include/convert_internal.h"
+#include "../include/cover.h"
+#include "../include/expr_arena.h"
+#include "../include/expr_table.h"
+#include "../include/model_count.h"
+#include "../include/preprocess.h"
+#include "../include/sat_solver.h"
+#include "../include/xor_system.h"
+
+#ifdef _WIN32
+#include <windows.h>
+#else
+#include <time.h>
+#endif
+
+// Até este número de variáveis distintas a varredura bit-paralela das 2^n
+// atribuições ainda é mais barata que codificar e chamar o resolvedor CDCL
+#define EXHAUSTIVE_MAX_VARS 20
+
+// Limite de nós do BDD na verificação de equivalência; acima dele a
+// verificação cai para o resolvedor CDCL
+#define BDD_EQUIV_MAX_NODES (1 << 21)
+
+// --- Instrumentação ---
+// Ganchos declarados em convert_internal.h
+
+THREAD_LOCAL ConvertStats g_stats;
+
+#ifdef LOGICA_STATS
+bool g_stats_enabled = false;
+#endif
+
+bool ConvertStatsEnable(bool enabled) {
+#ifdef LOGICA_STATS
+  g_stats_enabled = enabled;
+  return true;
+#else
+  (void)enabled;
+  return false;
+#endif
+}
+
+bool ConvertStatsEnabled(void) { return STATS_ON(); }
+
+void ConvertStatsReset(void) { memset(&g_stats, 0, sizeof(g_stats)); }
+
+void ConvertStatsGet(ConvertStats* stats) { *stats = g_stats; }
+
+const char* ConvertPhaseName(ConvertPhase phase) {
+  static const char* const kNames[NUM_CONVERT_PHASES] = {
+      "parse",    "normalize", "push_negations", "preprocess",
+      "distribute", "simplify", "encode",        "solve",
+      "to_string"};
+  return phase >= 0 && phase < NUM_CONVERT_PHASES ? kNames[phase] : "?";
+}
+
+static double StatsNow(void) {
+#ifdef _WIN32
+  LARGE_INTEGER freq, count;
+  QueryPerformanceFrequency(&freq);
+  QueryPerformanceCounter(&count);
+  return (double)count.QuadPart / (double)freq.QuadPart;
+#else
+  struct timespec ts;
+  clock_gettime(CLOCK_MONOTONIC, &ts);
+  return (double)ts.tv_sec + (double)ts.tv_nsec * 1e-9;
+#endif
+}
+
+PhaseMark PhaseBegin(const ExprArena* arena) {
+  PhaseMark mark = {0, 0};
+  if (STATS_ON()) {
+    mark.start_ = StatsNow();
+    mark.nodes_ = arena ? arena->num_nodes_ : 0;
+  }
+  return mark;
+}
+
+void PhaseEnd(ConvertPhase phase, PhaseMark mark, const ExprArena* arena) {
+  if (!STATS_ON()) return;
+  g_stats.phase_seconds_[phase] += StatsNow() - mark.start_;
+  g_stats.phase_calls_[phase]++;
+  if (arena)
+    g_stats.phase_nodes_[phase] += (long long)(arena->num_nodes_ - mark.nodes_);
+}
+
+void ReleaseArena(ExprArena* arena) {
+  if (STATS_ON()) {
+    long long nodes = (long long)arena->num_nodes_;
+    g_stats.nodes_allocated_ += nodes;
+    g_stats.nodes_freed_ += nodes;
+    g_stats.nodes_shared_ += (long long)arena->num_hits_;
+    if (nodes > g_stats.peak_nodes_) g_stats.peak_nodes_ = nodes;
+  }
+  ExprArenaRelease(arena);
+}
+
 // --- Construtores Básicos ---
+// Com arena != NULL o nó vai para a arena (liberada de uma vez só);
+// com NULL usa malloc e deve ser liberado com FreeExprTree
 
-ExprNode* CreateNode(NodeType type, ExprNode* left, ExprNode* right) {
+ExprNode* CreateNode(ExprArena* arena, NodeType type, ExprNode* left,
+                     ExprNode* right) {
+  if (arena) return ArenaNode(arena, type, left, right);
+  STAT_ADD(nodes_allocated_, 1);
   ExprNode* node = (ExprNode*)malloc(sizeof(ExprNode));
   node->type_ = type;
   node->variable_ = 0;
   node->left_ = left;
   node->right_ = right;
+  node->id_ = 0;
   return node;
 }
 
-ExprNode* CreateVar(int var) {
+ExprNode* CreateVar(ExprArena* arena, int var) {
+  if (arena) return ArenaVar(arena, var);
+  STAT_ADD(nodes_allocated_, 1);
   ExprNode* node = (ExprNode*)malloc(sizeof(ExprNode));
   node->type_ = NODE_VAR;
   node->variable_ = var;
   node->left_ = NULL;
   node->right_ = NULL;
+  node->id_ = 0;
   return node;
 }
 
+// Sem pilha: gira o filho esquerdo para cima até o nó não ter filho
+// esquerdo, libera-o e segue pelo direito
 void FreeExprTree(ExprNode* node) {
-  if (!node) return;
-  FreeExprTree(node->left_);
-  FreeExprTree(node->right_);
-  free(node);
+  while (node) {
+    ExprNode* left = node->left_;
+    if (left) {
+      node->left_ = left->right_;
+      left->right_ = node;
+      node = left;
+      continue;
+    }
+    ExprNode* next = node->right_;
+    STAT_ADD(nodes_freed_, 1);
+    free(node);
+    node = next;
+  }
 }
 
-ExprNode* CloneTree(ExprNode* node) {
+// Pós-ordem com pilha explícita: cada nó interno entra duas vezes, a
+// segunda com as cópias dos filhos já no topo de done
+typedef struct {
+  ExprNode* node_;
+  bool expanded_;
+} TreeFrame;
+
+static void PushFrame(TreeFrame** frames, int* num, int* cap,
+                      ExprNode* node, bool expanded) {
+  if (*num == *cap) {
+    *cap = *cap ? *cap * 2 : 64;
+    *frames = (TreeFrame*)realloc(*frames, sizeof(TreeFrame) * (size_t)*cap);
+  }
+  (*frames)[(*num)++] = (TreeFrame){node, expanded};
+}
+
+// Na arena a cópia passa pela tabela única: copiar uma árvore que já está
+// na mesma arena devolve os próprios nós
+static ExprNode* CloneRec(ExprArena* arena, ExprNode* node) {
   if (!node) return NULL;
-  ExprNode* new_node = (ExprNode*)malloc(sizeof(ExprNode));
-  *new_node = *node;  // Cópia rasa
-  new_node->left_ = CloneTree(node->left_);
-  new_node->right_ = CloneTree(node->right_);
-  return new_node;
+  TreeFrame* frames = NULL;
+  ExprNode** done = NULL;
+  int num_frames = 0, frames_cap = 0, num_done = 0, done_cap = 0;
+  PushFrame(&frames, &num_frames, &frames_cap, node, false);
+  while (num_frames > 0) {
+    TreeFrame frame = frames[--num_frames];
+    ExprNode* n = frame.node_;
+    ExprNode* copy;
+    if (n->type_ == NODE_VAR) {
+      STAT_ADD(clone_bytes_, sizeof(ExprNode));
+      copy = CreateVar(arena, n->variable_);
+    } else if (!frame.expanded_) {
+      PushFrame(&frames, &num_frames, &frames_cap, n, true);
+      if (n->right_) PushFrame(&frames, &num_frames, &frames_cap, n->right_,
+                               false);
+      PushFrame(&frames, &num_frames, &frames_cap, n->left_, false);
+      continue;
+    } else {
+      STAT_ADD(clone_bytes_, sizeof(ExprNode));
+      ExprNode* r = n->right_ ? done[--num_done] : NULL;
+      ExprNode* l = done[--num_done];
+      copy = CreateNode(arena, n->type_, l, r);
+    }
+    if (num_done == done_cap) {
+      done_cap = done_cap ? done_cap * 2 : 64;
+      done = (ExprNode**)realloc(done, sizeof(ExprNode*) * (size_t)done_cap);
+    }
+    done[num_done++] = copy;
+  }
+  ExprNode* root = done[0];
+  free(frames);
+  free(done);
+  return root;
 }
 
-// --- Parser Atualizado (Suporta v, >, x, a, n) ---
-// Precedência básica: ( ) > n > a > v > > x
+ExprNode* CloneTreeArena(ExprArena* arena, ExprNode* node) {
+  STAT_ADD(clone_calls_, 1);
+  return CloneRec(arena, node);
+}
 
-ExprNode* ParsePrimary(const char* input, int* pos);
+ExprNode* CloneTree(ExprNode* node) { return CloneTreeArena(NULL, node); }
 
-ExprNode* ParseExpression(const char* input, int* pos) {
-  ExprNode* left = ParsePrimary(input, pos);
-  while (input[*pos] == ' ') (*pos)++;
-
-  // Simples parser recursivo (pode ser melhorado para precedência correta)
-  // Aqui tratamos operadores binários genericamente
-  while (strchr("avx>", input[*pos]) && input[*pos] != '\0') {
-    char op = input[*pos];
-    (*pos)++;
-    ExprNode* right = ParsePrimary(input, pos);
-
-    NodeType type;
-    if (op == 'a')
-      type = NODE_AND;
-    else if (op == 'v')
-      type = NODE_OR;
-    else if (op == 'x')
-      type = NODE_XOR;
-    else if (op == '>')
-      type = NODE_IMPLIES;
-
-    left = CreateNode(type, left, right);
-    while (input[*pos] == ' ') (*pos)++;
-  }
-  return left;
-}
-
-ExprNode* ParsePrimary(const char* input, int* pos) {
-  while (input[*pos] == ' ') (*pos)++;
-
-  if (input[*pos] == 'n') {  // NOT
-    (*pos)++;
-    return CreateNode(NODE_NOT, ParsePrimary(input, pos), NULL);
-  }
-  if (input[*pos] == '(') {
-    (*pos)++;
-    ExprNode* node = ParseExpression(input, pos);
-    while (input[*pos] != ')' && input[*pos] != '\0') (*pos)++;
-    if (input[*pos] == ')') (*pos)++;
-    return node;
-  }
-  if (input[*pos] >= '0' && input[*pos] <= '9') {
-    int var = 0;
-    while (input[*pos] >= '0' && input[*pos] <= '9') {
-      var = var * 10 + (input[*pos] - '0');
-      (*pos)++;
+// --- Parser ---
+// A análise é feita pelo parser iterativo de expr_table.c (precedência
+// n > a > v > > > x); aqui a tabela plana vira nós ExprNode. Como os
+// filhos vêm antes dos pais na tabela, a conversão é um único laço.
+//
+// A tabela é só a saída do parser: os passos de conversão reescrevem a
+// sentença, e o fazem sobre o DAG da arena, cujos nós também ficam em
+// blocos contíguos e ganham ids densos para a memoização. Na arena, a
+// conversão já compartilha as subexpressões repetidas da entrada.
+
+static ExprNode* TableToTree(ExprArena* arena, const ExprTable* table) {
+  ExprNode** nodes = (ExprNode**)malloc(sizeof(ExprNode*) * table->count_);
+  for (uint32_t i = 0; i < table->count_; i++) {
+    NodeType type = (NodeType)table->types_[i];
+    if (type == NODE_VAR) {
+      nodes[i] = CreateVar(arena, table->vars_[i]);
+    } else {
+      ExprNode* r =
+          table->right_[i] == EXPR_TABLE_NONE ? NULL : nodes[table->right_[i]];
+      nodes[i] = CreateNode(arena, type, nodes[table->left_[i]], r);
     }
-    return CreateVar(var);
   }
-  return NULL;
+  ExprNode* root = nodes[ExprTableRoot(table)];
+  free(nodes);
+  return root;
+}
+
+ExprNode* ParseExpressionArena(ExprArena* arena, const char* input,
+                               int* pos) {
+  ExprTable table;
+  ExprTableInit(&table);
+  size_t end;
+  ExprNode* root = NULL;
+  if (ExprTableParse(&table, input + *pos, strlen(input + *pos), &end))
+    root = TableToTree(arena, &table);
+  *pos += (int)end;
+  ExprTableFree(&table);
+  return root;
+}
+
+ExprNode* ParseExpression(const char* input, int* pos) {
+  return ParseExpressionArena(NULL, input, pos);
+}
+
+ExprNode* ParseExpressionFile(ExprArena* arena, const char* path) {
+  ExprTable table;
+  ExprTableInit(&table);
+  ExprNode* root = NULL;
+  if (ExprTableParseFile(&table, path)) root = TableToTree(arena, &table);
+  ExprTableFree(&table);
+  return root;
 }
 
 // --- Lógica de Simplificação e Conversão ---
+// Cada passo aloca a árvore resultante na arena recebida e nunca libera a
+// entrada: a arena inteira é descartada no fim da conversão. Como a arena
+// compartilha subexpressões iguais, a entrada é um DAG; Visit memoiza o
+// resultado por id de nó para que cada subexpressão seja reescrita uma vez.
 
-// Remove XOR e IMPLIES transformando em AND/OR/NOT básico
-ExprNode* NormalizeOperators(ExprNode* node) {
-  if (!node) return NULL;
+// PassContext e Visit estão em convert_internal.h
+
+// Profundidade máxima de Visit aninhadas. Ao passar dela a reescrita em
+// andamento é abandonada e o nó que faltava vai para uma pilha explícita
+// (ver VisitDeep), para que uma sentença muito profunda não estoure a
+// pilha de execução
+#define PASS_MAX_DEPTH 2048
+
+static void Defer(PassContext* ctx, ExprNode* node) {
+  if (ctx->num_deferred_ == ctx->deferred_cap_) {
+    ctx->deferred_cap_ = ctx->deferred_cap_ ? ctx->deferred_cap_ * 2 : 64;
+    ctx->deferred_ = (ExprNode**)realloc(
+        ctx->deferred_, sizeof(ExprNode*) * (size_t)ctx->deferred_cap_);
+  }
+  ctx->deferred_[ctx->num_deferred_++] = node;
+}
 
-  if (node->type_ == NODE_VAR) return CloneTree(node);
+// Com blocked_ ligado devolve NULL sem memoizar; as reescritas testam
+// blocked_ depois de cada Visit e desistem antes de criar nós
+ExprNode* Visit(PassContext* ctx, ExprNode* node) {
+  if (!node || node->type_ == NODE_VAR) return node;
+  if (ctx->blocked_) return NULL;
+  ExprNode* done = ExprMemoGet(&ctx->memo_, node);
+  if (done) return done;
+  if (ctx->depth_ == PASS_MAX_DEPTH) {
+    Defer(ctx, node);
+    ctx->blocked_ = true;
+    return NULL;
+  }
+  ctx->depth_++;
+  if (STATS_ON() && ctx->depth_ > g_stats.max_depth_)
+    g_stats.max_depth_ = ctx->depth_;
+  ExprNode* result = ctx->rewrite_(ctx, node);
+  ctx->depth_--;
+  if (ctx->blocked_) return NULL;
+  ExprMemoSet(&ctx->memo_, node, result);
+  return result;
+}
+
+// Visit sem limite de profundidade: os nós adiados são reescritos da pilha,
+// do mais novo para o mais antigo, cada um a partir da profundidade 0, e a
+// reescrita abandonada é refeita depois. Refazê-la é barato: os filhos já
+// estão no memo e os nós que ela cria voltam iguais pela tabela única.
+ExprNode* VisitDeep(PassContext* ctx, ExprNode* node) {
+  Defer(ctx, node);
+  while (ctx->num_deferred_ > 0) {
+    ctx->blocked_ = false;
+    Visit(ctx, ctx->deferred_[ctx->num_deferred_ - 1]);
+    if (!ctx->blocked_) ctx->num_deferred_--;
+  }
+  return Visit(ctx, node);  // já no memo
+}
+
+void PassContextFree(PassContext* ctx) {
+  ExprMemoFree(&ctx->memo_);
+  free(ctx->deferred_);
+}
+
+static ExprNode* RunPass(ExprArena* arena, PassFn rewrite, ExprNode* node) {
+  PassContext ctx = {arena, {NULL, 0}, rewrite, 0, NULL, 0,
+                     NULL, 0, 0, false};
+  ExprNode* result = VisitDeep(&ctx, node);
+  PassContextFree(&ctx);
+  return result;
+}
+
+// Remove XOR e IMPLIES transformando em AND/OR/NOT básico
+static ExprNode* NormalizeNode(PassContext* ctx, ExprNode* node) {
+  ExprArena* arena = ctx->arena_;
 
   if (node->type_ == NODE_NOT) {
-    return CreateNode(NODE_NOT, NormalizeOperators(node->left_), NULL);
+    ExprNode* child = Visit(ctx, node->left_);
+    return ctx->blocked_ ? NULL : CreateNode(arena, NODE_NOT, child, NULL);
   }
 
-  ExprNode* l = NormalizeOperators(node->left_);
-  ExprNode* r = NormalizeOperators(node->right_);
+  ExprNode* l = Visit(ctx, node->left_);
+  ExprNode* r = Visit(ctx, node->right_);
+  if (ctx->blocked_) return NULL;
 
   if (node->type_ == NODE_IMPLIES) {
     // A > B  ===  nA v B
-    return CreateNode(NODE_OR, CreateNode(NODE_NOT, l, NULL), r);
+    return CreateNode(arena, NODE_OR, CreateNode(arena, NODE_NOT, l, NULL), r);
   }
 
   if (node->type_ == NODE_XOR) {
     // A x B === (A a nB) v (nA a B) -- usando OR para DNF
-    ExprNode* not_l = CreateNode(NODE_NOT, CloneTree(l), NULL);
-    ExprNode* not_r = CreateNode(NODE_NOT, CloneTree(r), NULL);
-    ExprNode* term1 = CreateNode(NODE_AND, l, not_r);
-    ExprNode* term2 = CreateNode(NODE_AND, not_l, r);
-    return CreateNode(NODE_OR, term1, term2);
+    // l e r são compartilhados pelos dois termos (sem CloneTree)
+    ExprNode* not_l = CreateNode(arena, NODE_NOT, l, NULL);
+    ExprNode* not_r = CreateNode(arena, NODE_NOT, r, NULL);
+    ExprNode* term1 = CreateNode(arena, NODE_AND, l, not_r);
+    ExprNode* term2 = CreateNode(arena, NODE_AND, not_l, r);
+    return CreateNode(arena, NODE_OR, term1, term2);
   }
 
-  return CreateNode(node->type_, l, r);
+  return CreateNode(arena, node->type_, l, r);
+}
+
+ExprNode* NormalizeOperators(ExprArena* arena, ExprNode* node) {
+  return RunPass(arena, NormalizeNode, node);
 }
 
 // Move Negações para as folhas (NNF)
-ExprNode* PushNegations(ExprNode* node) {
-  if (!node) return NULL;
+static ExprNode* PushNegationsNode(PassContext* ctx, ExprNode* node) {
+  ExprArena* arena = ctx->arena_;
 
   if (node->type_ == NODE_NOT) {
     ExprNode* child = node->left_;
     if (child->type_ == NODE_NOT) {  // n(n(A)) -> A
-      ExprNode* res = PushNegations(child->left_);
-      return res;
+      return Visit(ctx, child->left_);
     }
     if (child->type_ == NODE_AND) {  // n(A a B) -> nA v nB
-      ExprNode* nA = CreateNode(NODE_NOT, child->left_, NULL);
-      ExprNode* nB = CreateNode(NODE_NOT, child->right_, NULL);
-      ExprNode* res = CreateNode(NODE_OR, nA, nB);
-      ExprNode* final = PushNegations(res);
-      FreeExprTree(
-          res);  // Limpar intermediário se necessário, mas aqui simplificamos
-      return final;
+      ExprNode* nA = CreateNode(arena, NODE_NOT, child->left_, NULL);
+      ExprNode* nB = CreateNode(arena, NODE_NOT, child->right_, NULL);
+      ExprNode* l = Visit(ctx, nA);
+      ExprNode* r = Visit(ctx, nB);
+      return ctx->blocked_ ? NULL : CreateNode(arena, NODE_OR, l, r);
     }
     if (child->type_ == NODE_OR) {  // n(A v B) -> nA a nB
-      ExprNode* nA = CreateNode(NODE_NOT, child->left_, NULL);
-      ExprNode* nB = CreateNode(NODE_NOT, child->right_, NULL);
-      ExprNode* res = CreateNode(NODE_AND, nA, nB);
-      ExprNode* final = PushNegations(res);
-      return final;
+      ExprNode* nA = CreateNode(arena, NODE_NOT, child->left_, NULL);
+      ExprNode* nB = CreateNode(arena, NODE_NOT, child->right_, NULL);
+      ExprNode* l = Visit(ctx, nA);
+      ExprNode* r = Visit(ctx, nB);
+      return ctx->blocked_ ? NULL : CreateNode(arena, NODE_AND, l, r);
     }
     // Se for Var, mantém nA
-    if (child->type_ == NODE_VAR) {
-      return CreateNode(NODE_NOT, CloneTree(child), NULL);
-    }
+    return node;
   }
 
-  if (node->type_ == NODE_VAR) return CloneTree(node);
+  ExprNode* l = Visit(ctx, node->left_);
+  ExprNode* r = Visit(ctx, node->right_);
+  return ctx->blocked_ ? NULL : CreateNode(arena, node->type_, l, r);
+}
 
-  return CreateNode(node->type_, PushNegations(node->left_),
-                    PushNegations(node->right_));
+ExprNode* PushNegations(ExprArena* arena, ExprNode* node) {
+  return RunPass(arena, PushNegationsNode, node);
 }
 
 // Distributiva para DNF: AND sobre OR -> A a (B v C) = (A a B) v (A a C)
-ExprNode* DistributeDNF(ExprNode* node) {
-  if (!node) return NULL;
-  if (node->type_ == NODE_VAR || node->type_ == NODE_NOT)
-    return CloneTree(node);
+static ExprNode* DistributeDNFNode(PassContext* ctx, ExprNode* node) {
+  ExprArena* arena = ctx->arena_;
+  if (node->type_ == NODE_NOT) return node;
 
-  ExprNode* l = DistributeDNF(node->left_);
-  ExprNode* r = DistributeDNF(node->right_);
+  ExprNode* l = Visit(ctx, node->left_);
+  ExprNode* r = Visit(ctx, node->right_);
+  if (ctx->blocked_) return NULL;
 
   if (node->type_ == NODE_AND) {
     if (l->type_ == NODE_OR) {
       // (P v Q) a R -> (P a R) v (Q a R)
-      ExprNode* P = l->left_;
-      ExprNode* Q = l->right_;
-      ExprNode* R = r;
-      ExprNode* t1 = CreateNode(NODE_AND, CloneTree(P), CloneTree(R));
-      ExprNode* t2 = CreateNode(NODE_AND, CloneTree(Q), CloneTree(R));
-      FreeExprTree(l);
-      FreeExprTree(r);
-      return DistributeDNF(CreateNode(NODE_OR, t1, t2));
+      STAT_ADD(distribute_rewrites_, 1);
+      ExprNode* t1 = CreateNode(arena, NODE_AND, l->left_, r);
+      ExprNode* t2 = CreateNode(arena, NODE_AND, l->right_, r);
+      return Visit(ctx, CreateNode(arena, NODE_OR, t1, t2));
     }
     if (r->type_ == NODE_OR) {
       // L a (P v Q) -> (L a P) v (L a Q)
-      ExprNode* L = l;
-      ExprNode* P = r->left_;
-      ExprNode* Q = r->right_;
-      ExprNode* t1 = CreateNode(NODE_AND, CloneTree(L), CloneTree(P));
-      ExprNode* t2 = CreateNode(NODE_AND, CloneTree(L), CloneTree(Q));
-      FreeExprTree(l);
-      FreeExprTree(r);
-      return DistributeDNF(CreateNode(NODE_OR, t1, t2));
+      STAT_ADD(distribute_rewrites_, 1);
+      ExprNode* t1 = CreateNode(arena, NODE_AND, l, r->left_);
+      ExprNode* t2 = CreateNode(arena, NODE_AND, l, r->right_);
+      return Visit(ctx, CreateNode(arena, NODE_OR, t1, t2));
     }
   }
-  return CreateNode(node->type_, l, r);
+  return CreateNode(arena, node->type_, l, r);
+}
+
+ExprNode* DistributeDNF(ExprArena* arena, ExprNode* node) {
+  return RunPass(arena, DistributeDNFNode, node);
 }
 
 // Distributiva para CNF: OR sobre AND -> A v (B a C) = (A v B) a (A v C)
-ExprNode* DistributeCNF(ExprNode* node) {
-  if (!node) return NULL;
-  if (node->type_ == NODE_VAR || node->type_ == NODE_NOT)
-    return CloneTree(node);
+static ExprNode* DistributeCNFNode(PassContext* ctx, ExprNode* node) {
+  ExprArena* arena = ctx->arena_;
+  if (node->type_ == NODE_NOT) return node;
 
-  ExprNode* l = DistributeCNF(node->left_);
-  ExprNode* r = DistributeCNF(node->right_);
+  ExprNode* l = Visit(ctx, node->left_);
+  ExprNode* r = Visit(ctx, node->right_);
+  if (ctx->blocked_) return NULL;
 
   if (node->type_ == NODE_OR) {
     if (l->type_ == NODE_AND) {
-      ExprNode* P = l->left_;
-      ExprNode* Q = l->right_;
-      ExprNode* R = r;
-      ExprNode* t1 = CreateNode(NODE_OR, CloneTree(P), CloneTree(R));
-      ExprNode* t2 = CreateNode(NODE_OR, CloneTree(Q), CloneTree(R));
-      FreeExprTree(l);
-      FreeExprTree(r);
-      return DistributeCNF(CreateNode(NODE_AND, t1, t2));
+      STAT_ADD(distribute_rewrites_, 1);
+      ExprNode* t1 = CreateNode(arena, NODE_OR, l->left_, r);
+      ExprNode* t2 = CreateNode(arena, NODE_OR, l->right_, r);
+      return Visit(ctx, CreateNode(arena, NODE_AND, t1, t2));
     }
     if (r->type_ == NODE_AND) {
-      ExprNode* L = l;
-      ExprNode* P = r->left_;
-      ExprNode* Q = r->right_;
-      ExprNode* t1 = CreateNode(NODE_OR, CloneTree(L), CloneTree(P));
-      ExprNode* t2 = CreateNode(NODE_OR, CloneTree(L), CloneTree(Q));
-      FreeExprTree(l);
-      FreeExprTree(r);
-      return DistributeCNF(CreateNode(NODE_AND, t1, t2));
+      STAT_ADD(distribute_rewrites_, 1);
+      ExprNode* t1 = CreateNode(arena, NODE_OR, l, r->left_);
+      ExprNode* t2 = CreateNode(arena, NODE_OR, l, r->right_);
+      return Visit(ctx, CreateNode(arena, NODE_AND, t1, t2));
     }
   }
-  return CreateNode(node->type_, l, r);
+  return CreateNode(arena, node->type_, l, r);
+}
+
+ExprNode* DistributeCNF(ExprArena* arena, ExprNode* node) {
+  return RunPass(arena, DistributeCNFNode, node);
 }
 
 // --- Funções de Avaliação (Tabela Verdade) ---
+// Avaliação de uma atribuição por vez; serve de oráculo para o avaliador
+// bit-paralelo (bit_eval.c), que é o usado nas verificações exaustivas
 
+// Mesma pós-ordem de CloneRec, com os valores dos filhos numa pilha
 bool EvaluateTree(ExprNode* node, int vars_mask) {
-  if (node->type_ == NODE_VAR) {
-    return (vars_mask >> (node->variable_ - 1)) & 1;
+  TreeFrame* frames = NULL;
+  bool* values = NULL;
+  int num_frames = 0, frames_cap = 0, num_values = 0, values_cap = 0;
+  PushFrame(&frames, &num_frames, &frames_cap, node, false);
+  while (num_frames > 0) {
+    TreeFrame frame = frames[--num_frames];
+    ExprNode* n = frame.node_;
+    bool value;
+    if (n->type_ == NODE_VAR) {
+      STAT_ADD(evaluate_calls_, 1);
+      value = (vars_mask >> (n->variable_ - 1)) & 1;
+    } else if (!frame.expanded_) {
+      PushFrame(&frames, &num_frames, &frames_cap, n, true);
+      if (n->type_ != NODE_NOT)
+        PushFrame(&frames, &num_frames, &frames_cap, n->right_, false);
+      PushFrame(&frames, &num_frames, &frames_cap, n->left_, false);
+      continue;
+    } else {
+      STAT_ADD(evaluate_calls_, 1);
+      bool r = n->type_ != NODE_NOT && values[--num_values];
+      bool l = values[--num_values];
+      if (n->type_ == NODE_NOT) value = !l;
+      else if (n->type_ == NODE_AND) value = l && r;
+      else if (n->type_ == NODE_OR) value = l || r;
+      else if (n->type_ == NODE_XOR) value = l != r;
+      else if (n->type_ == NODE_IMPLIES) value = !l || r;
+      else value = false;
+    }
+    if (num_values == values_cap) {
+      values_cap = values_cap ? values_cap * 2 : 64;
+      values = (bool*)realloc(values, sizeof(bool) * (size_t)values_cap);
+    }
+    values[num_values++] = value;
   }
-  if (node->type_ == NODE_NOT) return !EvaluateTree(node->left_, vars_mask);
+  bool result = values[0];
+  free(frames);
+  free(values);
+  return result;
+}
 
-  bool l = EvaluateTree(node->left_, vars_mask);
-  bool r = EvaluateTree(node->right_, vars_mask);
+// --- Implementação das Funções Públicas ---
 
-  if (node->type_ == NODE_AND) return l && r;
-  if (node->type_ == NODE_OR) return l || r;
-  if (node->type_ == NODE_XOR) return l != r;
-  if (node->type_ == NODE_IMPLIES) return !l || r;
-  return false;
+// --- Texto ---
+// TextBuffer está em convert_internal.h
+
+void FlushText(TextBuffer* buf) {
+  if (!buf->out_ || buf->size_ == 0) return;
+  fwrite(buf->data_, 1, buf->size_, buf->out_);
+  buf->size_ = 0;
+  buf->data_[0] = '\0';
 }
 
-// --- Implementação das Funções Públicas ---
+void AppendText(TextBuffer* buf, const char* text, size_t len) {
+  if (buf->out_ && buf->size_ + len >= TEXT_FLUSH_BYTES) FlushText(buf);
+  if (buf->size_ + len + 1 > buf->cap_) {
+    while (buf->size_ + len + 1 > buf->cap_) buf->cap_ *= 2;
+    buf->data_ = (char*)realloc(buf->data_, buf->cap_);
+  }
+  memcpy(buf->data_ + buf->size_, text, len);
+  buf->size_ += len;
+  buf->data_[buf->size_] = '\0';
+}
+
+// Árvore como "(l a r)", "n3", ... sem recursão: a pilha guarda nós e os
+// trechos de texto entre eles
+static void AppendTree(TextBuffer* buf, const ExprNode* root) {
+  typedef struct {
+    const ExprNode* node_;
+    const char* text_;  // se node_ for NULL
+  } TreeItem;
+  TreeItem* stack = NULL;
+  int size = 0, cap = 0;
+  char var_text[32];
+
+#define PUSH(n, t)                                                  \
+  do {                                                              \
+    if (size == cap) {                                              \
+      cap = cap ? cap * 2 : 64;                                     \
+      stack = (TreeItem*)realloc(stack, sizeof(TreeItem) * cap);    \
+    }                                                               \
+    stack[size].node_ = (n);                                        \
+    stack[size++].text_ = (t);                                      \
+  } while (0)
+
+  if (root) PUSH(root, NULL);
+  while (size > 0) {
+    TreeItem item = stack[--size];
+    const ExprNode* node = item.node_;
+    if (!node) {
+      AppendText(buf, item.text_, strlen(item.text_));
+      continue;
+    }
+    if (node->type_ == NODE_VAR || node->type_ == NODE_NOT) {
+      int len = node->type_ == NODE_VAR
+                    ? sprintf(var_text, "%d", node->variable_)
+                    : sprintf(var_text, "n%d", node->left_->variable_);
+      AppendText(buf, var_text, len);
+      continue;
+    }
+    const char* op = " ? ";
+    switch (node->type_) {
+      case NODE_AND:
+        op = " a ";
+        break;
+      case NODE_OR:
+        op = " v ";
+        break;
+      case NODE_XOR:
+        op = " x ";
+        break;
+      case NODE_IMPLIES:
+        op = " > ";
+        break;
+      default:
+        break;
+    }
+    PUSH(NULL, ")");
+    if (node->right_) PUSH(node->right_, NULL);
+    PUSH(NULL, op);
+    if (node->left_) PUSH(node->left_, NULL);
+    PUSH(NULL, "(");
+  }
+#undef PUSH
+
+  free(stack);
+}
+
+// Serializa termos como "(l1 v l2) a (l3) a ..." (CNF) ou
+// "(l1 a l2) v (l3) v ..." (DNF); names[v] é o número original da variável
+// v. Fórmulas constantes saem como "(x v nx)" ou "(x a nx)".
+static char* TermsToString(const ClauseSet* terms, const int* names,
+                           int num_names, bool cnf) {
+  TextBuffer buf = {(char*)malloc(256), 0, 256, NULL};
+  buf.data_[0] = '\0';
+  char lit_text[32];
+
+  // Sem termos: CNF verdadeira, DNF falsa. Termo vazio: o contrário.
+  int constant = terms->num_clauses_ == 0 ? (cnf ? 1 : 0) : -1;
+  for (int i = 0; i < terms->num_clauses_ && constant < 0; i++)
+    if (ClauseSetSize(terms, i) == 0) constant = cnf ? 0 : 1;
+  if (constant >= 0) {
+    int x = num_names > 0 ? names[1] : 1;
+    int len = sprintf(lit_text, "(%d %c n%d)", x, constant ? 'v' : 'a', x);
+    AppendText(&buf, lit_text, len);
+    return buf.data_;
+  }
 
-char* ConvertToDNF(const char* input) {
+  const char* outer = cnf ? " a " : " v ";
+  const char* inner = cnf ? " v " : " a ";
+  for (int i = 0; i < terms->num_clauses_; i++) {
+    if (i > 0) AppendText(&buf, outer, 3);
+    const int* lits = ClauseSetClause(terms, i);
+    int size = ClauseSetSize(terms, i);
+    if (size > 1) AppendText(&buf, "(", 1);
+    for (int j = 0; j < size; j++) {
+      int len = sprintf(lit_text, "%s%s%d", j > 0 ? inner : "",
+                        lits[j] < 0 ? "n" : "", names[abs(lits[j])]);
+      AppendText(&buf, lit_text, len);
+    }
+    if (size > 1) AppendText(&buf, ")", 1);
+  }
+  return buf.data_;
+}
+
+bool NormalFormTerms(ExprArena* arena, ExprNode** root, bool cnf,
+                     MinimizeLevel level, VarMap* vars, ClauseSet* terms) {
+  ExprNode* t = *root;
+  PhaseMark mark = PhaseBegin(arena);
+  t = NormalizeOperators(arena, t);
+  PhaseEnd(PHASE_NORMALIZE, mark, arena);
+  mark = PhaseBegin(arena);
+  t = PushNegations(arena, t);
+  PhaseEnd(PHASE_PUSH_NEGATIONS, mark, arena);
+  mark = PhaseBegin(arena);
+  t = PropagateLiterals(arena, t);
+  PhaseEnd(PHASE_PREPROCESS, mark, arena);
+  // Os termos da DNF saem direto da NNF (CubeEnum), sem a árvore
+  // distribuída; a CNF e a saída sem simplificação ainda passam por ela
+  bool cubes = !cnf && level != MINIMIZE_NONE;
+  if (!cubes) {
+    mark = PhaseBegin(arena);
+    t = cnf ? DistributeCNF(arena, t) : DistributeDNF(arena, t);
+    PhaseEnd(PHASE_DISTRIBUTE, mark, arena);
+  }
+  *root = t;
+  if (level == MINIMIZE_NONE) return false;
+
+  bool ok = true;
+  if (cubes) {
+    mark = PhaseBegin(NULL);
+    ok = CollectDnfCubes(t, vars, terms);
+    PhaseEnd(PHASE_DISTRIBUTE, mark, NULL);
+  }
+  mark = PhaseBegin(NULL);
+  if (!cubes) ok = CoverFromTree(t, cnf ? NODE_AND : NODE_OR, vars, terms);
+  if (ok) {
+    if (level == MINIMIZE_TWO_LEVEL)
+      CoverMinimize(terms, cnf);
+    else
+      CoverRemoveSubsumed(terms);
+  }
+  PhaseEnd(PHASE_SIMPLIFY, mark, NULL);
+  return ok;
+}
+
+char* ConvertToNormalForm(const char* input, bool cnf, MinimizeLevel level) {
+  ExprArena arena;
+  ExprArenaInit(&arena);
   int pos = 0;
-  ExprNode* root = ParseExpression(input, &pos);
-  if (!root) return NULL;
+  PhaseMark mark = PhaseBegin(&arena);
+  ExprNode* root = ParseExpressionArena(&arena, input, &pos);
+  PhaseEnd(PHASE_PARSE, mark, &arena);
+  if (!root) {
+    ReleaseArena(&arena);
+    return NULL;
+  }
 
-  root = NormalizeOperators(root);
-  root = PushNegations(root);
-  root = DistributeDNF(root);
+  char* result = NULL;
+  VarMap vars;
+  ClauseSet terms;
+  VarMapInit(&vars);
+  ClauseSetInit(&terms);
+  if (NormalFormTerms(&arena, &root, cnf, level, &vars, &terms)) {
+    mark = PhaseBegin(NULL);
+    result = TermsToString(&terms, vars.originals_, vars.count_, cnf);
+    PhaseEnd(PHASE_TO_STRING, mark, NULL);
+  }
+  ClauseSetFree(&terms);
+  VarMapFree(&vars);
+  if (!result) {
+    mark = PhaseBegin(NULL);
+    TextBuffer buf = {(char*)malloc(256), 0, 256, NULL};
+    buf.data_[0] = '\0';
+    AppendTree(&buf, root);
+    result = buf.data_;
+    PhaseEnd(PHASE_TO_STRING, mark, NULL);
+  }
+  STAT_ADD(output_bytes_, (long long)strlen(result));
+  ReleaseArena(&arena);
+  return result;
+}
+
+// Cláusulas da codificação, com as auxiliares numeradas após a maior
+// variável da entrada
+static char* EncodingToString(const CnfEncoding* enc) {
+  int max_var = 0;
+  for (int i = 1; i <= enc->num_inputs_; i++)
+    if (enc->vars_.originals_[i] > max_var) max_var = enc->vars_.originals_[i];
 
-  char* buffer = (char*)malloc(4096);  // Buffer grande
-  TreeToString(root, buffer, 4096);
-  FreeExprTree(root);
-  return buffer;
+  int* names = (int*)malloc(sizeof(int) * (enc->num_vars_ + 1));
+  for (int v = 1; v <= enc->num_vars_; v++)
+    names[v] = v <= enc->num_inputs_ ? enc->vars_.originals_[v]
+                                     : max_var + (v - enc->num_inputs_);
+  char* text = TermsToString(&enc->cnf_, names, enc->num_vars_, true);
+  free(names);
+  return text;
 }
 
-char* ConvertToCNF(const char* input) {
+// CNF equisatisfatível (Tseitin ou Plaisted-Greenbaum) em texto
+char* ConvertToEncodedCNF(const char* input, CnfMode mode) {
+  ExprArena arena;
+  ExprArenaInit(&arena);
   int pos = 0;
-  ExprNode* root = ParseExpression(input, &pos);
-  if (!root) return NULL;
+  PhaseMark mark = PhaseBegin(&arena);
+  ExprNode* root = ParseExpressionArena(&arena, input, &pos);
+  PhaseEnd(PHASE_PARSE, mark, &arena);
+  char* result = NULL;
+
+  if (root) {
+    // Codificação linear: uma variável auxiliar por porta
+    CnfEncoding enc;
+    mark = PhaseBegin(NULL);
+    bool ok = mode == CNF_TSEITIN ? EncodeTseitin(root, &enc)
+                                  : EncodePlaistedGreenbaum(root, &enc);
+    PhaseEnd(PHASE_ENCODE, mark, NULL);
+    if (ok) {
+      mark = PhaseBegin(NULL);
+      result = EncodingToString(&enc);
+      PhaseEnd(PHASE_TO_STRING, mark, NULL);
+      STAT_ADD(output_bytes_, (long long)strlen(result));
+    }
+    CnfEncodingFree(&enc);
+  }
+  ReleaseArena(&arena);
+  return result;
+}
+
+// --- Resolvedor ---
 
-  root = NormalizeOperators(root);
-  root = PushNegations(root);
-  root = DistributeCNF(root);  // Diferença chave aqui
+// Instâncias fáceis não pagam a simplificação: o CDCL tenta primeiro com
+// até PREPROCESS_AFTER_CONFLICTS conflitos. Se não bastar, a CNF passa
+// pelo pré-processamento (preprocess.h) e vai para um resolvedor novo, e o
+// modelo volta para as variáveis da entrada pela pilha de reconstrução.
+bool SatByCdcl(CnfEncoding* enc, bool* values) {
+  int num_vars = enc->num_vars_ > enc->cnf_.num_vars_ ? enc->num_vars_
+                                                      : enc->cnf_.num_vars_;
+  PhaseMark mark = PhaseBegin(NULL);
+  SatSolver* solver = SatSolverCreate();
+  SatSolverSetConflictLimit(solver, PREPROCESS_AFTER_CONFLICTS);
+  SatResult result = SatSolverAddClauseSet(solver, &enc->cnf_)
+                         ? SatSolverSolve(solver)
+                         : SAT_UNSATISFIABLE;
+  PhaseEnd(PHASE_SOLVE, mark, NULL);
 
-  char* buffer = (char*)malloc(4096);
-  TreeToString(root, buffer, 4096);
-  FreeExprTree(root);
-  return buffer;
+  CnfReconstruction rec;
+  bool preprocessed = result == SAT_UNKNOWN, simplified = false;
+  if (preprocessed) {
+    int num_clauses = enc->cnf_.num_clauses_;
+    mark = PhaseBegin(NULL);
+    bool sat = PreprocessClauses(&enc->cnf_, num_vars, &rec);
+    PhaseEnd(PHASE_PREPROCESS, mark, NULL);
+    STAT_ADD(removed_vars_, rec.removed_vars_);
+    STAT_ADD(removed_clauses_, num_clauses - enc->cnf_.num_clauses_);
+
+    // Com pouco ganho o primeiro resolvedor, que ainda tem a CNF original
+    // e o que aprendeu, continua de onde parou
+    mark = PhaseBegin(NULL);
+    long long removed = num_clauses - enc->cnf_.num_clauses_;
+    simplified = !sat || removed * 100 >= (long long)num_clauses *
+                                              PREPROCESS_MIN_REMOVED_PERCENT;
+    if (sat && simplified) {
+      SatSolverDestroy(solver);
+      solver = SatSolverCreate();
+      sat = SatSolverAddClauseSet(solver, &enc->cnf_);
+    }
+    SatSolverSetConflictLimit(solver, -1);
+    result = sat ? SatSolverSolve(solver) : SAT_UNSATISFIABLE;
+    PhaseEnd(PHASE_SOLVE, mark, NULL);
+  }
+
+  if (result == SAT_SATISFIABLE) {
+    bool* model = (bool*)calloc(num_vars + 1, sizeof(bool));
+    for (int v = 1; v <= num_vars; v++)
+      model[v] = SatSolverModelValue(solver, v);
+    if (simplified) CnfReconstructModel(&rec, model);
+    for (int i = 1; i <= enc->num_inputs_; i++)
+      values[enc->vars_.originals_[i]] = model[i];
+    free(model);
+  }
+  SatSolverDestroy(solver);
+  if (preprocessed) CnfReconstructionFree(&rec);
+  return result == SAT_SATISFIABLE;
 }
 
-bool AreEquivalent(const char* input1, const char* input2) {
-  int pos1 = 0, pos2 = 0;
-  ExprNode* t1 = ParseExpression(input1, &pos1);
-  ExprNode* t2 = ParseExpression(input2, &pos2);
+// --- Restrições XOR ---
+// x é associativo e comutativo e A x A = 0, então uma cadeia de x se
+// reduz às folhas que aparecem um número ímpar de vezes; cadeias no topo
+// de uma sentença formam um sistema linear sobre GF(2) (xor_system.h).
+
+static int CompareNodeIds(const void* a, const void* b) {
+  int x = (*(const ExprNode* const*)a)->id_;
+  int y = (*(const ExprNode* const*)b)->id_;
+  return (x > y) - (x < y);
+}
+
+// Cadeias de t1 e t2 sem as folhas que se cancelam (na arena, folhas
+// iguais são o mesmo nó), repetidas no mesmo lado ou comuns aos dois:
+// t1 x t2 = sides[0] x sides[1] x *parity, com NULL no lugar de um lado
+// vazio. *all_vars indica se só sobraram variáveis.
+static void ReduceXorSides(ExprArena* arena, const ExprNode* t1,
+                           const ExprNode* t2, ExprNode** sides,
+                           bool* parity, bool* all_vars) {
+  const ExprNode* roots[2] = {t1, t2};
+  const ExprNode** leaves[2] = {NULL, NULL};
+  int size[2] = {0, 0}, cap[2] = {0, 0};
+  bool side_parity[2];
+  for (int s = 0; s < 2; s++) {
+    if (!XorChainLeaves(roots[s], &leaves[s], &size[s], &cap[s],
+                        &side_parity[s]))
+      size[s] = 0;
+    qsort(leaves[s], size[s], sizeof(*leaves[s]), CompareNodeIds);
+    int kept = 0;
+    for (int i = 0; i < size[s]; i++) {
+      if (i + 1 < size[s] && leaves[s][i] == leaves[s][i + 1]) {
+        i++;
+        continue;
+      }
+      leaves[s][kept++] = leaves[s][i];
+    }
+    size[s] = kept;
+  }
+  *parity = side_parity[0] != side_parity[1];
+
+  // Intercala os dois lados em ordem de id, descartando as comuns
+  sides[0] = sides[1] = NULL;
+  *all_vars = true;
+  int i = 0, j = 0;
+  while (i < size[0] || j < size[1]) {
+    if (i < size[0] && j < size[1] && leaves[0][i] == leaves[1][j]) {
+      i++;
+      j++;
+      continue;
+    }
+    int s = j == size[1] ||
+                    (i < size[0] && leaves[0][i]->id_ < leaves[1][j]->id_)
+                ? 0
+                : 1;
+    ExprNode* leaf = (ExprNode*)(s == 0 ? leaves[0][i++] : leaves[1][j++]);
+    *all_vars = *all_vars && leaf->type_ == NODE_VAR;
+    sides[s] = sides[s] ? CreateNode(arena, NODE_XOR, sides[s], leaf) : leaf;
+  }
+  free(leaves[0]);
+  free(leaves[1]);
+}
+
+typedef struct {
+  const ExprNode* node_;
+  bool pos_;
+} ConjunctFrame;
 
-  // Verificar todas as combinações de 3 variáveis (000 a 111)
-  // O projeto assume variáveis 1, 2, 3? Vamos testar até 5 para segurança
-  for (int i = 0; i < 32; i++) {
-    if (EvaluateTree(t1, i) != EvaluateTree(t2, i)) {
-      FreeExprTree(t1);
-      FreeExprTree(t2);
-      return false;
+// Numera as variáveis de root na ordem da primeira ocorrência e retorna
+// a maior delas
+static int CollectVariables(const ExprNode* root, VarMap* vars) {
+  const ExprNode** stack = NULL;
+  int size = 0, cap = 0, max_var = 0;
+  const ExprNode* node = root;
+  for (;;) {
+    if (node->type_ == NODE_VAR) {
+      VarMapGet(vars, node->variable_);
+      if (node->variable_ > max_var) max_var = node->variable_;
+    } else {
+      if (node->type_ != NODE_NOT) {
+        if (size == cap) {
+          cap = cap ? cap * 2 : 64;
+          stack = (const ExprNode**)realloc(stack, sizeof(*stack) * cap);
+        }
+        stack[size++] = node->right_;
+      }
+      node = node->left_;
+      continue;
+    }
+    if (size == 0) break;
+    node = stack[--size];
+  }
+  free(stack);
+  return max_var;
+}
+
+// Parcelas do topo de t que são equações lineares (cadeias de x cujas
+// folhas são variáveis, incluindo literais isolados) vão para sys com a
+// numeração de vars. Retorna true se todas as parcelas forem equações.
+static bool CollectXorEquations(const ExprNode* t, const VarMap* vars,
+                                XorSystem* sys) {
+  ConjunctFrame* stack = NULL;
+  int size = 0, cap = 0;
+  const ExprNode** leaves = NULL;
+  int num_leaves = 0, leaves_cap = 0;
+  int* row = NULL;
+  int row_cap = 0;
+  bool only_xor = true;
+
+#define PUSH_CONJUNCT(n, p)                                                \
+  do {                                                                     \
+    if (size == cap) {                                                     \
+      cap = cap ? cap * 2 : 64;                                            \
+      stack = (ConjunctFrame*)realloc(stack, sizeof(*stack) * cap);        \
+    }                                                                      \
+    stack[size].node_ = (n);                                               \
+    stack[size].pos_ = (p);                                                \
+    size++;                                                                \
+  } while (0)
+
+  PUSH_CONJUNCT(t, true);
+  while (size > 0) {
+    ConjunctFrame f = stack[--size];
+    const ExprNode* node = f.node_;
+    if (node->type_ == NODE_NOT) {
+      PUSH_CONJUNCT(node->left_, !f.pos_);
+      continue;
+    }
+    if ((f.pos_ && node->type_ == NODE_AND) ||
+        (!f.pos_ && node->type_ == NODE_OR)) {
+      PUSH_CONJUNCT(node->right_, f.pos_);
+      PUSH_CONJUNCT(node->left_, f.pos_);
+      continue;
+    }
+    if (!f.pos_ && node->type_ == NODE_IMPLIES) {
+      PUSH_CONJUNCT(node->right_, false);
+      PUSH_CONJUNCT(node->left_, true);
+      continue;
+    }
+
+    bool parity;
+    bool linear = (node->type_ == NODE_XOR || node->type_ == NODE_VAR) &&
+                  XorChainLeaves(node, &leaves, &num_leaves, &leaves_cap,
+                                 &parity);
+    for (int i = 0; linear && i < num_leaves; i++)
+      linear = leaves[i]->type_ == NODE_VAR;
+    if (!linear) {
+      only_xor = false;
+      continue;
+    }
+    if (num_leaves > row_cap) {
+      row_cap = num_leaves;
+      row = (int*)realloc(row, sizeof(int) * row_cap);
+    }
+    for (int i = 0; i < num_leaves; i++)
+      row[i] = VarMapFind(vars, leaves[i]->variable_);
+    XorSystemAdd(sys, row, num_leaves, f.pos_ != parity);
+  }
+#undef PUSH_CONJUNCT
+
+  free(stack);
+  free(leaves);
+  free(row);
+  return only_xor;
+}
+
+// BDDs das verificações de equivalência: um gerenciador e uma numeração
+// de variáveis por thread, mantidos entre consultas, para que
+// subexpressões repetidas (o caso comum em verificações em lote)
+// reaproveitem a tabela única e o cache ITE. Nenhuma raiz fica
+// referenciada entre consultas; a coleta de lixo recupera o resto.
+typedef struct {
+  BddManager* mgr_;
+  VarMap vars_;  // variável original -> variável do BDD
+} EquivBdd;
+
+static THREAD_LOCAL EquivBdd g_equiv_bdd;
+
+void ConvertThreadRelease(void) {
+  if (!g_equiv_bdd.mgr_) return;
+  BddManagerDestroy(g_equiv_bdd.mgr_);
+  VarMapFree(&g_equiv_bdd.vars_);
+  g_equiv_bdd.mgr_ = NULL;
+}
+
+// Raiz referenciada de um lado do miter (NULL é a constante falsa)
+static BddRef SideBdd(EquivBdd* b, const ExprNode* side) {
+  BddRef r = side ? BddFromExpr(b->mgr_, side, &b->vars_) : BDD_FALSE;
+  BddIncRef(b->mgr_, r);
+  return r;
+}
+
+// A ordem das variáveis deve ser a que um gerenciador novo daria à
+// consulta (a da primeira ocorrência em vars), para que o histórico não
+// degrade os BDDs: as variáveis já conhecidas precisam vir na ordem
+// guardada e antes das novas, que entram no fim
+static bool EquivOrderMatches(const EquivBdd* b, const VarMap* vars) {
+  int last = 0;
+  bool unknown = false;
+  for (int i = 1; i <= vars->count_; i++) {
+    int index = VarMapFind(&b->vars_, vars->originals_[i]);
+    if (index == 0) {
+      unknown = true;
+    } else {
+      if (unknown || index < last) return false;
+      last = index;
     }
   }
-  FreeExprTree(t1);
-  FreeExprTree(t2);
   return true;
 }
 
-bool IsSatisfiable(const char* input) {
+// Compara as raízes dos dois lados (sides[0] == sides[1] x parity): se
+// diferirem, *differ = true e values recebe, nas variáveis de vars, uma
+// atribuição em que diferem. Retorna false se estourar o limite de nós.
+static bool CompareSideBdds(ExprNode* const* sides, bool parity,
+                            const VarMap* vars, bool* differ,
+                            bool* values) {
+  EquivBdd* b = &g_equiv_bdd;
+  // Recomeça se a ordem não servir ou se o que sobrou das consultas
+  // anteriores puder tomar o espaço desta
+  if (b->mgr_ && (!EquivOrderMatches(b, vars) ||
+                  BddGetStats(b->mgr_)->nodes_ > BDD_EQUIV_MAX_NODES / 2)) {
+    ConvertThreadRelease();
+  }
+  if (!b->mgr_) {
+    b->mgr_ = BddManagerCreate();
+    BddSetNodeLimit(b->mgr_, BDD_EQUIV_MAX_NODES);
+    VarMapInit(&b->vars_);
+  }
+
+  BddRef r1 = SideBdd(b, sides[0]);
+  BddRef r2 = r1 == BDD_INVALID ? BDD_INVALID : SideBdd(b, sides[1]);
+  if (parity && r2 != BDD_INVALID) {
+    BddRef not_r2 = BddNot(b->mgr_, r2);
+    BddIncRef(b->mgr_, not_r2);
+    BddDecRef(b->mgr_, r2);
+    r2 = not_r2;
+  }
+  bool ok = r1 != BDD_INVALID && r2 != BDD_INVALID;
+  *differ = r1 != r2;
+  if (ok && *differ) {
+    BddRef diff = BddXor(b->mgr_, r1, r2);
+    ok = diff != BDD_INVALID;
+    if (ok) {
+      bool* bdd_model = (bool*)calloc(BddNumVars(b->mgr_) + 1, sizeof(bool));
+      BddPickSat(b->mgr_, diff, bdd_model);
+      for (int i = 1; i <= vars->count_; i++) {
+        int original = vars->originals_[i];
+        values[original] = bdd_model[VarMapFind(&b->vars_, original)];
+      }
+      free(bdd_model);
+    }
+  }
+  BddDecRef(b->mgr_, r1);
+  BddDecRef(b->mgr_, r2);
+  return ok;
+}
+
+// Retorna true se o miter sides[0] x sides[1] x parity for satisfatível
+// (as sentenças diferem), com a atribuição em values (indexado pela
+// variável original)
+static bool SolveMiter(const ExprNode* miter, ExprNode* const* sides,
+                       bool parity, bool* values) {
+  BitProgram prog;
+  bool differ = false;
+  PhaseMark mark = PhaseBegin(NULL);
+  if (!BitProgramCompile(miter, &prog)) {
+    BitProgramFree(&prog);
+    PhaseEnd(PHASE_SOLVE, mark, NULL);
+    return false;
+  }
+  const VarMap* vars = &prog.vars_;
+  if (prog.num_vars_ <= EXHAUSTIVE_MAX_VARS) {
+    long long index = BitProgramFindAssignment(&prog, true);
+    differ = index >= 0;
+    for (int j = 0; differ && j < prog.num_vars_; j++)
+      values[vars->originals_[j + 1]] = (index >> j) & 1;
+    PhaseEnd(PHASE_SOLVE, mark, NULL);
+  } else if (CompareSideBdds(sides, parity, vars, &differ, values)) {
+    // BDDs canônicos: equivalentes se e somente se as raízes coincidem
+    PhaseEnd(PHASE_SOLVE, mark, NULL);
+  } else {
+    PhaseEnd(PHASE_SOLVE, mark, NULL);
+    CnfEncoding enc;
+    mark = PhaseBegin(NULL);
+    bool encoded = EncodePlaistedGreenbaum(miter, &enc);
+    PhaseEnd(PHASE_ENCODE, mark, NULL);
+    differ = encoded && SatByCdcl(&enc, values);
+    CnfEncodingFree(&enc);
+  }
+  BitProgramFree(&prog);
+  return differ;
+}
+
+// Retorna true se t1 e t2 forem equivalentes; senão *values recebe uma
+// atribuição em que diferem, indexada pela variável original
+static bool CompareTrees(ExprArena* arena, ExprNode* t1, ExprNode* t2,
+                         bool** values, int* size) {
+  *values = NULL;
+  *size = 0;
+  // Na mesma arena, árvores estruturalmente iguais são o mesmo nó
+  if (t1 == t2) return true;
+
+  // Equivalentes se e somente se (t1 x t2) for insatisfatível. As partes
+  // em comum de cadeias de x nos dois lados se cancelam antes.
+  ExprNode miter = {NODE_XOR, 0, t1, t2, 0};
+  VarMap vars;
+  VarMapInit(&vars);
+  *size = CollectVariables(&miter, &vars) + 1;
+  VarMapFree(&vars);
+  *values = (bool*)calloc(*size, sizeof(bool));
+
+  bool parity, all_vars;
+  ExprNode* sides[2];
+  PhaseMark mark = PhaseBegin(arena);
+  ReduceXorSides(arena, t1, t2, sides, &parity, &all_vars);
+  PhaseEnd(PHASE_PREPROCESS, mark, arena);
+  if (!sides[0] && !sides[1]) return !parity;
+  ExprNode* chain = !sides[0]   ? sides[1]
+                    : !sides[1] ? sides[0]
+                                : CreateNode(arena, NODE_XOR, sides[0],
+                                             sides[1]);
+  if (all_vars) {
+    // XOR de variáveis x parity: vale 1 com todas em false se parity = 1,
+    // senão basta ligar uma delas
+    ExprNode* leaf = chain;
+    while (leaf->type_ == NODE_XOR) leaf = leaf->left_;
+    if (!parity) (*values)[leaf->variable_] = true;
+    return false;
+  }
+  if (parity) chain = CreateNode(arena, NODE_NOT, chain, NULL);
+  return !SolveMiter(chain, sides, parity, *values);
+}
+
+bool CheckEquivalenceUncached(const char* input1, const char* input2,
+                              bool** counterexample, int* size) {
+  ExprArena arena;
+  ExprArenaInit(&arena);
+  int pos1 = 0, pos2 = 0;
+  PhaseMark mark = PhaseBegin(&arena);
+  ExprNode* t1 = ParseExpressionArena(&arena, input1, &pos1);
+  ExprNode* t2 = ParseExpressionArena(&arena, input2, &pos2);
+  PhaseEnd(PHASE_PARSE, mark, &arena);
+
+  if (!t1 || !t2) {
+    ReleaseArena(&arena);
+    if (counterexample) {
+      *counterexample = NULL;
+      *size = 0;
+    }
+    return false;
+  }
+
+  bool* values;
+  int values_size;
+  bool equivalent = CompareTrees(&arena, t1, t2, &values, &values_size);
+  ReleaseArena(&arena);
+
+  if (equivalent) {
+    free(values);
+    values = NULL;
+    values_size = 0;
+  }
+  if (counterexample) {
+    *counterexample = values;
+    *size = values_size;
+  } else {
+    free(values);
+  }
+  return equivalent;
+}
+
+// Varredura exaustiva para instâncias pequenas
+static bool SatByBitSweep(const ExprNode* t, bool* values) {
+  BitProgram prog;
+  bool sat = false;
+  if (BitProgramCompile(t, &prog)) {
+    long long index = BitProgramFindAssignment(&prog, true);
+    sat = index >= 0;
+    for (int j = 0; sat && j < prog.num_vars_; j++)
+      values[prog.vars_.originals_[j + 1]] = (index >> j) & 1;
+  }
+  BitProgramFree(&prog);
+  return sat;
+}
+
+// As equações lineares do topo passam antes pela eliminação de Gauss: um
+// sistema inconsistente dispensa o resolvedor, e uma sentença feita só de
+// equações já tem modelo. Senão as equações reduzidas curtas (unidades e
+// equivalências, por exemplo) reforçam a CNF entregue ao CDCL.
+static bool SatByXorAndCdcl(const ExprNode* t, CnfEncoding* enc,
+                            bool* values) {
+  XorSystem sys, reduced;
+  XorSystemInit(&sys);
+  PhaseMark mark = PhaseBegin(NULL);
+  bool only_xor = CollectXorEquations(t, &enc->vars_, &sys);
+  bool* solution = (bool*)malloc(sizeof(bool) * (sys.num_vars_ + 1));
+  XorStatus status = XorSystemSolve(&sys, &reduced, solution);
+  PhaseEnd(PHASE_SOLVE, mark, NULL);
+
+  bool sat = false;
+  if (status == XOR_CONSISTENT && only_xor) {
+    sat = true;
+    for (int i = 1; i <= sys.num_vars_; i++)
+      values[enc->vars_.originals_[i]] = solution[i];
+  } else if (status != XOR_INCONSISTENT) {
+    for (int i = 0; i < reduced.rows_.num_clauses_; i++) {
+      int size = ClauseSetSize(&reduced.rows_, i);
+      if (size <= XOR_CHUNK_SIZE)
+        XorEncodeClauses(ClauseSetClause(&reduced.rows_, i), size,
+                         reduced.rhs_[i], &enc->num_vars_, &enc->cnf_);
+    }
+    sat = SatByCdcl(enc, values);
+  }
+  free(solution);
+  XorSystemFree(&reduced);
+  XorSystemFree(&sys);
+  return sat;
+}
+
+// Instâncias pequenas vão para a varredura sem serem codificadas
+static bool SatisfyTree(const ExprNode* t, bool** model, int* model_size) {
+  bool sat = false;
+  VarMap vars;
+  VarMapInit(&vars);
+  int max_var = CollectVariables(t, &vars);
+  bool* values = (bool*)calloc(max_var + 1, sizeof(bool));
+
+  PhaseMark mark;
+  if (vars.count_ <= EXHAUSTIVE_MAX_VARS) {
+    mark = PhaseBegin(NULL);
+    sat = SatByBitSweep(t, values);
+    PhaseEnd(PHASE_SOLVE, mark, NULL);
+  } else {
+    CnfEncoding enc;
+    mark = PhaseBegin(NULL);
+    bool encoded = EncodePlaistedGreenbaum(t, &enc);
+    PhaseEnd(PHASE_ENCODE, mark, NULL);
+    if (encoded) sat = SatByXorAndCdcl(t, &enc, values);
+    CnfEncodingFree(&enc);
+  }
+  VarMapFree(&vars);
+
+  if (sat && model) {
+    *model = values;
+    *model_size = max_var + 1;
+  } else {
+    free(values);
+  }
+  return sat;
+}
+
+bool FindSatisfyingModelUncached(const char* input, bool** model,
+                                 int* model_size) {
+  ExprArena arena;
+  ExprArenaInit(&arena);
+  int pos = 0;
+  PhaseMark mark = PhaseBegin(&arena);
+  ExprNode* t = ParseExpressionArena(&arena, input, &pos);
+  PhaseEnd(PHASE_PARSE, mark, &arena);
+  bool sat = t && SatisfyTree(t, model, model_size);
+  ReleaseArena(&arena);
+  return sat;
+}
+
+bool FindSatisfyingModelFile(const char* path, bool** model,
+                             int* model_size) {
+  ExprArena arena;
+  ExprArenaInit(&arena);
+  PhaseMark mark = PhaseBegin(&arena);
+  ExprNode* t = ParseExpressionFile(&arena, path);
+  PhaseEnd(PHASE_PARSE, mark, &arena);
+  bool sat = t && SatisfyTree(t, model, model_size);
+  ReleaseArena(&arena);
+  return sat;
+}
+
+// --- Contagem e Enumeração de Modelos ---
+
+// Contagem de uma sentença feita só de equações lineares sobre as
+// variáveis de prog; false se houver outras parcelas
+static bool CountAffine(const ExprNode* t, const BitProgram* prog,
+                        BigNat* count) {
+  XorSystem sys, reduced;
+  XorSystemInit(&sys);
+  PhaseMark mark = PhaseBegin(NULL);
+  XorStatus status = XOR_TOO_LARGE;
+  if (CollectXorEquations(t, &prog->vars_, &sys)) {
+    status = XorSystemSolve(&sys, &reduced, NULL);
+    if (status == XOR_CONSISTENT) {
+      BigNatSetU64(count, 1);
+      BigNatShiftLeft(count, prog->num_vars_ - reduced.rows_.num_clauses_);
+    } else if (status == XOR_INCONSISTENT) {
+      BigNatSetU64(count, 0);
+    }
+    XorSystemFree(&reduced);
+  }
+  PhaseEnd(PHASE_SOLVE, mark, NULL);
+  XorSystemFree(&sys);
+  return status != XOR_TOO_LARGE;
+}
+
+char* CountModelsUncached(const char* input) {
+  ExprArena arena;
+  ExprArenaInit(&arena);
   int pos = 0;
-  ExprNode* t = ParseExpression(input, &pos);
+  PhaseMark mark = PhaseBegin(&arena);
+  ExprNode* t = ParseExpressionArena(&arena, input, &pos);
+  PhaseEnd(PHASE_PARSE, mark, &arena);
+  if (!t) {
+    ReleaseArena(&arena);
+    return NULL;
+  }
 
-  for (int i = 0; i < 32; i++) {
-    if (EvaluateTree(t, i) == true) {
-      FreeExprTree(t);
-      return true;
+  BigNat count;
+  BigNatInit(&count);
+  BitProgram prog;
+  bool counted = true;
+  bool compiled = BitProgramCompile(t, &prog);
+  bool small = compiled && prog.num_vars_ <= EXHAUSTIVE_MAX_VARS;
+  if (small) {
+    mark = PhaseBegin(NULL);
+    BigNatSetU64(&count, (uint64_t)BitProgramCountAssignments(&prog, true));
+    PhaseEnd(PHASE_SOLVE, mark, NULL);
+  } else if (compiled && CountAffine(t, &prog, &count)) {
+    // Só equações lineares: 2^(variáveis - posto) ou 0
+  } else {
+    // Tseitin completo: cada auxiliar é função das entradas, então os
+    // modelos da CNF correspondem um a um aos da sentença
+    CnfEncoding enc;
+    mark = PhaseBegin(NULL);
+    counted = EncodeTseitin(t, &enc);
+    PhaseEnd(PHASE_ENCODE, mark, NULL);
+    if (counted) {
+      mark = PhaseBegin(NULL);
+      ModelCountClauses(&enc.cnf_, enc.num_vars_, &count);
+      PhaseEnd(PHASE_SOLVE, mark, NULL);
     }
+    CnfEncodingFree(&enc);
   }
-  FreeExprTree(t);
-  return false;
+  BitProgramFree(&prog);
+  ReleaseArena(&arena);
+
+  // Sem codificação não há contagem: "0" seria uma resposta errada
+  char* text = counted ? BigNatToString(&count) : NULL;
+  BigNatFree(&count);
+  return text;
 }
 
 int TreeToString(ExprNode* node, char* buffer, int size) {
-  if (!node) return 0;
-
-  if (node->type_ == NODE_VAR) {
-    return sprintf(buffer, "%d", node->variable_);
+  TextBuffer buf = {(char*)malloc(256), 0, 256, NULL};
+  buf.data_[0] = '\0';
+  AppendTree(&buf, node);
+  if (size > 0) {
+    size_t n = buf.size_ < (size_t)size ? buf.size_ : (size_t)size - 1;
+    memcpy(buffer, buf.data_, n);
+    buffer[n] = '\0';
   }
-  if (node->type_ == NODE_NOT) {
-    return sprintf(buffer, "n%d", node->left_->variable_);  // Simplificado
-  }
-
-  char op = '?';
-  switch (node->type_) {
-    case NODE_AND:
-      op = 'a';
-      break;
-    case NODE_OR:
-      op = 'v';
-      break;
-    case NODE_XOR:
-      op = 'x';
-      break;
-    case NODE_IMPLIES:
-      op = '>';
-      break;
-    default:
-      break;
-  }
-
-  int w = sprintf(buffer, "(");
-  w += TreeToString(node->left_, buffer + w, size - w);
-  w += sprintf(buffer + w, " %c ", op);
-  w += TreeToString(node->right_, buffer + w, size - w);
-  w += sprintf(buffer + w, ")");
-  return w;
+  int len = (int)buf.size_;
+  free(buf.data_);
+  return len;
 }
\ No newline at end of file
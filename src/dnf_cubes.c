@@ -0,0 +1,284 @@
+#include "../include/dnf_cubes.h"
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "../include/convert_internal.h"
+#include "../include/cover.h"
+#include "../include/expr_arena.h"
+
+// Os cubos de uma NNF são o produto, em profundidade, dos ramos dos v. A
+// lista de nós ainda por conjugar é imutável (células encadeadas numa
+// pilha, cada uma apontando para uma mais antiga), então um ponto de
+// escolha guarda só a lista depois do v, o ramo direito e os tamanhos das
+// pilhas, e voltar a ele é cortá-las. A memória cresce com a sentença, não
+// com o número de cubos.
+
+typedef struct {
+  const ExprNode* node_;
+  int next_;  // célula seguinte; -1 no fim da lista
+} PendingCell;
+
+typedef struct {
+  const ExprNode* right_;  // ramo ainda não visitado
+  int rest_;               // lista depois do v
+  int num_cells_;
+  int num_lits_;
+} CubeChoice;
+
+typedef struct {
+  PendingCell* cells_;
+  int num_cells_;
+  int cells_cap_;
+  CubeChoice* choices_;
+  int num_choices_;
+  int choices_cap_;
+  int head_;            // lista do cubo atual
+  int* lits_;           // cubo atual (+v / -v, variáveis originais)
+  int num_lits_;
+  int lits_cap_;
+  signed char* value_;  // por variável: 1, -1 ou 0
+  int value_cap_;
+  bool started_;
+  bool valid_;  // false se apareceu um nó fora da NNF
+} CubeEnum;
+
+static int PushCell(CubeEnum* e, const ExprNode* node, int next) {
+  if (e->num_cells_ == e->cells_cap_) {
+    e->cells_cap_ = e->cells_cap_ ? e->cells_cap_ * 2 : 64;
+    e->cells_ = (PendingCell*)realloc(e->cells_,
+                                      sizeof(PendingCell) * e->cells_cap_);
+  }
+  e->cells_[e->num_cells_].node_ = node;
+  e->cells_[e->num_cells_].next_ = next;
+  return e->num_cells_++;
+}
+
+static void CubeEnumInit(CubeEnum* e, const ExprNode* root) {
+  memset(e, 0, sizeof(*e));
+  e->valid_ = true;
+  e->head_ = PushCell(e, root, -1);
+}
+
+static void CubeEnumFree(CubeEnum* e) {
+  free(e->cells_);
+  free(e->choices_);
+  free(e->lits_);
+  free(e->value_);
+}
+
+// Volta ao último v com o ramo direito pendente; false se não houver
+static bool CubeEnumBacktrack(CubeEnum* e) {
+  if (e->num_choices_ == 0) return false;
+  CubeChoice* choice = &e->choices_[--e->num_choices_];
+  while (e->num_lits_ > choice->num_lits_)
+    e->value_[abs(e->lits_[--e->num_lits_])] = 0;
+  e->num_cells_ = choice->num_cells_;
+  e->head_ = PushCell(e, choice->right_, choice->rest_);
+  return true;
+}
+
+// Fixa o literal lit no cubo atual; false se nlit já estiver nele
+static bool CubeEnumAssign(CubeEnum* e, int lit) {
+  int v = abs(lit);
+  if (v >= e->value_cap_) {
+    int cap = e->value_cap_ ? e->value_cap_ : 64;
+    while (cap <= v) cap *= 2;
+    e->value_ = (signed char*)realloc(e->value_, cap);
+    memset(e->value_ + e->value_cap_, 0, cap - e->value_cap_);
+    e->value_cap_ = cap;
+  }
+  signed char sign = lit > 0 ? 1 : -1;
+  if (e->value_[v] == sign) return true;
+  if (e->value_[v] == -sign) return false;
+  e->value_[v] = sign;
+  if (e->num_lits_ == e->lits_cap_) {
+    e->lits_cap_ = e->lits_cap_ ? e->lits_cap_ * 2 : 16;
+    e->lits_ = (int*)realloc(e->lits_, sizeof(int) * e->lits_cap_);
+  }
+  e->lits_[e->num_lits_++] = lit;
+  return true;
+}
+
+// Próximo cubo em e->lits_; os caminhos que juntam l e nl são podados
+// assim que o segundo aparece
+static bool CubeEnumNext(CubeEnum* e) {
+  if (e->started_ && !CubeEnumBacktrack(e)) return false;
+  e->started_ = true;
+  while (e->head_ >= 0) {
+    const ExprNode* node = e->cells_[e->head_].node_;
+    e->head_ = e->cells_[e->head_].next_;
+    if (!node) {
+      e->valid_ = false;
+      return false;
+    }
+    if (node->type_ == NODE_AND) {
+      int right = PushCell(e, node->right_, e->head_);
+      e->head_ = PushCell(e, node->left_, right);
+    } else if (node->type_ == NODE_OR) {
+      if (e->num_choices_ == e->choices_cap_) {
+        e->choices_cap_ = e->choices_cap_ ? e->choices_cap_ * 2 : 16;
+        e->choices_ = (CubeChoice*)realloc(
+            e->choices_, sizeof(CubeChoice) * e->choices_cap_);
+      }
+      CubeChoice* choice = &e->choices_[e->num_choices_++];
+      choice->right_ = node->right_;
+      choice->rest_ = e->head_;
+      choice->num_cells_ = e->num_cells_;
+      choice->num_lits_ = e->num_lits_;
+      e->head_ = PushCell(e, node->left_, e->head_);
+    } else {
+      const ExprNode* var = node->type_ == NODE_NOT ? node->left_ : node;
+      if (!var || var->type_ != NODE_VAR) {
+        e->valid_ = false;
+        return false;
+      }
+      int lit = node->type_ == NODE_NOT ? -var->variable_ : var->variable_;
+      if (!CubeEnumAssign(e, lit) && !CubeEnumBacktrack(e)) return false;
+    }
+  }
+  return true;
+}
+
+// Variável mais à esquerda (a de "(x a nx)" quando não há cubos)
+static int LeftmostVariable(const ExprNode* node) {
+  while (node->type_ != NODE_VAR && node->left_) node = node->left_;
+  return node->type_ == NODE_VAR ? node->variable_ : 1;
+}
+
+bool CollectDnfCubes(const ExprNode* root, VarMap* vars, ClauseSet* terms) {
+  CubeEnum e;
+  CubeEnumInit(&e, root);
+  VarMapGet(vars, LeftmostVariable(root));
+  int* lits = NULL;  // CoverAddTerm reordena; e.lits_ é a trilha
+  int lits_cap = 0;
+  while (CubeEnumNext(&e)) {
+    if (e.num_lits_ > lits_cap) {
+      lits_cap = e.lits_cap_;
+      lits = (int*)realloc(lits, sizeof(int) * lits_cap);
+    }
+    for (int i = 0; i < e.num_lits_; i++) {
+      int v = VarMapGet(vars, abs(e.lits_[i]));
+      lits[i] = e.lits_[i] > 0 ? v : -v;
+    }
+    CoverAddTerm(terms, lits, e.num_lits_);
+  }
+  bool valid = e.valid_;
+  free(lits);
+  CubeEnumFree(&e);
+  return valid;
+}
+
+struct DnfCubeIterator {
+  ExprArena arena_;  // guarda a NNF percorrida por enum_
+  CubeEnum enum_;
+  int first_var_;    // variável mais à esquerda, para "(x a nx)"
+};
+
+DnfCubeIterator* DnfCubeIteratorCreate(const char* input) {
+  DnfCubeIterator* it = (DnfCubeIterator*)malloc(sizeof(DnfCubeIterator));
+  ExprArenaInit(&it->arena_);
+  int pos = 0;
+  PhaseMark mark = PhaseBegin(&it->arena_);
+  ExprNode* root = ParseExpressionArena(&it->arena_, input, &pos);
+  PhaseEnd(PHASE_PARSE, mark, &it->arena_);
+  if (!root) {
+    ReleaseArena(&it->arena_);
+    free(it);
+    return NULL;
+  }
+
+  mark = PhaseBegin(&it->arena_);
+  root = NormalizeOperators(&it->arena_, root);
+  PhaseEnd(PHASE_NORMALIZE, mark, &it->arena_);
+  mark = PhaseBegin(&it->arena_);
+  root = PushNegations(&it->arena_, root);
+  PhaseEnd(PHASE_PUSH_NEGATIONS, mark, &it->arena_);
+  mark = PhaseBegin(&it->arena_);
+  root = PropagateLiterals(&it->arena_, root);
+  PhaseEnd(PHASE_PREPROCESS, mark, &it->arena_);
+
+  it->first_var_ = LeftmostVariable(root);
+  CubeEnumInit(&it->enum_, root);
+  return it;
+}
+
+void DnfCubeIteratorDestroy(DnfCubeIterator* it) {
+  if (!it) return;
+  CubeEnumFree(&it->enum_);
+  ReleaseArena(&it->arena_);
+  free(it);
+}
+
+const int* DnfCubeIteratorNext(DnfCubeIterator* it, int* size) {
+  PhaseMark mark = PhaseBegin(NULL);
+  bool found = CubeEnumNext(&it->enum_);
+  PhaseEnd(PHASE_DISTRIBUTE, mark, NULL);
+  if (!found) return NULL;
+  *size = it->enum_.num_lits_;
+  // Vazio: lits_ pode ainda não ter sido alocado
+  return it->enum_.lits_ ? it->enum_.lits_ : &it->first_var_;
+}
+
+long long ForEachDnfCube(const char* input, DnfCubeCallback callback,
+                         void* user) {
+  DnfCubeIterator* it = DnfCubeIteratorCreate(input);
+  if (!it) return -1;
+  long long count = 0;
+  const int* lits;
+  int size;
+  while ((lits = DnfCubeIteratorNext(it, &size))) {
+    count++;
+    if (!callback(lits, size, user)) break;
+  }
+  DnfCubeIteratorDestroy(it);
+  return count;
+}
+
+long long WriteDnfCubes(const char* input, FILE* out, long long max_cubes) {
+  DnfCubeIterator* it = DnfCubeIteratorCreate(input);
+  if (!it) return -1;
+  TextBuffer buf = {(char*)malloc(256), 0, 256, out};
+  buf.data_[0] = '\0';
+  char lit_text[32];
+  long long count = 0, bytes = 0;
+  int x = it->first_var_;
+  const int* lits;
+  int size, len;
+  while ((max_cubes <= 0 || count < max_cubes) &&
+         (lits = DnfCubeIteratorNext(it, &size))) {
+    if (count++ > 0) {
+      AppendText(&buf, " v ", 3);
+      bytes += 3;
+    }
+    if (size == 0) {
+      // Cubo vazio: a sentença é verdadeira
+      len = sprintf(lit_text, "(%d v n%d)", x, x);
+      AppendText(&buf, lit_text, len);
+      bytes += len;
+      continue;
+    }
+    if (size > 1) AppendText(&buf, "(", 1);
+    for (int j = 0; j < size; j++) {
+      len = sprintf(lit_text, "%s%s%d", j > 0 ? " a " : "",
+                    lits[j] < 0 ? "n" : "", abs(lits[j]));
+      AppendText(&buf, lit_text, len);
+      bytes += len;
+    }
+    if (size > 1) {
+      AppendText(&buf, ")", 1);
+      bytes += 2;
+    }
+  }
+  if (count == 0) {
+    len = sprintf(lit_text, "(%d a n%d)", x, x);
+    AppendText(&buf, lit_text, len);
+    bytes += len;
+  }
+  FlushText(&buf);
+  free(buf.data_);
+  STAT_ADD(output_bytes_, bytes);
+  DnfCubeIteratorDestroy(it);
+  return count;
+}
@@ -0,0 +1,153 @@
+#include "../include/expr_arena.h"
+
+#include <stdint.h>
+#include <stdlib.h>
+
+#define CACHE_LINE 64
+#define FIRST_BLOCK_NODES 256
+#define MAX_BLOCK_NODES 65536
+#define FIRST_TABLE_CAP 1024
+
+void ExprArenaInit(ExprArena* arena) {
+  arena->blocks_ = NULL;
+  arena->next_ = NULL;
+  arena->end_ = NULL;
+  arena->num_nodes_ = 0;
+  arena->num_blocks_ = 0;
+  arena->table_ = NULL;
+  arena->table_cap_ = 0;
+  arena->num_lookups_ = 0;
+  arena->num_hits_ = 0;
+}
+
+void ExprArenaRelease(ExprArena* arena) {
+  ExprArenaBlock* block = arena->blocks_;
+  while (block) {
+    ExprArenaBlock* next = block->next_;
+    free(block->raw_);
+    block = next;
+  }
+  free(arena->table_);
+  ExprArenaInit(arena);
+}
+
+// Blocos crescem geometricamente até MAX_BLOCK_NODES nós
+static void NewBlock(ExprArena* arena) {
+  size_t capacity = arena->blocks_ ? arena->blocks_->capacity_ * 2
+                                   : FIRST_BLOCK_NODES;
+  if (capacity > MAX_BLOCK_NODES) capacity = MAX_BLOCK_NODES;
+
+  size_t header = (sizeof(ExprArenaBlock) + CACHE_LINE - 1) & ~(size_t)(CACHE_LINE - 1);
+  void* raw = malloc(header + capacity * sizeof(ExprNode) + CACHE_LINE);
+  uintptr_t aligned = ((uintptr_t)raw + CACHE_LINE - 1) & ~(uintptr_t)(CACHE_LINE - 1);
+
+  ExprArenaBlock* block = (ExprArenaBlock*)aligned;
+  block->raw_ = raw;
+  block->capacity_ = capacity;
+  block->next_ = arena->blocks_;
+  arena->blocks_ = block;
+  arena->num_blocks_++;
+
+  arena->next_ = (ExprNode*)(aligned + header);
+  arena->end_ = arena->next_ + capacity;
+}
+
+// --- Tabela Única ---
+
+static size_t HashNode(NodeType type, int var, const ExprNode* left,
+                       const ExprNode* right) {
+  size_t h = (size_t)type * 0x9E3779B97F4A7C15ull;
+  h ^= (size_t)(unsigned)var + 0x7F4A7C15u + (h << 6) + (h >> 2);
+  h ^= (size_t)(left ? left->id_ : 0) * 0xC2B2AE3D27D4EB4Full + (h >> 29);
+  h ^= (size_t)(right ? right->id_ : 0) * 0x165667B19E3779F9ull + (h >> 31);
+  // Finalizador do MurmurHash3: a tabela usa os bits baixos e sondagem
+  // linear, então variáveis consecutivas não podem cair em sequência
+  h ^= h >> 33;
+  h *= 0xFF51AFD7ED558CCDull;
+  h ^= h >> 33;
+  return h;
+}
+
+static void GrowTable(ExprArena* arena) {
+  size_t old_cap = arena->table_cap_;
+  ExprNode** old_table = arena->table_;
+  arena->table_cap_ = old_cap ? old_cap * 2 : FIRST_TABLE_CAP;
+  arena->table_ =
+      (ExprNode**)calloc(arena->table_cap_, sizeof(ExprNode*));
+
+  size_t mask = arena->table_cap_ - 1;
+  for (size_t i = 0; i < old_cap; i++) {
+    ExprNode* n = old_table[i];
+    if (!n) continue;
+    size_t h = HashNode(n->type_, n->variable_, n->left_, n->right_) & mask;
+    while (arena->table_[h]) h = (h + 1) & mask;
+    arena->table_[h] = n;
+  }
+  free(old_table);
+}
+
+static ExprNode* MakeNode(ExprArena* arena, NodeType type, int var,
+                          ExprNode* left, ExprNode* right) {
+  if ((arena->num_nodes_ + 1) * 2 > arena->table_cap_) GrowTable(arena);
+  arena->num_lookups_++;
+
+  size_t mask = arena->table_cap_ - 1;
+  size_t h = HashNode(type, var, left, right) & mask;
+  for (ExprNode* n; (n = arena->table_[h]) != NULL; h = (h + 1) & mask) {
+    if (n->type_ == type && n->variable_ == var && n->left_ == left &&
+        n->right_ == right) {
+      arena->num_hits_++;
+      return n;
+    }
+  }
+
+  if (arena->next_ == arena->end_) NewBlock(arena);
+  ExprNode* node = arena->next_++;
+  node->type_ = type;
+  node->variable_ = var;
+  node->left_ = left;
+  node->right_ = right;
+  node->id_ = (int)++arena->num_nodes_;
+  arena->table_[h] = node;
+  return node;
+}
+
+ExprNode* ArenaNode(ExprArena* arena, NodeType type, ExprNode* left,
+                    ExprNode* right) {
+  return MakeNode(arena, type, 0, left, right);
+}
+
+ExprNode* ArenaVar(ExprArena* arena, int var) {
+  return MakeNode(arena, NODE_VAR, var, NULL, NULL);
+}
+
+// --- Memoização por id ---
+
+void ExprMemoInit(ExprMemo* memo) {
+  memo->results_ = NULL;
+  memo->cap_ = 0;
+}
+
+void ExprMemoFree(ExprMemo* memo) {
+  free(memo->results_);
+  ExprMemoInit(memo);
+}
+
+ExprNode* ExprMemoGet(const ExprMemo* memo, const ExprNode* node) {
+  size_t id = (size_t)node->id_;
+  return id < memo->cap_ ? memo->results_[id] : NULL;
+}
+
+void ExprMemoSet(ExprMemo* memo, const ExprNode* node, ExprNode* result) {
+  size_t id = (size_t)node->id_;
+  if (id == 0) return;  // nó fora de arena: sem memoização
+  if (id >= memo->cap_) {
+    size_t cap = memo->cap_ ? memo->cap_ : 256;
+    while (cap <= id) cap *= 2;
+    memo->results_ =
+        (ExprNode**)realloc(memo->results_, sizeof(ExprNode*) * cap);
+    for (size_t i = memo->cap_; i < cap; i++) memo->results_[i] = NULL;
+    memo->cap_ = cap;
+  }
+  memo->results_[id] = result;
+}
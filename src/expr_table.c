@@ -0,0 +1,218 @@
+#include "../include/expr_table.h"
+
+#include <stdlib.h>
+
+#include "../include/mapped_file.h"
+
+// Parser de Pratt iterativo (precedência por operador) com duas pilhas
+// explícitas: operandos já emitidos e operadores pendentes. Aninhamento
+// profundo só cresce as pilhas, nunca a pilha de chamadas.
+
+#define OP_LPAREN 0xFF  // marcador de '(' na pilha de operadores
+
+typedef struct {
+  uint32_t* values_;
+  int num_values_;
+  int values_cap_;
+  uint8_t* ops_;
+  int num_ops_;
+  int ops_cap_;
+} ParseStacks;
+
+void ExprTableInit(ExprTable* table) {
+  table->types_ = NULL;
+  table->vars_ = NULL;
+  table->left_ = NULL;
+  table->right_ = NULL;
+  table->count_ = 0;
+  table->cap_ = 0;
+}
+
+void ExprTableFree(ExprTable* table) {
+  free(table->types_);
+  free(table->vars_);
+  free(table->left_);
+  free(table->right_);
+  ExprTableInit(table);
+}
+
+static bool Emit(ExprTable* table, NodeType type, int32_t var, uint32_t left,
+                 uint32_t right, uint32_t* index) {
+  if (table->count_ == table->cap_) {
+    if (table->cap_ >= EXPR_TABLE_NONE / 2) return false;
+    table->cap_ = table->cap_ ? table->cap_ * 2 : 64;
+    table->types_ = (uint8_t*)realloc(table->types_, table->cap_);
+    table->vars_ =
+        (int32_t*)realloc(table->vars_, sizeof(int32_t) * table->cap_);
+    table->left_ =
+        (uint32_t*)realloc(table->left_, sizeof(uint32_t) * table->cap_);
+    table->right_ =
+        (uint32_t*)realloc(table->right_, sizeof(uint32_t) * table->cap_);
+  }
+  uint32_t i = table->count_++;
+  table->types_[i] = (uint8_t)type;
+  table->vars_[i] = var;
+  table->left_[i] = left;
+  table->right_[i] = right;
+  *index = i;
+  return true;
+}
+
+static void PushValue(ParseStacks* st, uint32_t value) {
+  if (st->num_values_ == st->values_cap_) {
+    st->values_cap_ = st->values_cap_ ? st->values_cap_ * 2 : 64;
+    st->values_ = (uint32_t*)realloc(st->values_,
+                                     sizeof(uint32_t) * st->values_cap_);
+  }
+  st->values_[st->num_values_++] = value;
+}
+
+static void PushOp(ParseStacks* st, uint8_t op) {
+  if (st->num_ops_ == st->ops_cap_) {
+    st->ops_cap_ = st->ops_cap_ ? st->ops_cap_ * 2 : 64;
+    st->ops_ = (uint8_t*)realloc(st->ops_, st->ops_cap_);
+  }
+  st->ops_[st->num_ops_++] = op;
+}
+
+// Força de ligação; NOT (prefixo) liga mais que qualquer binário
+static int BindingPower(uint8_t op) {
+  switch (op) {
+    case NODE_NOT:
+      return 5;
+    case NODE_AND:
+      return 4;
+    case NODE_OR:
+      return 3;
+    case NODE_IMPLIES:
+      return 2;
+    case NODE_XOR:
+      return 1;
+    default:
+      return 0;  // OP_LPAREN
+  }
+}
+
+static int BinaryOp(char c) {
+  switch (c) {
+    case 'a':
+      return NODE_AND;
+    case 'v':
+      return NODE_OR;
+    case 'x':
+      return NODE_XOR;
+    case '>':
+      return NODE_IMPLIES;
+    default:
+      return -1;
+  }
+}
+
+static inline bool IsSpace(char c) {
+  return c == ' ' || c == '\t' || c == '\n' || c == '\r';
+}
+
+// Aplica o operador do topo aos operandos do topo. A máquina de estados de
+// ExprTableParse garante que os operandos existem.
+static bool Reduce(ExprTable* table, ParseStacks* st) {
+  uint8_t op = st->ops_[--st->num_ops_];
+  uint32_t right = EXPR_TABLE_NONE;
+  if (op != NODE_NOT) right = st->values_[--st->num_values_];
+  uint32_t left = st->values_[--st->num_values_];
+  uint32_t index;
+  if (!Emit(table, (NodeType)op, 0, left, right, &index)) return false;
+  PushValue(st, index);
+  return true;
+}
+
+bool ExprTableParse(ExprTable* table, const char* input, size_t len,
+                    size_t* end) {
+  table->count_ = 0;
+  ParseStacks st = {NULL, 0, 0, NULL, 0, 0};
+  int open_parens = 0;
+  bool expect_operand = true;
+  bool ok = true;
+  size_t pos = 0;
+
+  while (ok) {
+    while (pos < len && IsSpace(input[pos])) pos++;
+    char c = pos < len ? input[pos] : '\0';
+
+    if (expect_operand) {
+      if (c == 'n') {
+        PushOp(&st, NODE_NOT);
+        pos++;
+      } else if (c == '(') {
+        PushOp(&st, OP_LPAREN);
+        open_parens++;
+        pos++;
+      } else if (c >= '0' && c <= '9') {
+        int32_t var = 0;
+        while (pos < len && input[pos] >= '0' && input[pos] <= '9') {
+          int digit = input[pos] - '0';
+          if (var > (INT32_MAX - digit) / 10) break;
+          var = var * 10 + digit;
+          pos++;
+        }
+        uint32_t index;
+        // A variável 0 não tem sinal: -0 == 0 nos literais +-v
+        ok = var > 0 && (pos == len || input[pos] < '0' || input[pos] > '9');
+        if (ok) ok = Emit(table, NODE_VAR, var, EXPR_TABLE_NONE,
+                          EXPR_TABLE_NONE, &index);
+        if (ok) PushValue(&st, index);
+        expect_operand = false;
+      } else {
+        ok = false;  // operando ausente
+      }
+      continue;
+    }
+
+    int op = BinaryOp(c);
+    if (op >= 0) {
+      // Reduz o que liga mais forte (ou igual, se associar à esquerda)
+      int power = BindingPower((uint8_t)op);
+      while (ok && st.num_ops_ > 0) {
+        int top = BindingPower(st.ops_[st.num_ops_ - 1]);
+        if (top < power || (top == power && op == NODE_IMPLIES)) break;
+        ok = Reduce(table, &st);
+      }
+      PushOp(&st, (uint8_t)op);
+      expect_operand = true;
+      pos++;
+    } else if (c == ')' && open_parens > 0) {
+      while (ok && st.ops_[st.num_ops_ - 1] != OP_LPAREN)
+        ok = Reduce(table, &st);
+      st.num_ops_--;
+      open_parens--;
+      pos++;
+    } else {
+      break;  // fim da expressão
+    }
+  }
+
+  // Parênteses não fechados no fim da entrada são descartados
+  while (ok && st.num_ops_ > 0) {
+    if (st.ops_[st.num_ops_ - 1] == OP_LPAREN)
+      st.num_ops_--;
+    else
+      ok = Reduce(table, &st);
+  }
+
+  free(st.values_);
+  free(st.ops_);
+  if (end) *end = pos;
+  if (!ok) table->count_ = 0;
+  return ok;
+}
+
+bool ExprTableParseFile(ExprTable* table, const char* path) {
+  MappedFile file;
+  if (!MappedFileOpen(&file, path)) return false;
+  size_t end;
+  bool ok = ExprTableParse(table, file.data_, file.size_, &end);
+  while (ok && end < file.size_ && IsSpace(file.data_[end])) end++;
+  ok = ok && end == file.size_;
+  MappedFileClose(&file);
+  if (!ok) table->count_ = 0;
+  return ok;
+}
@@ -1,15 +1,198 @@
+#include <stdbool.h>
 #include <stdio.h>
 #include <stdlib.h>
 #include <string.h>
 
+#include "../include/batch.h"
+#include "../include/dimacs_convert.h"
 #include "../include/dnf_converter.h"
+#include "../include/dnf_cubes.h"
+#include "../include/model_iterator.h"
+#include "../include/result_cache.h"
+
+// Modelos impressos pela opção 8 (a contagem é sempre completa)
+#define MAX_LISTED_MODELS 16
+
+// Contadores acumulados desde o último ConvertStatsReset (flag --stats)
+static void PrintStats(FILE* out) {
+  if (!ConvertStatsEnabled()) return;
+  ConvertStats st;
+  ConvertStatsGet(&st);
+  fprintf(out, "\n-- Estatisticas --\n");
+  fprintf(out, "nos criados/liberados: %lld / %lld (compartilhados: %lld, "
+          "pico: %lld)\n", st.nodes_allocated_, st.nodes_freed_,
+          st.nodes_shared_, st.peak_nodes_);
+  fprintf(out, "CloneTree: %lld chamadas, %lld bytes\n", st.clone_calls_,
+          st.clone_bytes_);
+  fprintf(out, "distributiva: %lld reescritas, profundidade maxima: %lld\n",
+          st.distribute_rewrites_, st.max_depth_);
+  fprintf(out, "EvaluateTree: %lld chamadas, saida: %lld bytes\n",
+          st.evaluate_calls_, st.output_bytes_);
+  fprintf(out, "pre-processamento: %lld variaveis e %lld clausulas "
+          "removidas\n", st.removed_vars_, st.removed_clauses_);
+  for (int p = 0; p < NUM_CONVERT_PHASES; p++) {
+    if (st.phase_calls_[p] == 0) continue;
+    fprintf(out, "  %-15s %10.3f ms  %10lld nos  (%lld chamadas)\n",
+            ConvertPhaseName((ConvertPhase)p), st.phase_seconds_[p] * 1e3,
+            st.phase_nodes_[p], st.phase_calls_[p]);
+  }
+  if (ResultCacheEnabled()) {
+    // Acumulado desde o início (o cache não é zerado entre operações)
+    ResultCacheStats cs;
+    ResultCacheGetStats(&cs);
+    fprintf(out, "cache: %lld acertos, %lld faltas, %lld descartes, "
+            "%lld entradas, %zu / %zu bytes\n", cs.hits_, cs.misses_,
+            cs.evictions_, cs.entries_, cs.bytes_, cs.budget_);
+  }
+  ConvertStatsReset();
+}
 
 void clear_buffer() {
   int c;
   while ((c = getchar()) != '\n' && c != EOF);
 }
 
-int main() {
+// Uso: main --batch [arquivo] [-j threads]  (sem arquivo lê da entrada padrão)
+static int RunBatchMode(int argc, char** argv) {
+  const char* path = NULL;
+  int threads = 0;
+  for (int i = 1; i < argc; i++) {
+    if (!strcmp(argv[i], "-j") && i + 1 < argc)
+      threads = atoi(argv[++i]);
+    else if (!strcmp(argv[i], "--cache") && i + 1 < argc)
+      i++;
+    else if (strcmp(argv[i], "--batch") != 0 && strcmp(argv[i], "--stats"))
+      path = argv[i];
+  }
+
+  FILE* in = stdin;
+  if (path && strcmp(path, "-") != 0) {
+    in = fopen(path, "r");
+    if (!in) {
+      fprintf(stderr, "Nao foi possivel abrir %s\n", path);
+      return 1;
+    }
+  }
+  BatchRun(in, stdout, threads);
+  if (in != stdin) fclose(in);
+  return 0;
+}
+
+// Uso: main --sat-file arquivo  (a sentença é lida com mmap, sem cópia)
+static int RunSatFileMode(const char* path) {
+  FILE* in = fopen(path, "r");
+  if (!in) {
+    fprintf(stderr, "Nao foi possivel abrir %s\n", path);
+    return 1;
+  }
+  fclose(in);
+
+  bool* model;
+  int model_size;
+  if (!FindSatisfyingModelFile(path, &model, &model_size)) {
+    printf("INSATISFATIVEL\n");
+    PrintStats(stderr);
+    return 0;
+  }
+  printf("SATISFATIVEL\n");
+  for (int v = 1; v < model_size; v++) printf(model[v] ? " %d" : " n%d", v);
+  printf("\n");
+  free(model);
+  PrintStats(stderr);
+  return 0;
+}
+
+// Uso: main --dimacs-sat arquivo.cnf  (saída no formato das competições
+// de SAT: "s SATISFIABLE" e "v 1 -2 ... 0"; código de saída 10 ou 20)
+static int RunDimacsSatMode(const char* path) {
+  bool* model;
+  int model_size;
+  long long error_line;
+  bool sat = FindSatisfyingModelDimacs(path, &model, &model_size,
+                                       &error_line);
+  if (error_line < 0) {
+    fprintf(stderr, "Nao foi possivel abrir %s\n", path);
+    return 1;
+  }
+  if (error_line > 0) {
+    fprintf(stderr, "%s:%lld: DIMACS invalido\n", path, error_line);
+    return 1;
+  }
+  if (!sat) {
+    printf("s UNSATISFIABLE\n");
+    PrintStats(stderr);
+    return 20;
+  }
+  printf("s SATISFIABLE\nv");
+  for (int v = 1; v < model_size; v++) printf(" %d", model[v] ? v : -v);
+  printf(" 0\n");
+  free(model);
+  PrintStats(stderr);
+  return 10;
+}
+
+// Uso: main --to-dimacs sentença [--tseitin | --pg]  (FNC em DIMACS na
+// saída padrão; sem opção, a FNC equivalente de ConvertToCNF)
+static int RunToDimacsMode(int argc, char** argv) {
+  const char* input = NULL;
+  CnfMode mode = CNF_EQUIVALENT;
+  for (int i = 1; i < argc; i++) {
+    if (!strcmp(argv[i], "--tseitin"))
+      mode = CNF_TSEITIN;
+    else if (!strcmp(argv[i], "--pg"))
+      mode = CNF_PLAISTED_GREENBAUM;
+    else if (!strcmp(argv[i], "--to-dimacs") && i + 1 < argc)
+      input = argv[++i];
+  }
+  if (!input || !WriteCNFDimacs(input, mode, stdout)) {
+    fprintf(stderr, "Sentenca invalida\n");
+    return 1;
+  }
+  PrintStats(stderr);
+  return 0;
+}
+
+// Uso: main --dnf-stream sentença [-n cubos]  (FND escrita à medida que os
+// cubos são gerados, sem simplificação; sem -n escreve todos)
+static int RunDnfStreamMode(int argc, char** argv) {
+  const char* input = NULL;
+  long long max_cubes = 0;
+  for (int i = 1; i < argc; i++) {
+    if (!strcmp(argv[i], "-n") && i + 1 < argc)
+      max_cubes = atoll(argv[++i]);
+    else if (!strcmp(argv[i], "--dnf-stream") && i + 1 < argc)
+      input = argv[++i];
+  }
+  if (!input || WriteDnfCubes(input, stdout, max_cubes) < 0) {
+    fprintf(stderr, "Sentenca invalida\n");
+    return 1;
+  }
+  printf("\n");
+  PrintStats(stderr);
+  return 0;
+}
+
+// Opções: --stats imprime os contadores de ConvertStats após cada operação
+// (no modo em lote, no campo "stats" de cada resultado); --cache <MB> liga
+// o cache de resultados com esse orçamento de memória
+int main(int argc, char** argv) {
+  for (int i = 1; i < argc; i++) {
+    if (!strcmp(argv[i], "--stats") && !ConvertStatsEnable(true))
+      fprintf(stderr, "Instrumentacao nao compilada (LOGICA_STATS)\n");
+    if (!strcmp(argv[i], "--cache") && i + 1 < argc)
+      ResultCacheSetBudget((size_t)atoi(argv[i + 1]) << 20);
+  }
+
+  for (int i = 1; i < argc; i++) {
+    if (!strcmp(argv[i], "--batch")) return RunBatchMode(argc, argv);
+    if (!strcmp(argv[i], "--sat-file") && i + 1 < argc)
+      return RunSatFileMode(argv[i + 1]);
+    if (!strcmp(argv[i], "--dnf-stream")) return RunDnfStreamMode(argc, argv);
+    if (!strcmp(argv[i], "--dimacs-sat") && i + 1 < argc)
+      return RunDimacsSatMode(argv[i + 1]);
+    if (!strcmp(argv[i], "--to-dimacs")) return RunToDimacsMode(argc, argv);
+  }
+
   int choice;
   char buffer1[256];
   char buffer2[256];
@@ -25,6 +208,10 @@ int main() {
     printf("2. Converter para FNC (CNF)\n");
     printf("3. Converter para FND (DNF)\n");
     printf("4. Verificar Satisfazibilidade (SAT)\n");
+    printf("5. Converter para FNC equisatisfativel (Tseitin)\n");
+    printf("6. Converter para FNC minima\n");
+    printf("7. Converter para FND minima\n");
+    printf("8. Contar e listar modelos\n");
     printf("0. Sair\n");
     printf("Escolha: ");
 
@@ -43,10 +230,21 @@ int main() {
         buffer1[strcspn(buffer1, "\n")] = 0;
         buffer2[strcspn(buffer2, "\n")] = 0;
 
-        if (AreEquivalent(buffer1, buffer2))
+        bool* counterexample;
+        int counterexample_size;
+        if (CheckEquivalence(buffer1, buffer2, &counterexample,
+                             &counterexample_size)) {
           printf("\n>> RESULTADO: Sao EQUIVALENTES.\n");
-        else
+        } else {
           printf("\n>> RESULTADO: NAO sao equivalentes.\n");
+          if (counterexample) {
+            printf(">> Contraexemplo:");
+            for (int v = 1; v < counterexample_size; v++)
+              printf(counterexample[v] ? " %d" : " n%d", v);
+            printf("\n");
+          }
+          free(counterexample);
+        }
         break;
 
       case 2:
@@ -54,6 +252,10 @@ int main() {
         fgets(buffer1, 256, stdin);
         buffer1[strcspn(buffer1, "\n")] = 0;
         char* cnf = ConvertToCNF(buffer1);
+        if (!cnf) {
+          printf("\n>> Sentenca invalida.\n");
+          break;
+        }
         printf("\n>> FNC Gerada: %s\n", cnf);
         free(cnf);
         break;
@@ -63,6 +265,10 @@ int main() {
         fgets(buffer1, 256, stdin);
         buffer1[strcspn(buffer1, "\n")] = 0;
         char* dnf = ConvertToDNF(buffer1);
+        if (!dnf) {
+          printf("\n>> Sentenca invalida.\n");
+          break;
+        }
         printf("\n>> FND Gerada: %s\n", dnf);
         free(dnf);
         break;
@@ -74,16 +280,78 @@ int main() {
         fgets(buffer1, 256, stdin);
         buffer1[strcspn(buffer1, "\n")] = 0;
 
-        if (IsSatisfiable(buffer1))
+        bool* model;
+        int model_size;
+        if (FindSatisfyingModel(buffer1, &model, &model_size)) {
           printf("\n>> RESULTADO: A sentenca e SATISFATIVEL.\n");
-        else
+          printf(">> Modelo:");
+          for (int v = 1; v < model_size; v++)
+            printf(model[v] ? " %d" : " n%d", v);
+          printf("\n");
+          free(model);
+        } else
           printf(
               "\n>> RESULTADO: A sentenca e INSATISFATIVEL (Contradicao).\n");
         break;
 
+      case 5:
+        printf("Digite a sentenca: ");
+        fgets(buffer1, 256, stdin);
+        buffer1[strcspn(buffer1, "\n")] = 0;
+        char* tseitin = ConvertToCNFMode(buffer1, CNF_TSEITIN);
+        if (!tseitin) {
+          printf("\n>> Sentenca invalida.\n");
+          break;
+        }
+        printf("\n>> FNC Equisatisfativel: %s\n", tseitin);
+        free(tseitin);
+        break;
+
+      case 6:
+      case 7:
+        printf("Digite a sentenca: ");
+        fgets(buffer1, 256, stdin);
+        buffer1[strcspn(buffer1, "\n")] = 0;
+        char* minimal =
+            choice == 6 ? ConvertToCNFMinimized(buffer1, MINIMIZE_TWO_LEVEL)
+                        : ConvertToDNFMinimized(buffer1, MINIMIZE_TWO_LEVEL);
+        if (!minimal) {
+          printf("\n>> Sentenca invalida.\n");
+          break;
+        }
+        printf("\n>> %s Minima: %s\n", choice == 6 ? "FNC" : "FND", minimal);
+        free(minimal);
+        break;
+
+      case 8:
+        printf("Digite a sentenca: ");
+        fgets(buffer1, 256, stdin);
+        buffer1[strcspn(buffer1, "\n")] = 0;
+        char* count = CountModels(buffer1);
+        if (!count) {
+          printf("\n>> Sentenca invalida.\n");
+          break;
+        }
+        printf("\n>> Numero de modelos: %s\n", count);
+        free(count);
+
+        ModelIterator* it = ModelIteratorCreate(buffer1);
+        const bool* next;
+        int next_size, listed = 0;
+        while (listed < MAX_LISTED_MODELS &&
+               (next = ModelIteratorNext(it, &next_size))) {
+          printf(">> Modelo %d:", ++listed);
+          for (int v = 1; v < next_size; v++)
+            printf(next[v] ? " %d" : " n%d", v);
+          printf("\n");
+        }
+        ModelIteratorDestroy(it);
+        break;
+
       default:
         printf("Opcao invalida.\n");
     }
+    PrintStats(stdout);
     printf("\nPressione ENTER para continuar...");
     getchar();
   }
@@ -0,0 +1,89 @@
+#include "../include/mapped_file.h"
+
+#ifdef _WIN32
+#include <windows.h>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+#ifdef _WIN32
+
+bool MappedFileOpen(MappedFile* file, const char* path) {
+  file->data_ = NULL;
+  file->size_ = 0;
+  file->handle_ = NULL;
+
+  HANDLE fd = CreateFileA(path, GENERIC_READ, FILE_SHARE_READ, NULL,
+                          OPEN_EXISTING, FILE_FLAG_SEQUENTIAL_SCAN, NULL);
+  if (fd == INVALID_HANDLE_VALUE) return false;
+  LARGE_INTEGER size;
+  if (!GetFileSizeEx(fd, &size)) {
+    CloseHandle(fd);
+    return false;
+  }
+  if (size.QuadPart == 0) {  // arquivos vazios não podem ser mapeados
+    CloseHandle(fd);
+    return true;
+  }
+  HANDLE mapping = CreateFileMappingA(fd, NULL, PAGE_READONLY, 0, 0, NULL);
+  CloseHandle(fd);
+  if (!mapping) return false;
+  void* data = MapViewOfFile(mapping, FILE_MAP_READ, 0, 0, 0);
+  if (!data) {
+    CloseHandle(mapping);
+    return false;
+  }
+  file->data_ = (const char*)data;
+  file->size_ = (size_t)size.QuadPart;
+  file->handle_ = mapping;
+  return true;
+}
+
+void MappedFileClose(MappedFile* file) {
+  if (file->data_) UnmapViewOfFile(file->data_);
+  if (file->handle_) CloseHandle((HANDLE)file->handle_);
+  file->data_ = NULL;
+  file->size_ = 0;
+  file->handle_ = NULL;
+}
+
+#else
+
+bool MappedFileOpen(MappedFile* file, const char* path) {
+  file->data_ = NULL;
+  file->size_ = 0;
+  file->handle_ = NULL;
+
+  int fd = open(path, O_RDONLY);
+  if (fd < 0) return false;
+  struct stat st;
+  if (fstat(fd, &st) != 0) {
+    close(fd);
+    return false;
+  }
+  if (st.st_size == 0) {  // mmap de tamanho zero falha
+    close(fd);
+    return true;
+  }
+  void* data = mmap(NULL, (size_t)st.st_size, PROT_READ, MAP_PRIVATE, fd, 0);
+  close(fd);  // o mapeamento continua válido sem o descritor
+  if (data == MAP_FAILED) return false;
+#ifdef MADV_SEQUENTIAL
+  madvise(data, (size_t)st.st_size, MADV_SEQUENTIAL);
+#endif
+  file->data_ = (const char*)data;
+  file->size_ = (size_t)st.st_size;
+  return true;
+}
+
+void MappedFileClose(MappedFile* file) {
+  if (file->data_) munmap((void*)file->data_, file->size_);
+  file->data_ = NULL;
+  file->size_ = 0;
+  file->handle_ = NULL;
+}
+
+#endif
@@ -0,0 +1,641 @@
+#include "../include/model_count.h"
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#define FIRST_CACHE_CAP 1024
+
+// --- Naturais de Precisão Arbitrária ---
+
+static void Reserve(BigNat* n, int size) {
+  if (size <= n->cap_) return;
+  int cap = n->cap_ ? n->cap_ : 4;
+  while (cap < size) cap *= 2;
+  n->limbs_ = (uint32_t*)realloc(n->limbs_, sizeof(uint32_t) * cap);
+  n->cap_ = cap;
+}
+
+static void Trim(BigNat* n) {
+  while (n->size_ > 0 && n->limbs_[n->size_ - 1] == 0) n->size_--;
+}
+
+void BigNatInit(BigNat* n) {
+  n->limbs_ = NULL;
+  n->size_ = 0;
+  n->cap_ = 0;
+}
+
+void BigNatFree(BigNat* n) {
+  free(n->limbs_);
+  BigNatInit(n);
+}
+
+void BigNatSetU64(BigNat* n, uint64_t value) {
+  Reserve(n, 2);
+  n->limbs_[0] = (uint32_t)value;
+  n->limbs_[1] = (uint32_t)(value >> 32);
+  n->size_ = 2;
+  Trim(n);
+}
+
+static void SetLimbs(BigNat* n, const uint32_t* limbs, int size) {
+  Reserve(n, size);
+  if (size) memcpy(n->limbs_, limbs, sizeof(uint32_t) * size);
+  n->size_ = size;
+}
+
+void BigNatCopy(BigNat* dst, const BigNat* src) {
+  SetLimbs(dst, src->limbs_, src->size_);
+}
+
+void BigNatAdd(BigNat* dst, const BigNat* src) {
+  int size = dst->size_ > src->size_ ? dst->size_ : src->size_;
+  Reserve(dst, size + 1);
+  uint64_t carry = 0;
+  for (int i = 0; i < size; i++) {
+    uint64_t sum = carry;
+    if (i < dst->size_) sum += dst->limbs_[i];
+    if (i < src->size_) sum += src->limbs_[i];
+    dst->limbs_[i] = (uint32_t)sum;
+    carry = sum >> 32;
+  }
+  dst->limbs_[size] = (uint32_t)carry;
+  dst->size_ = size + 1;
+  Trim(dst);
+}
+
+void BigNatMul(BigNat* dst, const BigNat* a, const BigNat* b) {
+  if (BigNatIsZero(a) || BigNatIsZero(b)) {
+    dst->size_ = 0;
+    return;
+  }
+  int size = a->size_ + b->size_;
+  Reserve(dst, size);
+  memset(dst->limbs_, 0, sizeof(uint32_t) * size);
+  for (int i = 0; i < a->size_; i++) {
+    uint64_t carry = 0;
+    for (int j = 0; j < b->size_; j++) {
+      uint64_t cur = (uint64_t)a->limbs_[i] * b->limbs_[j] +
+                     dst->limbs_[i + j] + carry;
+      dst->limbs_[i + j] = (uint32_t)cur;
+      carry = cur >> 32;
+    }
+    dst->limbs_[i + b->size_] = (uint32_t)carry;
+  }
+  dst->size_ = size;
+  Trim(dst);
+}
+
+void BigNatShiftLeft(BigNat* n, int bits) {
+  if (BigNatIsZero(n) || bits <= 0) return;
+  int words = bits / 32, rem = bits % 32;
+  int size = n->size_;
+  Reserve(n, size + words + 1);
+  // Do topo para a base: cada palavra só lê posições ainda não escritas
+  for (int i = size; i >= 0; i--) {
+    uint32_t hi = i < size ? n->limbs_[i] : 0;
+    uint32_t lo = i > 0 ? n->limbs_[i - 1] : 0;
+    n->limbs_[i + words] = rem ? (hi << rem) | (lo >> (32 - rem)) : hi;
+  }
+  for (int i = 0; i < words; i++) n->limbs_[i] = 0;
+  n->size_ = size + words + 1;
+  Trim(n);
+}
+
+// n = 2^bits - 1
+static void SetAllOnes(BigNat* n, int bits) {
+  int words = (bits + 31) / 32;
+  Reserve(n, words);
+  for (int i = 0; i < words; i++) n->limbs_[i] = 0xFFFFFFFFu;
+  if (bits % 32) n->limbs_[words - 1] = (1u << (bits % 32)) - 1;
+  n->size_ = words;
+}
+
+char* BigNatToString(const BigNat* n) {
+  if (BigNatIsZero(n)) {
+    char* zero = (char*)malloc(2);
+    strcpy(zero, "0");
+    return zero;
+  }
+  // Divisões sucessivas por 10^9 (cada bloco tem mais de 29 bits)
+  int size = n->size_;
+  uint32_t* rest = (uint32_t*)malloc(sizeof(uint32_t) * size);
+  memcpy(rest, n->limbs_, sizeof(uint32_t) * size);
+  uint32_t* chunks = (uint32_t*)malloc(sizeof(uint32_t) * (size * 32 / 29 + 2));
+  int num_chunks = 0;
+  do {  // n não é zero: ao menos um bloco
+    uint64_t rem = 0;
+    for (int i = size - 1; i >= 0; i--) {
+      uint64_t cur = (rem << 32) | rest[i];
+      rest[i] = (uint32_t)(cur / 1000000000u);
+      rem = cur % 1000000000u;
+    }
+    chunks[num_chunks++] = (uint32_t)rem;
+    while (size > 0 && rest[size - 1] == 0) size--;
+  } while (size > 0);
+
+  // Cada bloco tem 9 dígitos, mas o buffer comporta os 10 que um "%u"
+  // pode escrever no mais alto
+  char* text = (char*)malloc((size_t)num_chunks * 9 + 2);
+  int len = sprintf(text, "%u", (unsigned)chunks[num_chunks - 1]);
+  for (int i = num_chunks - 2; i >= 0; i--)
+    len += sprintf(text + len, "%09u", (unsigned)chunks[i]);
+  free(rest);
+  free(chunks);
+  return text;
+}
+
+// --- Contador ---
+// A busca usa uma pilha explícita de quadros, um por componente em
+// contagem. Os componentes ficam em comps_ como [nv, nc, variáveis...,
+// cláusulas...] (ambas ordenadas), que é também a chave do cache; os
+// filhos de um ramo são empilhados logo após os do pai e descartados
+// quando o ramo termina.
+
+typedef struct {
+  int comp_;          // posição do componente em comps_
+  uint64_t hash_;
+  int var_;           // variável de ramificação (0 na raiz: sem ramos)
+  int branch_;        // 0: var verdadeira, 1: falsa
+  bool open_;         // ramo em andamento
+  int trail_;         // tamanho da trilha antes do ramo
+  int children_;      // filhos do ramo em comps_[children_ .. children_end_)
+  int next_child_;
+  int children_end_;
+  BigNat total_;      // soma dos ramos concluídos
+  BigNat product_;    // produto dos filhos já contados no ramo atual
+} CountFrame;
+
+typedef struct {
+  uint64_t hash_;
+  size_t key_;        // posição em keys_
+  size_t value_;      // posição em limbs_
+  int key_len_;       // 0: posição vazia
+  int value_len_;
+} CacheEntry;
+
+typedef struct {
+  int num_vars_;
+  int num_clauses_;
+  int* lits_;           // cláusulas sem literais repetidos nem tautologias
+  size_t* starts_;
+  int* occ_;            // cláusulas de cada literal (índice 2v / 2v + 1)
+  size_t* occ_start_;
+  signed char* value_;  // -1 livre, 0 falsa, 1 verdadeira
+  int* trail_;
+  int trail_size_;
+
+  int* var_mark_;
+  int* clause_mark_;
+  int stamp_;
+  int* score_;
+  int* queue_;          // variáveis do componente em construção
+  int* clause_buf_;     // cláusulas do componente em construção
+
+  int* comps_;
+  int comps_size_;
+  int comps_cap_;
+  CountFrame* frames_;
+  int num_frames_;
+  int frames_cap_;
+
+  CacheEntry* table_;
+  int table_cap_;
+  int table_count_;
+  uint32_t* keys_;
+  size_t keys_size_;
+  size_t keys_cap_;
+  uint32_t* limbs_;
+  size_t limbs_size_;
+  size_t limbs_cap_;
+
+  BigNat ret_;          // contagem do último componente concluído
+  BigNat scratch_;
+} Counter;
+
+static inline int LitIndex(int lit) { return lit > 0 ? 2 * lit : -2 * lit + 1; }
+
+// 1 verdadeiro, 0 falso, -1 livre
+static inline int LitValue(const Counter* c, int lit) {
+  int value = c->value_[lit > 0 ? lit : -lit];
+  return value < 0 ? -1 : value == (lit > 0);
+}
+
+static void Assign(Counter* c, int lit) {
+  c->value_[lit > 0 ? lit : -lit] = lit > 0;
+  c->trail_[c->trail_size_++] = lit;
+}
+
+static void Undo(Counter* c, int trail_size) {
+  while (c->trail_size_ > trail_size) {
+    int lit = c->trail_[--c->trail_size_];
+    c->value_[lit > 0 ? lit : -lit] = -1;
+  }
+}
+
+static bool ClauseSatisfied(const Counter* c, int cl) {
+  for (size_t j = c->starts_[cl]; j < c->starts_[cl + 1]; j++)
+    if (LitValue(c, c->lits_[j]) == 1) return true;
+  return false;
+}
+
+// Propagação unitária a partir de trail_[head]; false em conflito
+static bool Propagate(Counter* c, int head) {
+  while (head < c->trail_size_) {
+    int idx = LitIndex(-c->trail_[head++]);
+    for (size_t k = c->occ_start_[idx]; k < c->occ_start_[idx + 1]; k++) {
+      int cl = c->occ_[k];
+      int unit = 0, open = 0;
+      bool sat = false;
+      for (size_t j = c->starts_[cl]; j < c->starts_[cl + 1] && !sat; j++) {
+        int value = LitValue(c, c->lits_[j]);
+        if (value == 1) sat = true;
+        if (value < 0) {
+          unit = c->lits_[j];
+          open++;
+        }
+      }
+      if (sat || open > 1) continue;
+      if (open == 0) return false;
+      Assign(c, unit);
+    }
+  }
+  return true;
+}
+
+static bool CounterInit(Counter* c, const ClauseSet* cnf, int num_vars) {
+  memset(c, 0, sizeof(Counter));
+  if (cnf->num_vars_ > num_vars) num_vars = cnf->num_vars_;
+  int n = num_vars, m = cnf->num_clauses_;
+  c->num_vars_ = n;
+  c->num_clauses_ = m;
+  c->value_ = (signed char*)malloc(n + 1);
+  memset(c->value_, -1, n + 1);
+  c->trail_ = (int*)malloc(sizeof(int) * (n + 1));
+  c->var_mark_ = (int*)calloc(n + 1, sizeof(int));
+  c->score_ = (int*)calloc(n + 1, sizeof(int));
+  c->queue_ = (int*)malloc(sizeof(int) * (n + 1));
+  c->clause_mark_ = (int*)calloc(m + 1, sizeof(int));
+  c->clause_buf_ = (int*)malloc(sizeof(int) * (m + 1));
+  BigNatInit(&c->ret_);
+  BigNatInit(&c->scratch_);
+
+  // Cópia normalizada: var_mark_[v] = ±(i + 1) se v já está na cláusula i
+  c->lits_ = (int*)malloc(sizeof(int) * (cnf->num_lits_ + 1));
+  c->starts_ = (size_t*)malloc(sizeof(size_t) * (m + 1));
+  size_t num_lits = 0;
+  int out = 0;
+  bool ok = true;
+  for (int i = 0; i < m; i++) {
+    const int* clause = ClauseSetClause(cnf, i);
+    int size = ClauseSetSize(cnf, i);
+    size_t begin = num_lits;
+    bool tautology = false;
+    for (int j = 0; j < size && !tautology; j++) {
+      int lit = clause[j], v = lit > 0 ? lit : -lit;
+      int mark = lit > 0 ? i + 1 : -(i + 1);
+      if (c->var_mark_[v] == -mark) tautology = true;
+      if (c->var_mark_[v] == mark) continue;
+      c->var_mark_[v] = mark;
+      c->lits_[num_lits++] = lit;
+    }
+    if (tautology) {
+      num_lits = begin;
+      continue;
+    }
+    if (num_lits == begin) ok = false;
+    c->starts_[out++] = begin;
+  }
+  c->starts_[out] = num_lits;
+  c->num_clauses_ = m = out;
+  memset(c->var_mark_, 0, sizeof(int) * (n + 1));
+
+  c->occ_start_ = (size_t*)calloc(2 * n + 3, sizeof(size_t));
+  for (size_t j = 0; j < num_lits; j++) c->occ_start_[LitIndex(c->lits_[j]) + 1]++;
+  for (int i = 1; i < 2 * n + 3; i++) c->occ_start_[i] += c->occ_start_[i - 1];
+  c->occ_ = (int*)malloc(sizeof(int) * (num_lits + 1));
+  size_t* fill = (size_t*)malloc(sizeof(size_t) * (2 * n + 2));
+  memcpy(fill, c->occ_start_, sizeof(size_t) * (2 * n + 2));
+  for (int i = 0; i < m; i++)
+    for (size_t j = c->starts_[i]; j < c->starts_[i + 1]; j++)
+      c->occ_[fill[LitIndex(c->lits_[j])]++] = i;
+  free(fill);
+
+  // Cláusulas unitárias valem antes de qualquer ramificação
+  for (int i = 0; i < m && ok; i++) {
+    if (c->starts_[i + 1] - c->starts_[i] != 1) continue;
+    int lit = c->lits_[c->starts_[i]];
+    if (LitValue(c, lit) == 0) ok = false;
+    if (LitValue(c, lit) < 0) Assign(c, lit);
+  }
+  return ok && Propagate(c, 0);
+}
+
+static void CounterFree(Counter* c) {
+  free(c->lits_);
+  free(c->starts_);
+  free(c->occ_);
+  free(c->occ_start_);
+  free(c->value_);
+  free(c->trail_);
+  free(c->var_mark_);
+  free(c->clause_mark_);
+  free(c->score_);
+  free(c->queue_);
+  free(c->clause_buf_);
+  free(c->comps_);
+  for (int i = 0; i < c->frames_cap_; i++) {
+    BigNatFree(&c->frames_[i].total_);
+    BigNatFree(&c->frames_[i].product_);
+  }
+  free(c->frames_);
+  free(c->table_);
+  free(c->keys_);
+  free(c->limbs_);
+  BigNatFree(&c->ret_);
+  BigNatFree(&c->scratch_);
+}
+
+static void PushComp(Counter* c, int value) {
+  if (c->comps_size_ == c->comps_cap_) {
+    c->comps_cap_ = c->comps_cap_ ? c->comps_cap_ * 2 : 64;
+    c->comps_ = (int*)realloc(c->comps_, sizeof(int) * c->comps_cap_);
+  }
+  c->comps_[c->comps_size_++] = value;
+}
+
+static inline int CompSize(const Counter* c, int comp) {
+  return 2 + c->comps_[comp] + c->comps_[comp + 1];
+}
+
+static int CompareInts(const void* a, const void* b) {
+  int x = *(const int*)a, y = *(const int*)b;
+  return (x > y) - (x < y);
+}
+
+// Separa as variáveis livres de `comp` em componentes conexos pelas
+// cláusulas ainda não satisfeitas e os empilha em comps_. Retorna quantas
+// variáveis livres não estão em nenhuma cláusula aberta.
+static int Split(Counter* c, int comp) {
+  int stamp = ++c->stamp_;
+  int num_vars = c->comps_[comp];
+  int free_vars = 0;
+  for (int i = 0; i < num_vars; i++) {
+    int v = c->comps_[comp + 2 + i];
+    if (c->value_[v] >= 0 || c->var_mark_[v] == stamp) continue;
+    c->var_mark_[v] = stamp;
+    int nv = 0, nc = 0;
+    c->queue_[nv++] = v;
+    for (int q = 0; q < nv; q++) {
+      int u = c->queue_[q];
+      for (int idx = 2 * u; idx <= 2 * u + 1; idx++) {
+        for (size_t k = c->occ_start_[idx]; k < c->occ_start_[idx + 1]; k++) {
+          int cl = c->occ_[k];
+          if (c->clause_mark_[cl] == stamp) continue;
+          c->clause_mark_[cl] = stamp;
+          if (ClauseSatisfied(c, cl)) continue;
+          c->clause_buf_[nc++] = cl;
+          for (size_t j = c->starts_[cl]; j < c->starts_[cl + 1]; j++) {
+            int w = c->lits_[j] > 0 ? c->lits_[j] : -c->lits_[j];
+            if (c->value_[w] >= 0 || c->var_mark_[w] == stamp) continue;
+            c->var_mark_[w] = stamp;
+            c->queue_[nv++] = w;
+          }
+        }
+      }
+    }
+    if (nc == 0) {
+      free_vars++;
+      continue;
+    }
+    qsort(c->queue_, nv, sizeof(int), CompareInts);
+    qsort(c->clause_buf_, nc, sizeof(int), CompareInts);
+    PushComp(c, nv);
+    PushComp(c, nc);
+    for (int j = 0; j < nv; j++) PushComp(c, c->queue_[j]);
+    for (int j = 0; j < nc; j++) PushComp(c, c->clause_buf_[j]);
+  }
+  return free_vars;
+}
+
+// Variável com mais ocorrências nas cláusulas abertas do componente. Em
+// codificações de Tseitin costuma ser uma porta, e fixá-la corta a
+// fórmula em componentes menores (fixar só entradas não corta cadeias).
+static int ChooseVar(Counter* c, int comp) {
+  int nv = c->comps_[comp], nc = c->comps_[comp + 1];
+  const int* vars = c->comps_ + comp + 2;
+  const int* clauses = vars + nv;
+  for (int i = 0; i < nc; i++) {
+    for (size_t j = c->starts_[clauses[i]]; j < c->starts_[clauses[i] + 1];
+         j++) {
+      int v = c->lits_[j] > 0 ? c->lits_[j] : -c->lits_[j];
+      if (c->value_[v] < 0) c->score_[v]++;
+    }
+  }
+  int max_score = 0, ties = 0;
+  for (int i = 0; i < nv; i++) {
+    if (c->score_[vars[i]] > max_score) {
+      max_score = c->score_[vars[i]];
+      ties = 0;
+    }
+    if (c->score_[vars[i]] == max_score) ties++;
+  }
+  // Entre os empates, o do meio: em cadeias (numeradas em ordem) o ramo
+  // corta o componente ao meio e a profundidade fica logarítmica
+  int best = vars[0];
+  for (int i = 0, k = 0; i < nv; i++) {
+    if (c->score_[vars[i]] == max_score && k++ == ties / 2) best = vars[i];
+  }
+  for (int i = 0; i < nv; i++) c->score_[vars[i]] = 0;
+  return best;
+}
+
+// --- Cache de Componentes ---
+
+static uint64_t HashComp(const Counter* c, int comp) {
+  const int* key = c->comps_ + comp;
+  int len = CompSize(c, comp);
+  uint64_t h = 0x9E3779B97F4A7C15ull ^ (uint64_t)len;
+  for (int i = 0; i < len; i++) {
+    h = (h ^ (uint32_t)key[i]) * 0xFF51AFD7ED558CCDull;
+    h ^= h >> 32;
+  }
+  return h;
+}
+
+static int CacheFind(const Counter* c, int comp, uint64_t hash) {
+  if (!c->table_cap_) return -1;
+  const int* key = c->comps_ + comp;
+  int len = CompSize(c, comp);
+  int mask = c->table_cap_ - 1;
+  for (int i = (int)(hash & mask);; i = (i + 1) & mask) {
+    const CacheEntry* e = &c->table_[i];
+    if (!e->key_len_) return -1;
+    if (e->hash_ == hash && e->key_len_ == len &&
+        !memcmp(c->keys_ + e->key_, key, sizeof(int) * len))
+      return i;
+  }
+}
+
+static void CacheClear(Counter* c) {
+  memset(c->table_, 0, sizeof(CacheEntry) * c->table_cap_);
+  c->table_count_ = 0;
+  c->keys_size_ = 0;
+  c->limbs_size_ = 0;
+}
+
+static void CacheInsertEntry(Counter* c, const CacheEntry* entry) {
+  int mask = c->table_cap_ - 1;
+  int i = (int)(entry->hash_ & mask);
+  while (c->table_[i].key_len_) i = (i + 1) & mask;
+  c->table_[i] = *entry;
+}
+
+static void CacheStore(Counter* c, int comp, uint64_t hash,
+                       const BigNat* count) {
+  int len = CompSize(c, comp);
+  if (c->keys_size_ + len > MODEL_COUNT_CACHE_WORDS) CacheClear(c);
+  if (2 * (c->table_count_ + 1) > c->table_cap_) {
+    CacheEntry* old = c->table_;
+    int old_cap = c->table_cap_;
+    c->table_cap_ = old_cap ? old_cap * 2 : FIRST_CACHE_CAP;
+    c->table_ = (CacheEntry*)calloc(c->table_cap_, sizeof(CacheEntry));
+    for (int i = 0; i < old_cap; i++)
+      if (old[i].key_len_) CacheInsertEntry(c, &old[i]);
+    free(old);
+  }
+  if (c->keys_size_ + len > c->keys_cap_) {
+    while (c->keys_size_ + len > c->keys_cap_)
+      c->keys_cap_ = c->keys_cap_ ? c->keys_cap_ * 2 : 4096;
+    c->keys_ = (uint32_t*)realloc(c->keys_, sizeof(uint32_t) * c->keys_cap_);
+  }
+  if (c->limbs_size_ + count->size_ > c->limbs_cap_) {
+    while (c->limbs_size_ + count->size_ > c->limbs_cap_)
+      c->limbs_cap_ = c->limbs_cap_ ? c->limbs_cap_ * 2 : 4096;
+    c->limbs_ =
+        (uint32_t*)realloc(c->limbs_, sizeof(uint32_t) * c->limbs_cap_);
+  }
+
+  CacheEntry entry;
+  entry.hash_ = hash;
+  entry.key_ = c->keys_size_;
+  entry.key_len_ = len;
+  entry.value_ = c->limbs_size_;
+  entry.value_len_ = count->size_;
+  memcpy(c->keys_ + c->keys_size_, c->comps_ + comp, sizeof(int) * len);
+  if (count->size_)
+    memcpy(c->limbs_ + c->limbs_size_, count->limbs_,
+           sizeof(uint32_t) * count->size_);
+  c->keys_size_ += len;
+  c->limbs_size_ += count->size_;
+  CacheInsertEntry(c, &entry);
+  c->table_count_++;
+}
+
+// --- Busca ---
+
+static void PushFrame(Counter* c, int comp, uint64_t hash, int var) {
+  if (c->num_frames_ == c->frames_cap_) {
+    int cap = c->frames_cap_ ? c->frames_cap_ * 2 : 64;
+    c->frames_ = (CountFrame*)realloc(c->frames_, sizeof(CountFrame) * cap);
+    for (int i = c->frames_cap_; i < cap; i++) {
+      BigNatInit(&c->frames_[i].total_);
+      BigNatInit(&c->frames_[i].product_);
+    }
+    c->frames_cap_ = cap;
+  }
+  CountFrame* f = &c->frames_[c->num_frames_++];
+  f->comp_ = comp;
+  f->hash_ = hash;
+  f->var_ = var;
+  f->branch_ = 0;
+  f->open_ = false;
+  BigNatSetU64(&f->total_, 0);
+}
+
+// product *= factor
+static void MulInto(Counter* c, BigNat* product, const BigNat* factor) {
+  BigNatMul(&c->scratch_, product, factor);
+  BigNat tmp = *product;
+  *product = c->scratch_;
+  c->scratch_ = tmp;
+}
+
+static void Step(Counter* c) {
+  CountFrame* f = &c->frames_[c->num_frames_ - 1];
+  if (f->open_) {
+    if (f->next_child_ < f->children_end_ && !BigNatIsZero(&f->product_)) {
+      int child = f->next_child_;
+      f->next_child_ += CompSize(c, child);
+      if (c->comps_[child + 1] == 1) {
+        // Uma cláusula só: falha apenas com todos os literais falsos
+        SetAllOnes(&c->ret_, c->comps_[child]);
+        MulInto(c, &f->product_, &c->ret_);
+        return;
+      }
+      uint64_t hash = HashComp(c, child);
+      int hit = CacheFind(c, child, hash);
+      if (hit >= 0) {
+        const CacheEntry* e = &c->table_[hit];
+        SetLimbs(&c->ret_, c->limbs_ + e->value_, e->value_len_);
+        MulInto(c, &f->product_, &c->ret_);
+      } else {
+        PushFrame(c, child, hash, ChooseVar(c, child));
+      }
+      return;
+    }
+    // Ramo concluído
+    BigNatAdd(&f->total_, &f->product_);
+    Undo(c, f->trail_);
+    c->comps_size_ = f->children_;
+    f->open_ = false;
+    f->branch_++;
+  }
+
+  if (f->branch_ < (f->var_ ? 2 : 1)) {
+    f->trail_ = c->trail_size_;
+    if (f->var_) {
+      Assign(c, f->branch_ == 0 ? f->var_ : -f->var_);
+      if (!Propagate(c, f->trail_)) {
+        Undo(c, f->trail_);
+        f->branch_++;
+        return;
+      }
+    }
+    f->children_ = c->comps_size_;
+    int free_vars = Split(c, f->comp_);
+    f->next_child_ = f->children_;
+    f->children_end_ = c->comps_size_;
+    BigNatSetU64(&f->product_, 1);
+    BigNatShiftLeft(&f->product_, free_vars);
+    f->open_ = true;
+    return;
+  }
+
+  // Componente concluído: a contagem sobe para o produto do pai
+  if (f->var_) CacheStore(c, f->comp_, f->hash_, &f->total_);
+  BigNat tmp = c->ret_;
+  c->ret_ = f->total_;
+  f->total_ = tmp;
+  c->num_frames_--;
+  if (c->num_frames_ > 0)
+    MulInto(c, &c->frames_[c->num_frames_ - 1].product_, &c->ret_);
+}
+
+void ModelCountClauses(const ClauseSet* cnf, int num_vars, BigNat* count) {
+  Counter c;
+  if (!CounterInit(&c, cnf, num_vars)) {
+    BigNatSetU64(count, 0);
+    CounterFree(&c);
+    return;
+  }
+  // Raiz: todas as variáveis, sem ramificação
+  PushComp(&c, c.num_vars_);
+  PushComp(&c, 0);
+  for (int v = 1; v <= c.num_vars_; v++) PushComp(&c, v);
+  PushFrame(&c, 0, 0, 0);
+  while (c.num_frames_ > 0) Step(&c);
+  BigNatCopy(count, &c.ret_);
+  CounterFree(&c);
+}
@@ -0,0 +1,79 @@
+#include "../include/model_iterator.h"
+
+#include <stdlib.h>
+
+#include "../include/cnf_encoder.h"
+#include "../include/convert_internal.h"
+#include "../include/expr_arena.h"
+#include "../include/sat_solver.h"
+
+struct ModelIterator {
+  CnfEncoding enc_;
+  SatSolver* solver_;
+  bool* model_;
+  int model_size_;
+  int* block_;  // cláusula que bloqueia o último modelo
+  bool done_;
+};
+
+ModelIterator* ModelIteratorCreate(const char* input) {
+  ExprArena arena;
+  ExprArenaInit(&arena);
+  int pos = 0;
+  PhaseMark mark = PhaseBegin(&arena);
+  ExprNode* t = ParseExpressionArena(&arena, input, &pos);
+  PhaseEnd(PHASE_PARSE, mark, &arena);
+  if (!t) {
+    ReleaseArena(&arena);
+    return NULL;
+  }
+
+  ModelIterator* it = (ModelIterator*)calloc(1, sizeof(ModelIterator));
+  mark = PhaseBegin(NULL);
+  bool encoded = EncodePlaistedGreenbaum(t, &it->enc_);
+  PhaseEnd(PHASE_ENCODE, mark, NULL);
+  ReleaseArena(&arena);
+
+  int max_var = 0;
+  for (int i = 1; i <= it->enc_.num_inputs_; i++)
+    if (it->enc_.vars_.originals_[i] > max_var)
+      max_var = it->enc_.vars_.originals_[i];
+  it->model_ = (bool*)calloc(max_var + 1, sizeof(bool));
+  it->model_size_ = max_var + 1;
+  it->block_ = (int*)malloc(sizeof(int) * (it->enc_.num_inputs_ + 1));
+  it->solver_ = SatSolverCreate();
+  it->done_ = !encoded || !SatSolverAddClauseSet(it->solver_, &it->enc_.cnf_);
+  return it;
+}
+
+void ModelIteratorDestroy(ModelIterator* it) {
+  if (!it) return;
+  CnfEncodingFree(&it->enc_);
+  SatSolverDestroy(it->solver_);
+  free(it->model_);
+  free(it->block_);
+  free(it);
+}
+
+const bool* ModelIteratorNext(ModelIterator* it, int* model_size) {
+  if (it->done_) return NULL;
+  PhaseMark mark = PhaseBegin(NULL);
+  bool sat = SatSolverSolve(it->solver_) == SAT_SATISFIABLE;
+  PhaseEnd(PHASE_SOLVE, mark, NULL);
+  if (!sat) {
+    it->done_ = true;
+    return NULL;
+  }
+
+  // As entradas ocupam 1..num_inputs_; as auxiliares não entram no
+  // bloqueio (no Plaisted-Greenbaum elas não são fixadas pelo modelo)
+  int n = it->enc_.num_inputs_;
+  for (int i = 1; i <= n; i++) {
+    bool value = SatSolverModelValue(it->solver_, i);
+    it->model_[it->enc_.vars_.originals_[i]] = value;
+    it->block_[i - 1] = value ? -i : i;
+  }
+  if (!SatSolverAddClause(it->solver_, it->block_, n)) it->done_ = true;
+  *model_size = it->model_size_;
+  return it->model_;
+}
@@ -0,0 +1,329 @@
+#include "../include/native_eval.h"
+
+#include <stdarg.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#ifndef _WIN32
+#include <dlfcn.h>
+#include <errno.h>
+#include <fcntl.h>
+#include <pthread.h>
+#include <sys/stat.h>
+#include <sys/utsname.h>
+#include <unistd.h>
+#endif
+
+#define NATIVE_SYMBOL "logica_native_eval"
+
+// Opções fixas do compilador; entram no hash junto com o código, o
+// compilador e a CPU (por causa de -march=native)
+#define NATIVE_CFLAGS "-O3 -march=native -shared -fPIC"
+
+typedef struct {
+  char* data_;
+  size_t size_;
+  size_t cap_;
+} SourceText;
+
+static void Print(SourceText* t, const char* fmt, ...) {
+  va_list args;
+  va_start(args, fmt);
+  int len = vsnprintf(NULL, 0, fmt, args);
+  va_end(args);
+  if (t->size_ + len + 1 > t->cap_) {
+    while (t->size_ + len + 1 > t->cap_)
+      t->cap_ = t->cap_ ? t->cap_ * 2 : 4096;
+    t->data_ = (char*)realloc(t->data_, t->cap_);
+  }
+  va_start(args, fmt);
+  vsnprintf(t->data_ + t->size_, len + 1, fmt, args);
+  va_end(args);
+  t->size_ += len;
+}
+
+// --- Geração de Código ---
+
+// Nome do valor atual de um slot: vN para variáveis, tN para o resultado
+// da instrução N (cada instrução ganha uma constante própria, então o
+// reuso de registradores do programa desaparece)
+static void SlotName(const BitProgram* prog, const int* writer, int slot,
+                     char* name) {
+  if (slot < prog->num_vars_)
+    sprintf(name, "v%d", slot);
+  else
+    sprintf(name, "t%d", writer[slot - prog->num_vars_]);
+}
+
+static void GenerateSource(const BitProgram* prog, SourceText* src) {
+  int nv = prog->num_vars_;
+  int* writer = (int*)malloc(sizeof(int) * (prog->num_regs_ + 1));
+  char a[24], b[24];
+
+  Print(src, "#include <stddef.h>\n#include <stdint.h>\n\n");
+  Print(src, "void " NATIVE_SYMBOL
+             "(const uint64_t* const* c, uint64_t* out, size_t n) {\n");
+  for (int v = 0; v < nv; v++)
+    Print(src, "  const uint64_t* restrict c%d = c[%d];\n", v, v);
+  Print(src, "  uint64_t* restrict o = out;\n");
+  Print(src, "  for (size_t k = 0; k < n; k++) {\n");
+  for (int v = 0; v < nv; v++)
+    Print(src, "    const uint64_t v%d = c%d[k];\n", v, v);
+
+  for (int i = 0; i < prog->size_; i++) {
+    const BitInstr* in = &prog->code_[i];
+    SlotName(prog, writer, in->a_, a);
+    if (in->op_ == BIT_NOT) {
+      Print(src, "    const uint64_t t%d = ~%s;\n", i, a);
+    } else {
+      SlotName(prog, writer, in->b_, b);
+      const char* op = in->op_ == BIT_AND   ? "&"
+                       : in->op_ == BIT_XOR ? "^"
+                                            : "|";
+      Print(src, "    const uint64_t t%d = %s%s %s %s;\n", i,
+            in->op_ == BIT_IMPLIES ? "~" : "", a, op, b);
+    }
+    writer[in->dst_ - nv] = i;
+  }
+
+  SlotName(prog, writer, prog->result_, a);
+  Print(src, "    o[k] = %s;\n  }\n}\n", a);
+  free(writer);
+}
+
+static uint64_t HashText(const char* text, size_t len) {
+  uint64_t h = 0xCBF29CE484222325ull;
+  for (size_t i = 0; i < len; i++)
+    h = (h ^ (uint8_t)text[i]) * 0x100000001B3ull;
+  return h;
+}
+
+// --- Compilação e Carga ---
+
+#ifndef _WIN32
+
+// Só se carrega o que ninguém além do usuário efetivo pode ter escrito:
+// dono igual e sem escrita para grupo e outros
+static bool IsPrivate(const struct stat* st) {
+  return st->st_uid == geteuid() && !(st->st_mode & (S_IWGRP | S_IWOTH));
+}
+
+// Diretório das bibliotecas em path, criado com modo 0700 se preciso. Sem
+// cache_dir nem LOGICA_NATIVE_CACHE é $TMPDIR/logica-<uid> (ou
+// /tmp/logica-<uid>), nunca o diretório temporário compartilhado em si;
+// esse não pode ser um link simbólico. Retorna false se o diretório não
+// for privado (a avaliação fica com o interpretador).
+static bool CacheDirectory(const char* cache_dir, char* path, size_t size) {
+  const char* dir = cache_dir ? cache_dir : getenv("LOGICA_NATIVE_CACHE");
+  bool chosen = dir && *dir;
+  if (chosen) {
+    snprintf(path, size, "%s", dir);
+  } else {
+    dir = getenv("TMPDIR");
+    snprintf(path, size, "%s/logica-%lu", dir && *dir ? dir : "/tmp",
+             (unsigned long)geteuid());
+  }
+  if (mkdir(path, 0700) != 0 && errno != EEXIST) return false;
+  struct stat st;
+  int status = chosen ? stat(path, &st) : lstat(path, &st);
+  return status == 0 && S_ISDIR(st.st_mode) && IsPrivate(&st);
+}
+
+// O código guardado ao lado da biblioteca precisa ser igual ao gerado: o
+// nome vem de um hash de 64 bits, que não distingue todas as sentenças
+static bool SameSource(const char* path, const SourceText* src) {
+  int fd = open(path, O_RDONLY | O_NOFOLLOW);
+  if (fd < 0) return false;
+  struct stat st;
+  bool same = fstat(fd, &st) == 0 && S_ISREG(st.st_mode) && IsPrivate(&st) &&
+              (size_t)st.st_size == src->size_;
+  char buffer[4096];
+  size_t done = 0;
+  while (same && done < src->size_) {
+    ssize_t n = read(fd, buffer, sizeof(buffer));
+    same = n > 0 && (size_t)n <= src->size_ - done &&
+           memcmp(buffer, src->data_ + done, (size_t)n) == 0;
+    if (same) done += (size_t)n;
+  }
+  close(fd);
+  return same;
+}
+
+static bool LoadNative(const char* path, NativeEval* eval) {
+  struct stat st;
+  if (lstat(path, &st) != 0 || !S_ISREG(st.st_mode) || !IsPrivate(&st))
+    return false;
+  void* library = dlopen(path, RTLD_NOW | RTLD_LOCAL);
+  if (!library) return false;
+  void* symbol = dlsym(library, NATIVE_SYMBOL);
+  if (!symbol) {
+    dlclose(library);
+    return false;
+  }
+  eval->library_ = library;
+  // Conversão de ponteiro de dados para função (idioma POSIX)
+  *(void**)&eval->fn_ = symbol;
+  return true;
+}
+
+// Compila src em <base>.so e guarda o código em <base>.c. Os dois são
+// escritos com nomes temporários únicos e renomeados no fim, então
+// processos e threads que compilam a mesma sentença ao mesmo tempo não se
+// atrapalham.
+static bool CompileLibrary(const SourceText* src, const char* cc,
+                           const char* base) {
+  size_t len = strlen(base) + 16;
+  char* source_path = (char*)malloc(len);
+  snprintf(source_path, len, "%s-XXXXXX.c", base);
+  int fd = mkstemps(source_path, 2);
+  if (fd < 0) {
+    free(source_path);
+    return false;
+  }
+  FILE* f = fdopen(fd, "w");
+  bool ok = f && fwrite(src->data_, 1, src->size_, f) == src->size_;
+  if (f) ok = fclose(f) == 0 && ok;
+
+  char* temp_path = (char*)malloc(len);
+  snprintf(temp_path, len, "%.*s.so", (int)(strlen(source_path) - 2),
+           source_path);
+  char* final_path = (char*)malloc(len);
+  if (ok) {
+    size_t cmd_len = strlen(cc) + strlen(source_path) + strlen(temp_path) +
+                     sizeof(NATIVE_CFLAGS) + 64;
+    char* cmd = (char*)malloc(cmd_len);
+    snprintf(cmd, cmd_len,
+             "%s " NATIVE_CFLAGS " -o '%s' '%s' >/dev/null 2>&1", cc,
+             temp_path, source_path);
+    // A umask pode ter deixado a biblioteca gravável pelo grupo
+    ok = system(cmd) == 0 && chmod(temp_path, 0700) == 0;
+    snprintf(final_path, len, "%s.so", base);
+    ok = ok && rename(temp_path, final_path) == 0;
+    snprintf(final_path, len, "%s.c", base);
+    ok = ok && rename(source_path, final_path) == 0;
+    free(cmd);
+  }
+  remove(temp_path);
+  remove(source_path);
+  free(final_path);
+  free(temp_path);
+  free(source_path);
+  return ok;
+}
+
+// Identificação da CPU (arquitetura e, no Linux, modelo e extensões de
+// /proc/cpuinfo): com -march=native, um diretório compartilhado entre
+// máquinas não pode entregar código com instruções que esta não tem
+static uint64_t g_host_hash;
+static pthread_once_t g_host_once = PTHREAD_ONCE_INIT;
+
+static void ComputeHostHash(void) {
+  struct utsname name;
+  uint64_t h = 0xCBF29CE484222325ull;
+  if (uname(&name) == 0) h = HashText(name.machine, strlen(name.machine));
+  FILE* f = fopen("/proc/cpuinfo", "r");
+  if (f) {
+    static const char* const keys[] = {"model name", "flags", "Features",
+                                       "CPU implementer", "CPU part", "isa"};
+    char* line = NULL;
+    size_t cap = 0;
+    ssize_t len;
+    // Só o primeiro processador
+    while ((len = getline(&line, &cap, f)) > 1) {
+      for (size_t k = 0; k < sizeof(keys) / sizeof(keys[0]); k++)
+        if (!strncmp(line, keys[k], strlen(keys[k])))
+          h = (h ^ HashText(line, (size_t)len)) * 0x100000001B3ull;
+    }
+    free(line);
+    fclose(f);
+  }
+  g_host_hash = h;
+}
+
+static void CompileNative(const SourceText* src, const char* cache_dir,
+                          NativeEval* eval) {
+  const char* cc = getenv("CC");
+  if (!cc || !*cc) cc = "cc";
+  // O compilador, as opções e a CPU também distinguem as bibliotecas
+  pthread_once(&g_host_once, ComputeHostHash);
+  uint64_t hash = HashText(src->data_, src->size_);
+  hash = (hash ^ HashText(cc, strlen(cc))) * 0x100000001B3ull;
+  hash = (hash ^ HashText(NATIVE_CFLAGS, sizeof(NATIVE_CFLAGS) - 1)) *
+         0x100000001B3ull;
+  hash = (hash ^ g_host_hash) * 0x100000001B3ull;
+  eval->hash_ = hash;
+
+  char dir[4096];
+  if (!CacheDirectory(cache_dir, dir, sizeof(dir))) return;
+  size_t len = strlen(dir) + 64;
+  char* base = (char*)malloc(len);
+  char* path = (char*)malloc(len);
+  snprintf(base, len, "%s/logica-%016llx", dir, (unsigned long long)hash);
+  char* so_path = (char*)malloc(len);
+  snprintf(path, len, "%s.c", base);
+  snprintf(so_path, len, "%s.so", base);
+  // Sem o código igual ou sem uma biblioteca aceitável, compila de novo
+  if (!(SameSource(path, src) && LoadNative(so_path, eval)) &&
+      CompileLibrary(src, cc, base) && SameSource(path, src))
+    LoadNative(so_path, eval);
+  free(so_path);
+  free(path);
+  free(base);
+}
+
+#endif  // _WIN32
+
+bool NativeEvalCompile(const ExprNode* root, const char* cache_dir,
+                       NativeEval* eval) {
+  eval->fn_ = NULL;
+  eval->library_ = NULL;
+  eval->hash_ = 0;
+  if (!BitProgramCompile(root, &eval->prog_)) return false;
+  if (eval->prog_.size_ > NATIVE_EVAL_MAX_INSTRS) return true;
+
+  SourceText src = {NULL, 0, 0};
+  GenerateSource(&eval->prog_, &src);
+#ifndef _WIN32
+  CompileNative(&src, cache_dir, eval);
+#else
+  (void)cache_dir;
+  eval->hash_ = HashText(src.data_, src.size_);
+#endif
+  free(src.data_);
+  return true;
+}
+
+void NativeEvalFree(NativeEval* eval) {
+#ifndef _WIN32
+  if (eval->library_) dlclose(eval->library_);
+#endif
+  eval->library_ = NULL;
+  eval->fn_ = NULL;
+  BitProgramFree(&eval->prog_);
+}
+
+// --- Avaliação ---
+
+void NativeEvalRun(const NativeEval* eval, const uint64_t* const* columns,
+                   uint64_t* out, size_t num_words) {
+  if (eval->fn_) {
+    eval->fn_(columns, out, num_words);
+    return;
+  }
+
+  // Interpretador: blocos de BIT_BLOCK_WORDS palavras
+  const BitProgram* prog = &eval->prog_;
+  int nv = prog->num_vars_;
+  BitBlock* slots =
+      (BitBlock*)calloc(nv + prog->num_regs_ + 1, sizeof(BitBlock));
+  for (size_t base = 0; base < num_words; base += BIT_BLOCK_WORDS) {
+    size_t n = num_words - base;
+    if (n > BIT_BLOCK_WORDS) n = BIT_BLOCK_WORDS;
+    for (int v = 0; v < nv; v++)
+      memcpy(slots[v].w_, columns[v] + base, n * sizeof(uint64_t));
+    const BitBlock* res = BitProgramEvalBlock(prog, slots);
+    memcpy(out + base, res->w_, n * sizeof(uint64_t));
+  }
+  free(slots);
+}
@@ -0,0 +1,852 @@
+#include "../include/preprocess.h"
+
+#include <stdint.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "../include/convert_internal.h"
+#include "../include/expr_arena.h"
+
+// --- Representação Interna ---
+// Literais em DIMACS; listas por literal indexadas por 2 * v + (1 se
+// negado). Cláusulas removidas só são marcadas e saem das listas de
+// ocorrência quando estas são percorridas (Occ); num_occ_ conta só as
+// vivas.
+
+typedef struct {
+  int* data_;
+  int size_;
+  int cap_;
+} IntVec;
+
+static void IntVecPush(IntVec* v, int x) {
+  if (v->size_ == v->cap_) {
+    v->cap_ = v->cap_ ? v->cap_ * 2 : 16;
+    v->data_ = (int*)realloc(v->data_, sizeof(int) * v->cap_);
+  }
+  v->data_[v->size_++] = x;
+}
+
+typedef struct {
+  int num_vars_;
+  bool ok_;
+
+  // Cláusula c: lits_[start_[c] .. start_[c] + size_[c] - 1]; remoções de
+  // literais encolhem a cláusula no lugar
+  int* lits_;
+  size_t num_lits_;
+  size_t lits_cap_;
+  size_t* start_;
+  int* size_;
+  bool* removed_;
+  bool* queued_;    // na fila de subsunção
+  uint64_t* sig_;   // bit (v % 64) de cada variável v da cláusula
+  int num_clauses_;
+  int clauses_cap_;
+
+  IntVec* occ_;         // cláusulas que contêm cada literal (em pool_)
+  int* num_occ_;        // cláusulas vivas com cada literal
+  signed char* value_;  // por variável: 1, -1 ou 0 (livre)
+  bool* removed_var_;   // substituída ou eliminada
+  bool* touched_;       // ocorrências mudaram desde a última eliminação
+  int* mark_;           // carimbo por literal
+  int stamp_;
+
+  IntVec trail_;  // literais fixados, propagados até qhead_
+  int qhead_;
+  IntVec subsume_;  // cláusulas novas ou encolhidas a testar
+  IntVec scratch_;
+
+  // Blocos das listas de ocorrência: uma lista que cresce passa para um
+  // bloco novo e abandona o antigo; tudo é liberado junto no fim
+  int** pool_;
+  int num_pool_;
+  int pool_cap_;
+  int pool_used_;   // posições ocupadas no último bloco
+  int pool_avail_;  // tamanho do último bloco
+
+  CnfReconstruction* rec_;
+} Simplifier;
+
+static inline int LitIndex(int lit) {
+  return lit > 0 ? 2 * lit : -2 * lit + 1;
+}
+
+static inline int LitVar(int lit) { return lit > 0 ? lit : -lit; }
+
+static inline int* ClauseLits(Simplifier* s, int c) {
+  return s->lits_ + s->start_[c];
+}
+
+#define POOL_CHUNK (1 << 12)
+
+static void OccPush(Simplifier* s, int lit, int c) {
+  IntVec* occ = &s->occ_[LitIndex(lit)];
+  if (occ->size_ == occ->cap_) {
+    int cap = occ->cap_ ? occ->cap_ * 2 : 4;
+    if (s->pool_used_ + cap > s->pool_avail_) {
+      if (s->num_pool_ == s->pool_cap_) {
+        s->pool_cap_ = s->pool_cap_ ? s->pool_cap_ * 2 : 16;
+        s->pool_ = (int**)realloc(s->pool_, sizeof(int*) * s->pool_cap_);
+      }
+      s->pool_avail_ = cap > POOL_CHUNK ? cap : POOL_CHUNK;
+      s->pool_[s->num_pool_++] = (int*)malloc(sizeof(int) * s->pool_avail_);
+      s->pool_used_ = 0;
+    }
+    int* data = s->pool_[s->num_pool_ - 1] + s->pool_used_;
+    s->pool_used_ += cap;
+    if (occ->size_) memcpy(data, occ->data_, sizeof(int) * occ->size_);
+    occ->data_ = data;
+    occ->cap_ = cap;
+  }
+  occ->data_[occ->size_++] = c;
+}
+
+static void UpdateSignature(Simplifier* s, int c) {
+  const int* lits = ClauseLits(s, c);
+  uint64_t sig = 0;
+  for (int i = 0; i < s->size_[c]; i++) sig |= 1ull << (LitVar(lits[i]) & 63);
+  s->sig_[c] = sig;
+}
+
+static void RemoveClause(Simplifier* s, int c) {
+  if (s->removed_[c]) return;
+  s->removed_[c] = true;
+  const int* lits = ClauseLits(s, c);
+  for (int i = 0; i < s->size_[c]; i++) {
+    s->num_occ_[LitIndex(lits[i])]--;
+    s->touched_[LitVar(lits[i])] = true;
+  }
+}
+
+// Cláusulas vivas com l (limpa as removidas da lista)
+static IntVec* Occ(Simplifier* s, int lit) {
+  IntVec* occ = &s->occ_[LitIndex(lit)];
+  int j = 0;
+  for (int i = 0; i < occ->size_; i++)
+    if (!s->removed_[occ->data_[i]]) occ->data_[j++] = occ->data_[i];
+  occ->size_ = j;
+  return occ;
+}
+
+// --- Reconstrução ---
+
+static void PushReconstruction(Simplifier* s, int witness, const int* lits,
+                               int size) {
+  ClauseSet* stack = &s->rec_->clauses_;
+  ClauseSetPushLit(stack, witness);
+  for (int i = 0; i < size; i++)
+    if (lits[i] != witness) ClauseSetPushLit(stack, lits[i]);
+  ClauseSetEndClause(stack);
+}
+
+void CnfReconstructModel(const CnfReconstruction* rec, bool* model) {
+  const ClauseSet* stack = &rec->clauses_;
+  // Do topo para a base: cada cláusula foi removida de uma CNF que já não
+  // tinha as variáveis das remoções posteriores
+  for (int i = stack->num_clauses_ - 1; i >= 0; i--) {
+    const int* lits = ClauseSetClause(stack, i);
+    int size = ClauseSetSize(stack, i);
+    bool sat = false;
+    for (int j = 0; j < size && !sat; j++)
+      sat = model[LitVar(lits[j])] == (lits[j] > 0);
+    if (!sat) model[LitVar(lits[0])] = lits[0] > 0;
+  }
+}
+
+void CnfReconstructionFree(CnfReconstruction* rec) {
+  ClauseSetFree(&rec->clauses_);
+  rec->removed_vars_ = 0;
+}
+
+// --- Cláusulas e Propagação ---
+
+static void Assign(Simplifier* s, int lit) {
+  int v = LitVar(lit);
+  signed char val = lit > 0 ? 1 : -1;
+  if (s->value_[v] == val) return;
+  if (s->value_[v] == -val) {
+    s->ok_ = false;
+    return;
+  }
+  s->value_[v] = val;
+  s->rec_->removed_vars_++;
+  PushReconstruction(s, lit, NULL, 0);
+  IntVecPush(&s->trail_, lit);
+}
+
+static void QueueSubsume(Simplifier* s, int c) {
+  if (s->queued_[c]) return;
+  s->queued_[c] = true;
+  IntVecPush(&s->subsume_, c);
+}
+
+// Literais distintos e sem l e nl; unidades viram atribuições
+static void AddClause(Simplifier* s, const int* lits, int size) {
+  if (size == 0) {
+    s->ok_ = false;
+    return;
+  }
+  if (size == 1) {
+    Assign(s, lits[0]);
+    return;
+  }
+  if (s->num_clauses_ == s->clauses_cap_) {
+    s->clauses_cap_ = s->clauses_cap_ ? s->clauses_cap_ * 2 : 64;
+    int cap = s->clauses_cap_;
+    s->start_ = (size_t*)realloc(s->start_, sizeof(size_t) * cap);
+    s->size_ = (int*)realloc(s->size_, sizeof(int) * cap);
+    s->removed_ = (bool*)realloc(s->removed_, sizeof(bool) * cap);
+    s->queued_ = (bool*)realloc(s->queued_, sizeof(bool) * cap);
+    s->sig_ = (uint64_t*)realloc(s->sig_, sizeof(uint64_t) * cap);
+  }
+  if (s->num_lits_ + size > s->lits_cap_) {
+    while (s->num_lits_ + size > s->lits_cap_)
+      s->lits_cap_ = s->lits_cap_ ? s->lits_cap_ * 2 : 64;
+    s->lits_ = (int*)realloc(s->lits_, sizeof(int) * s->lits_cap_);
+  }
+  int c = s->num_clauses_++;
+  s->start_[c] = s->num_lits_;
+  s->size_[c] = size;
+  s->removed_[c] = false;
+  s->queued_[c] = false;
+  memcpy(s->lits_ + s->num_lits_, lits, sizeof(int) * size);
+  s->num_lits_ += size;
+  for (int i = 0; i < size; i++) {
+    OccPush(s, lits[i], c);
+    s->num_occ_[LitIndex(lits[i])]++;
+    s->touched_[LitVar(lits[i])] = true;
+  }
+  UpdateSignature(s, c);
+  QueueSubsume(s, c);
+}
+
+// Tira lit da cláusula c; com update_occ também tira c de occ_[lit] (senão
+// o chamador limpa a lista inteira)
+static void RemoveLiteral(Simplifier* s, int c, int lit, bool update_occ) {
+  int* lits = ClauseLits(s, c);
+  int j = 0;
+  for (int i = 0; i < s->size_[c]; i++)
+    if (lits[i] != lit) lits[j++] = lits[i];
+  s->size_[c] = j;
+  s->num_occ_[LitIndex(lit)]--;
+  UpdateSignature(s, c);
+  for (int i = 0; i < j; i++) s->touched_[LitVar(lits[i])] = true;
+  if (update_occ) {
+    IntVec* occ = &s->occ_[LitIndex(lit)];
+    for (int i = 0; i < occ->size_; i++) {
+      if (occ->data_[i] == c) {
+        occ->data_[i] = occ->data_[--occ->size_];
+        break;
+      }
+    }
+  }
+  if (j == 0)
+    s->ok_ = false;
+  else if (j == 1)
+    Assign(s, lits[0]);  // a propagação remove c, já satisfeita
+  else
+    QueueSubsume(s, c);
+}
+
+static void Propagate(Simplifier* s) {
+  while (s->ok_ && s->qhead_ < s->trail_.size_) {
+    int lit = s->trail_.data_[s->qhead_++];
+    IntVec* sat = &s->occ_[LitIndex(lit)];
+    for (int i = 0; i < sat->size_; i++) RemoveClause(s, sat->data_[i]);
+    sat->size_ = 0;
+    IntVec* falsified = &s->occ_[LitIndex(-lit)];
+    for (int i = 0; i < falsified->size_ && s->ok_; i++) {
+      int c = falsified->data_[i];
+      if (!s->removed_[c]) RemoveLiteral(s, c, -lit, false);
+    }
+    falsified->size_ = 0;
+  }
+}
+
+// --- Literais Equivalentes ---
+
+// Reescreve a cláusula c trocando cada variável v com repl[v] != 0 por
+// esse literal (e nv por -repl[v])
+static void RewriteClause(Simplifier* s, int c, const int* repl) {
+  // Carimbos: original = a cláusula antes, kept = literais já escritos
+  s->stamp_ += 2;
+  int original = s->stamp_ - 1, kept = s->stamp_;
+  int* lits = ClauseLits(s, c);
+  int size = s->size_[c];
+  for (int i = 0; i < size; i++) {
+    s->mark_[LitIndex(lits[i])] = original;
+    s->num_occ_[LitIndex(lits[i])]--;
+  }
+
+  int j = 0;
+  for (int i = 0; i < size; i++) {
+    int lit = lits[i];
+    int r = repl[LitVar(lit)];
+    if (r) lit = lit > 0 ? r : -r;
+    int* mark = &s->mark_[LitIndex(lit)];
+    if (*mark == kept) continue;
+    if (s->mark_[LitIndex(-lit)] == kept) {
+      s->removed_[c] = true;  // tautologia; as contagens já saíram
+      for (int k = 0; k < size; k++) s->touched_[LitVar(lits[k])] = true;
+      return;
+    }
+    if (*mark != original) OccPush(s, lit, c);
+    *mark = kept;
+    lits[j++] = lit;
+  }
+  s->size_[c] = j;
+  for (int i = 0; i < j; i++) {
+    s->num_occ_[LitIndex(lits[i])]++;
+    s->touched_[LitVar(lits[i])] = true;
+  }
+  UpdateSignature(s, c);
+  if (j == 1)
+    Assign(s, lits[0]);
+  else
+    QueueSubsume(s, c);
+}
+
+// Componentes fortemente conexos do grafo de implicações (a v b dá as
+// arestas na -> b e nb -> a), por Tarjan iterativo: os literais de um
+// componente são equivalentes e o da menor variável substitui os demais.
+// Um componente com l e nl prova a CNF insatisfatível.
+static bool SubstituteEquivalences(Simplifier* s) {
+  int num_edges = 0;
+  for (int c = 0; c < s->num_clauses_; c++)
+    if (!s->removed_[c] && s->size_[c] == 2) num_edges += 2;
+  if (num_edges == 0) return false;
+  int n = 2 * (s->num_vars_ + 1);
+  int* offset = (int*)calloc(n + 1, sizeof(int));
+  for (int c = 0; c < s->num_clauses_; c++) {
+    if (s->removed_[c] || s->size_[c] != 2) continue;
+    const int* lits = ClauseLits(s, c);
+    offset[LitIndex(-lits[0])]++;
+    offset[LitIndex(-lits[1])]++;
+  }
+  for (int i = 1; i <= n; i++) offset[i] += offset[i - 1];
+  int* edges = (int*)malloc(sizeof(int) * num_edges);
+  for (int c = 0; c < s->num_clauses_; c++) {
+    if (s->removed_[c] || s->size_[c] != 2) continue;
+    const int* lits = ClauseLits(s, c);
+    edges[--offset[LitIndex(-lits[0])]] = LitIndex(lits[1]);
+    edges[--offset[LitIndex(-lits[1])]] = LitIndex(lits[0]);
+  }
+
+  int* index = (int*)malloc(sizeof(int) * n);
+  int* low = (int*)malloc(sizeof(int) * n);
+  bool* on_stack = (bool*)calloc(n, sizeof(bool));
+  int* call_node = (int*)malloc(sizeof(int) * n);
+  int* call_edge = (int*)malloc(sizeof(int) * n);
+  int* repl = (int*)calloc(s->num_vars_ + 1, sizeof(int));
+  IntVec comp = {NULL, 0, 0};
+  for (int i = 0; i < n; i++) index[i] = -1;
+  int counter = 0;
+  bool changed = false;
+
+  for (int root = 2; root < n && s->ok_; root++) {
+    if (index[root] >= 0) continue;
+    int depth = 0;
+    call_node[0] = root;
+    call_edge[0] = offset[root];
+    index[root] = low[root] = counter++;
+    IntVecPush(&comp, root);
+    on_stack[root] = true;
+    while (depth >= 0) {
+      int u = call_node[depth];
+      if (call_edge[depth] < offset[u + 1]) {
+        int w = edges[call_edge[depth]++];
+        if (index[w] < 0) {
+          index[w] = low[w] = counter++;
+          IntVecPush(&comp, w);
+          on_stack[w] = true;
+          depth++;
+          call_node[depth] = w;
+          call_edge[depth] = offset[w];
+        } else if (on_stack[w] && index[w] < low[u]) {
+          low[u] = index[w];
+        }
+        continue;
+      }
+      if (low[u] == index[u]) {
+        int first = comp.size_ - 1;
+        while (comp.data_[first] != u) first--;
+        int rep = 0;
+        for (int k = first; k < comp.size_; k++) {
+          int lit = comp.data_[k] & 1 ? -(comp.data_[k] >> 1)
+                                      : comp.data_[k] >> 1;
+          on_stack[comp.data_[k]] = false;
+          if (!rep || LitVar(lit) < LitVar(rep)) rep = lit;
+        }
+        for (int k = first; k < comp.size_ && comp.size_ - first > 1; k++) {
+          int lit = comp.data_[k] & 1 ? -(comp.data_[k] >> 1)
+                                      : comp.data_[k] >> 1;
+          if (lit == rep) continue;
+          if (LitVar(lit) == LitVar(rep)) {
+            s->ok_ = false;
+          } else if (!repl[LitVar(lit)]) {
+            // O componente espelho (negações) dá a mesma substituição
+            repl[LitVar(lit)] = lit > 0 ? rep : -rep;
+            changed = true;
+          }
+        }
+        comp.size_ = first;
+      }
+      depth--;
+      if (depth >= 0 && low[u] < low[call_node[depth]])
+        low[call_node[depth]] = low[u];
+    }
+  }
+
+  // As equivalências entram na pilha antes das unidades que a reescrita
+  // pode fixar, para serem reconstruídas depois delas
+  for (int v = 1; v <= s->num_vars_ && s->ok_ && changed; v++) {
+    if (!repl[v]) continue;
+    int eq[2] = {v, -repl[v]};
+    PushReconstruction(s, v, eq, 2);
+    eq[0] = -v;
+    eq[1] = repl[v];
+    PushReconstruction(s, -v, eq, 2);
+    s->removed_var_[v] = true;
+    s->rec_->removed_vars_++;
+  }
+  for (int v = 1; v <= s->num_vars_ && s->ok_ && changed; v++) {
+    if (!repl[v]) continue;
+    for (int sign = 0; sign < 2; sign++) {
+      IntVec* occ = Occ(s, sign ? -v : v);
+      for (int i = 0; i < occ->size_; i++)
+        if (!s->removed_[occ->data_[i]]) RewriteClause(s, occ->data_[i], repl);
+      occ->size_ = 0;
+    }
+  }
+
+  free(comp.data_);
+  free(repl);
+  free(call_edge);
+  free(call_node);
+  free(on_stack);
+  free(low);
+  free(index);
+  free(edges);
+  free(offset);
+  Propagate(s);
+  return changed;
+}
+
+// --- Subsunção ---
+
+// Para cada cláusula c da fila, as candidatas vêm das ocorrências da
+// variável de c com menos ocorrências: se c está contida em d, d sai; se c
+// está contida em d a menos do sinal de um literal l, a resolução de c com
+// d é d sem nl, que fica no lugar de d
+static bool Subsume(Simplifier* s) {
+  bool changed = false;
+  IntVec cands = {NULL, 0, 0};
+  for (int q = 0; q < s->subsume_.size_ && s->ok_; q++) {
+    int c = s->subsume_.data_[q];
+    s->queued_[c] = false;
+    if (s->removed_[c]) continue;
+    const int* lits = ClauseLits(s, c);
+    int size = s->size_[c];
+    int pivot = 0, best = 0;
+    for (int i = 0; i < size; i++) {
+      int count = s->num_occ_[LitIndex(lits[i])] +
+                  s->num_occ_[LitIndex(-lits[i])];
+      if (!pivot || count < best) {
+        pivot = lits[i];
+        best = count;
+      }
+    }
+    if (best > PREPROCESS_SUBSUME_MAX_OCC) continue;
+
+    // Cópia: a remoção de literais mexe nas listas de ocorrência
+    cands.size_ = 0;
+    for (int sign = 0; sign < 2; sign++) {
+      const IntVec* occ = Occ(s, sign ? -pivot : pivot);
+      for (int i = 0; i < occ->size_; i++) IntVecPush(&cands, occ->data_[i]);
+    }
+    int stamp = ++s->stamp_;
+    for (int i = 0; i < size; i++) s->mark_[LitIndex(lits[i])] = stamp;
+
+    for (int i = 0; i < cands.size_ && s->ok_ && !s->removed_[c]; i++) {
+      int d = cands.data_[i];
+      if (d == c || s->removed_[d] || s->size_[d] < size ||
+          (s->sig_[c] & ~s->sig_[d]))
+        continue;
+      const int* other = ClauseLits(s, d);
+      int match = 0, flipped = 0, num_flipped = 0;
+      for (int j = 0; j < s->size_[d] && num_flipped <= 1; j++) {
+        if (s->mark_[LitIndex(other[j])] == stamp) {
+          match++;
+        } else if (s->mark_[LitIndex(-other[j])] == stamp) {
+          flipped = other[j];
+          num_flipped++;
+        }
+      }
+      if (match == size) {
+        RemoveClause(s, d);
+        changed = true;
+      } else if (match == size - 1 && num_flipped == 1) {
+        RemoveLiteral(s, d, flipped, true);
+        changed = true;
+      }
+    }
+  }
+  s->subsume_.size_ = 0;
+  free(cands.data_);
+  Propagate(s);
+  return changed;
+}
+
+// --- Eliminação de Variáveis ---
+
+// Tamanho do resolvente de a e b em v (a v A, nv v B), ou -1 se for
+// tautologia; os literais de a estão marcados com stamp. Com out != NULL
+// o resolvente vai para out, precedido pelo tamanho.
+static int Resolve(Simplifier* s, int a, int b, int v, int stamp,
+                   IntVec* out) {
+  const int* lits_b = ClauseLits(s, b);
+  int size = s->size_[a] - 1;
+  for (int k = 0; k < s->size_[b]; k++) {
+    if (lits_b[k] == -v) continue;
+    if (s->mark_[LitIndex(-lits_b[k])] == stamp) return -1;
+    if (s->mark_[LitIndex(lits_b[k])] != stamp) size++;
+  }
+  if (out) {
+    const int* lits_a = ClauseLits(s, a);
+    IntVecPush(out, size);
+    for (int k = 0; k < s->size_[a]; k++)
+      if (lits_a[k] != v) IntVecPush(out, lits_a[k]);
+    for (int k = 0; k < s->size_[b]; k++)
+      if (lits_b[k] != -v && s->mark_[LitIndex(lits_b[k])] != stamp)
+        IntVecPush(out, lits_b[k]);
+  }
+  return size;
+}
+
+// Troca as cláusulas com v pelos resolventes não tautológicos de cada par
+// (v v A, nv v B) -> (A v B), se não forem mais numerosos nem tiverem mais
+// literais que elas e nenhum passar de PREPROCESS_MAX_RESOLVENT literais.
+// Literal puro: fixado.
+static bool TryEliminate(Simplifier* s, int v) {
+  IntVec* pos = Occ(s, v);
+  IntVec* neg = Occ(s, -v);
+  int num_pos = pos->size_, num_neg = neg->size_;
+  if (num_pos == 0 && num_neg == 0) return false;
+  if (num_pos == 0 || num_neg == 0) {
+    Assign(s, num_pos ? v : -v);
+    Propagate(s);
+    return true;
+  }
+  if (num_pos + num_neg > PREPROCESS_ELIM_MAX_OCC) return false;
+
+  // Primeiro só a contagem: a maioria das tentativas desiste
+  int budget = 0, count = 0, num_lits = 0;
+  for (int i = 0; i < num_pos; i++) budget += s->size_[pos->data_[i]];
+  for (int j = 0; j < num_neg; j++) budget += s->size_[neg->data_[j]];
+  for (int i = 0; i < num_pos; i++) {
+    int a = pos->data_[i];
+    int stamp = ++s->stamp_;
+    const int* lits = ClauseLits(s, a);
+    for (int k = 0; k < s->size_[a]; k++) s->mark_[LitIndex(lits[k])] = stamp;
+    for (int j = 0; j < num_neg; j++) {
+      int size = Resolve(s, a, neg->data_[j], v, stamp, NULL);
+      if (size < 0) continue;
+      num_lits += size;
+      if (size > PREPROCESS_MAX_RESOLVENT || ++count > num_pos + num_neg ||
+          num_lits > budget)
+        return false;
+    }
+  }
+
+  // Resolventes em scratch_ antes de AddClause realocar lits_
+  IntVec* res = &s->scratch_;
+  res->size_ = 0;
+  for (int i = 0; i < num_pos; i++) {
+    int a = pos->data_[i];
+    int stamp = ++s->stamp_;
+    const int* lits = ClauseLits(s, a);
+    for (int k = 0; k < s->size_[a]; k++) s->mark_[LitIndex(lits[k])] = stamp;
+    for (int j = 0; j < num_neg; j++)
+      Resolve(s, a, neg->data_[j], v, stamp, res);
+  }
+
+  for (int sign = 0; sign < 2; sign++) {
+    const IntVec* occ = sign ? neg : pos;
+    for (int i = 0; i < occ->size_; i++) {
+      int c = occ->data_[i];
+      PushReconstruction(s, sign ? -v : v, ClauseLits(s, c), s->size_[c]);
+      RemoveClause(s, c);
+    }
+  }
+  pos->size_ = 0;
+  neg->size_ = 0;
+  s->removed_var_[v] = true;
+  s->rec_->removed_vars_++;
+  for (int k = 0; k < res->size_ && s->ok_; k += res->data_[k] + 1)
+    AddClause(s, res->data_ + k + 1, res->data_[k]);
+  Propagate(s);
+  return true;
+}
+
+typedef struct {
+  long long cost_;
+  int var_;
+} ElimCandidate;
+
+static int CompareCandidates(const void* a, const void* b) {
+  const ElimCandidate* x = (const ElimCandidate*)a;
+  const ElimCandidate* y = (const ElimCandidate*)b;
+  if (x->cost_ != y->cost_)
+    return (x->cost_ > y->cost_) - (x->cost_ < y->cost_);
+  return (x->var_ > y->var_) - (x->var_ < y->var_);
+}
+
+// Variáveis tocadas desde a última passada, em ordem crescente de
+// |ocorrências de v| * |de nv|; os literais puros são fixados já na coleta
+static bool EliminateVariables(Simplifier* s) {
+  ElimCandidate* cands =
+      (ElimCandidate*)malloc(sizeof(ElimCandidate) * (s->num_vars_ + 1));
+  int num_cands = 0;
+  bool changed = false;
+  for (int v = 1; v <= s->num_vars_ && s->ok_; v++) {
+    if (!s->touched_[v]) continue;
+    s->touched_[v] = false;
+    if (s->value_[v] || s->removed_var_[v]) continue;
+    int num_pos = s->num_occ_[LitIndex(v)];
+    int num_neg = s->num_occ_[LitIndex(-v)];
+    if (num_pos && num_neg) {
+      if (num_pos + num_neg <= PREPROCESS_ELIM_MAX_OCC) {
+        cands[num_cands].cost_ = (long long)num_pos * num_neg;
+        cands[num_cands++].var_ = v;
+      }
+    } else if (num_pos || num_neg) {
+      Assign(s, num_pos ? v : -v);
+      Propagate(s);
+      changed = true;
+    }
+  }
+  qsort(cands, num_cands, sizeof(ElimCandidate), CompareCandidates);
+
+  for (int i = 0; i < num_cands && s->ok_; i++) {
+    int v = cands[i].var_;
+    if (s->value_[v] || s->removed_var_[v]) continue;
+    if (TryEliminate(s, v)) changed = true;
+  }
+  free(cands);
+  return changed;
+}
+
+// --- Interface ---
+
+bool PreprocessClauses(ClauseSet* cnf, int num_vars, CnfReconstruction* rec) {
+  ClauseSetInit(&rec->clauses_);
+  rec->removed_vars_ = 0;
+  if (cnf->num_vars_ > num_vars) num_vars = cnf->num_vars_;
+
+  Simplifier s;
+  memset(&s, 0, sizeof(s));
+  s.num_vars_ = num_vars;
+  s.ok_ = true;
+  s.rec_ = rec;
+  int num_lits = 2 * (num_vars + 1);
+  s.occ_ = (IntVec*)calloc(num_lits, sizeof(IntVec));
+  s.num_occ_ = (int*)calloc(num_lits, sizeof(int));
+  s.touched_ = (bool*)calloc(num_vars + 1, sizeof(bool));
+  s.value_ = (signed char*)calloc(num_vars + 1, sizeof(signed char));
+  s.removed_var_ = (bool*)calloc(num_vars + 1, sizeof(bool));
+  s.mark_ = (int*)calloc(num_lits, sizeof(int));
+
+  // Sem literais repetidos nem tautologias
+  for (int i = 0; i < cnf->num_clauses_ && s.ok_; i++) {
+    const int* lits = ClauseSetClause(cnf, i);
+    int size = ClauseSetSize(cnf, i);
+    int stamp = ++s.stamp_;
+    bool tautology = false;
+    s.scratch_.size_ = 0;
+    for (int j = 0; j < size && !tautology; j++) {
+      if (s.mark_[LitIndex(-lits[j])] == stamp) tautology = true;
+      if (s.mark_[LitIndex(lits[j])] == stamp) continue;
+      s.mark_[LitIndex(lits[j])] = stamp;
+      IntVecPush(&s.scratch_, lits[j]);
+    }
+    if (!tautology) AddClause(&s, s.scratch_.data_, s.scratch_.size_);
+  }
+  Propagate(&s);
+
+  for (int round = 0; round < PREPROCESS_MAX_ROUNDS && s.ok_; round++) {
+    bool changed = SubstituteEquivalences(&s);
+    if (s.ok_ && Subsume(&s)) changed = true;
+    if (s.ok_ && EliminateVariables(&s)) changed = true;
+    if (!changed) break;
+  }
+
+  ClauseSetClear(cnf);
+  if (s.ok_) {
+    for (int c = 0; c < s.num_clauses_; c++)
+      if (!s.removed_[c]) ClauseSetAdd(cnf, ClauseLits(&s, c), s.size_[c]);
+  } else {
+    ClauseSetEndClause(cnf);  // cláusula vazia
+  }
+  cnf->num_vars_ = num_vars;
+
+  for (int i = 0; i < s.num_pool_; i++) free(s.pool_[i]);
+  free(s.pool_);
+  free(s.occ_);
+  free(s.num_occ_);
+  free(s.touched_);
+  free(s.value_);
+  free(s.removed_var_);
+  free(s.mark_);
+  free(s.lits_);
+  free(s.start_);
+  free(s.size_);
+  free(s.removed_);
+  free(s.queued_);
+  free(s.sig_);
+  free(s.trail_.data_);
+  free(s.subsume_.data_);
+  free(s.scratch_.data_);
+  return s.ok_;
+}
+
+// --- Literais do Topo da Sentença ---
+// O equivalente da propagação de unidades na árvore, antes da
+// distribuição da CNF/DNF. Ao contrário das simplificações acima, esta
+// preserva a equivalência.
+
+// Constantes que só existem durante PropagateLiterals
+static ExprNode g_true_node = {NODE_VAR, 0, NULL, NULL, 0};
+static ExprNode g_false_node = {NODE_VAR, 0, NULL, NULL, 0};
+
+// Valor de um operando em NNF sob os literais fixados
+static ExprNode* PropagateChild(PassContext* ctx, ExprNode* node) {
+  const ExprNode* var = node->type_ == NODE_NOT ? node->left_ : node;
+  if (var->type_ != NODE_VAR) return Visit(ctx, node);
+  int value = var->variable_ < ctx->num_fixed_ ? ctx->fixed_[var->variable_]
+                                               : 0;
+  if (node->type_ == NODE_NOT) value = -value;
+  return value > 0 ? &g_true_node : value < 0 ? &g_false_node : node;
+}
+
+static ExprNode* PropagateNode(PassContext* ctx, ExprNode* node) {
+  ExprNode* l = PropagateChild(ctx, node->left_);
+  ExprNode* r = PropagateChild(ctx, node->right_);
+  if (ctx->blocked_) return NULL;
+  bool is_and = node->type_ == NODE_AND;
+  ExprNode* absorbing = is_and ? &g_false_node : &g_true_node;
+  ExprNode* neutral = is_and ? &g_true_node : &g_false_node;
+  if (l == absorbing || r == absorbing) return absorbing;
+  if (l == neutral) return r;
+  if (r == neutral) return l;
+  if (l == node->left_ && r == node->right_) return node;
+  return ArenaNode(ctx->arena_, node->type_, l, r);
+}
+
+// Literais do topo de uma sentença em NNF: numa conjunção cada literal
+// parcela vale true no resto (x a F === x a F[x:=1]) e numa disjunção,
+// false (x v F === x v F[x:=0]). Repete enquanto a substituição trouxer
+// literais novos para o topo; o resultado é equivalente à entrada.
+ExprNode* PropagateLiterals(ExprArena* arena, ExprNode* root) {
+  NodeType op = root->type_;
+  if (op != NODE_AND && op != NODE_OR) return root;
+  signed char sign = op == NODE_AND ? 1 : -1;
+  ExprNode** parts = NULL;
+  ExprNode** stack = NULL;
+  int num_parts = 0, parts_cap = 0, stack_size = 0, stack_cap = 0;
+  signed char* fixed = NULL;
+  int num_fixed = 0;
+
+#define PUSH(arr, n, c, node)                                   \
+  do {                                                          \
+    if ((n) == (c)) {                                           \
+      (c) = (c) ? (c) * 2 : 64;                                 \
+      (arr) = (ExprNode**)realloc((arr), sizeof(*(arr)) * (c)); \
+    }                                                           \
+    (arr)[(n)++] = (node);                                      \
+  } while (0)
+
+  for (;;) {
+    // Parcelas do topo, da esquerda para a direita
+    num_parts = 0;
+    PUSH(stack, stack_size, stack_cap, root);
+    while (stack_size > 0) {
+      ExprNode* node = stack[--stack_size];
+      if (node->type_ == op) {
+        PUSH(stack, stack_size, stack_cap, node->right_);
+        PUSH(stack, stack_size, stack_cap, node->left_);
+      } else {
+        PUSH(parts, num_parts, parts_cap, node);
+      }
+    }
+
+    int new_literals = 0, conflict = 0;
+    for (int i = 0; i < num_parts && !conflict; i++) {
+      const ExprNode* var =
+          parts[i]->type_ == NODE_NOT ? parts[i]->left_ : parts[i];
+      if (var->type_ != NODE_VAR) continue;
+      int v = var->variable_;
+      signed char value = parts[i]->type_ == NODE_NOT ? -sign : sign;
+      if (v >= num_fixed) {
+        int cap = num_fixed ? num_fixed : 64;
+        while (cap <= v) cap *= 2;
+        fixed = (signed char*)realloc(fixed, cap);
+        memset(fixed + num_fixed, 0, cap - num_fixed);
+        num_fixed = cap;
+      }
+      if (fixed[v] == 0) {
+        fixed[v] = value;
+        new_literals++;
+      } else if (fixed[v] != value) {
+        conflict = v + 1;  // x e nx no topo
+      }
+    }
+    if (conflict) {
+      // Contradição (conjunção) ou tautologia (disjunção)
+      ExprNode* x = ArenaVar(arena, conflict - 1);
+      root = ArenaNode(arena, op, x, ArenaNode(arena, NODE_NOT, x, NULL));
+      break;
+    }
+    if (new_literals == 0) break;
+
+    PassContext ctx = {arena, {NULL, 0}, PropagateNode, 0, fixed, num_fixed,
+                       NULL, 0, 0, false};
+    ExprNode* absorbing = sign > 0 ? &g_false_node : &g_true_node;
+    bool changed = false;
+    int kept = 0;
+    for (int i = 0; i < num_parts; i++) {
+      ExprNode* part = parts[i];
+      if (part->type_ != NODE_VAR && part->type_ != NODE_NOT) {
+        part = VisitDeep(&ctx, part);
+        changed |= part != parts[i];
+        if (part == absorbing) {
+          kept = 0;
+          parts[kept++] = absorbing;
+          break;
+        }
+        if (part == &g_true_node || part == &g_false_node) continue;
+      }
+      parts[kept++] = part;
+    }
+    PassContextFree(&ctx);
+    if (!changed) break;
+
+    if (parts[0] == absorbing) {
+      const ExprNode* var = root;
+      while (var->type_ != NODE_VAR) var = var->left_;
+      ExprNode* x = ArenaVar(arena, var->variable_);
+      root = ArenaNode(arena, op, x, ArenaNode(arena, NODE_NOT, x, NULL));
+      break;
+    }
+    root = parts[0];
+    for (int i = 1; i < kept; i++)
+      root = ArenaNode(arena, op, root, parts[i]);
+    if (root->type_ != op) break;
+  }
+#undef PUSH
+
+  free(fixed);
+  free(stack);
+  free(parts);
+  return root;
+}
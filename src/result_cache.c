@@ -0,0 +1,247 @@
+#include "../include/result_cache.h"
+
+#include <stdint.h>
+#include <stdlib.h>
+#include <string.h>
+
+#ifdef _WIN32
+#include <windows.h>
+#else
+#include <pthread.h>
+#endif
+
+// --- Trava (Win32 / POSIX) ---
+
+#ifdef _WIN32
+typedef CRITICAL_SECTION Mutex;
+
+static void MutexInit(Mutex* m) { InitializeCriticalSection(m); }
+static void MutexLock(Mutex* m) { EnterCriticalSection(m); }
+static void MutexUnlock(Mutex* m) { LeaveCriticalSection(m); }
+#else
+typedef pthread_mutex_t Mutex;
+
+static void MutexInit(Mutex* m) { pthread_mutex_init(m, NULL); }
+static void MutexLock(Mutex* m) { pthread_mutex_lock(m); }
+static void MutexUnlock(Mutex* m) { pthread_mutex_unlock(m); }
+#endif
+
+#define FIRST_BUCKETS 256
+
+typedef struct CacheEntry {
+  struct CacheEntry* next_;  // cadeia do balde
+  uint64_t hash_;
+  size_t key_len_;
+  size_t value_len_;
+  int slot_;                 // posição em clock_
+  bool referenced_;          // usada desde a última passagem do ponteiro
+  unsigned char data_[];     // chave seguida do valor
+} CacheEntry;
+
+typedef struct {
+  Mutex lock_;
+  CacheEntry** buckets_;
+  size_t num_buckets_;  // potência de 2
+  CacheEntry** clock_;  // entradas na ordem do relógio
+  int clock_size_;
+  int clock_cap_;
+  int hand_;
+  size_t bytes_;
+  size_t budget_;
+  long long hits_;
+  long long misses_;
+  long long insertions_;
+  long long evictions_;
+} CacheShard;
+
+static CacheShard g_shards[RESULT_CACHE_SHARDS];
+static bool g_initialized = false;
+static size_t g_budget = 0;
+
+static uint64_t HashKey(const void* key, size_t len) {
+  const unsigned char* p = (const unsigned char*)key;
+  uint64_t h = 0xCBF29CE484222325ull;
+  for (size_t i = 0; i < len; i++) h = (h ^ p[i]) * 0x100000001B3ull;
+  h ^= h >> 33;
+  h *= 0xFF51AFD7ED558CCDull;
+  return h ^ (h >> 33);
+}
+
+static CacheShard* ShardOf(uint64_t hash) {
+  return &g_shards[(hash >> 32) % RESULT_CACHE_SHARDS];
+}
+
+static size_t EntryBytes(const CacheEntry* e) {
+  return sizeof(CacheEntry) + e->key_len_ + e->value_len_ +
+         2 * sizeof(CacheEntry*);
+}
+
+static CacheEntry* Find(const CacheShard* s, uint64_t hash, const void* key,
+                        size_t key_len) {
+  if (!s->num_buckets_) return NULL;
+  CacheEntry* e = s->buckets_[hash & (s->num_buckets_ - 1)];
+  while (e && !(e->hash_ == hash && e->key_len_ == key_len &&
+                !memcmp(e->data_, key, key_len)))
+    e = e->next_;
+  return e;
+}
+
+static void Evict(CacheShard* s, CacheEntry* e) {
+  CacheEntry** link = &s->buckets_[e->hash_ & (s->num_buckets_ - 1)];
+  while (*link != e) link = &(*link)->next_;
+  *link = e->next_;
+
+  // A última entrada do relógio ocupa a posição liberada
+  CacheEntry* last = s->clock_[--s->clock_size_];
+  s->clock_[e->slot_] = last;
+  last->slot_ = e->slot_;
+  if (s->hand_ >= s->clock_size_) s->hand_ = 0;
+
+  s->bytes_ -= EntryBytes(e);
+  s->evictions_++;
+  free(e);
+}
+
+// Relógio: entradas usadas desde a última passagem ganham outra volta
+static void EvictToBudget(CacheShard* s) {
+  while (s->bytes_ > s->budget_ && s->clock_size_ > 0) {
+    CacheEntry* e = s->clock_[s->hand_];
+    if (e->referenced_) {
+      e->referenced_ = false;
+      s->hand_ = (s->hand_ + 1) % s->clock_size_;
+    } else {
+      Evict(s, e);
+    }
+  }
+}
+
+static void ClearShard(CacheShard* s) {
+  for (int i = 0; i < s->clock_size_; i++) free(s->clock_[i]);
+  free(s->clock_);
+  free(s->buckets_);
+  s->buckets_ = NULL;
+  s->num_buckets_ = 0;
+  s->clock_ = NULL;
+  s->clock_size_ = 0;
+  s->clock_cap_ = 0;
+  s->hand_ = 0;
+  s->bytes_ = 0;
+}
+
+static void GrowBuckets(CacheShard* s) {
+  size_t cap = s->num_buckets_ ? s->num_buckets_ * 2 : FIRST_BUCKETS;
+  CacheEntry** buckets = (CacheEntry**)calloc(cap, sizeof(CacheEntry*));
+  for (int i = 0; i < s->clock_size_; i++) {
+    CacheEntry* e = s->clock_[i];
+    e->next_ = buckets[e->hash_ & (cap - 1)];
+    buckets[e->hash_ & (cap - 1)] = e;
+  }
+  free(s->buckets_);
+  s->buckets_ = buckets;
+  s->num_buckets_ = cap;
+}
+
+void ResultCacheSetBudget(size_t bytes) {
+  if (!g_initialized) {
+    for (int i = 0; i < RESULT_CACHE_SHARDS; i++)
+      MutexInit(&g_shards[i].lock_);
+    g_initialized = true;
+  }
+  g_budget = bytes;
+  for (int i = 0; i < RESULT_CACHE_SHARDS; i++) {
+    CacheShard* s = &g_shards[i];
+    MutexLock(&s->lock_);
+    s->budget_ = bytes / RESULT_CACHE_SHARDS;
+    if (bytes == 0)
+      ClearShard(s);
+    else
+      EvictToBudget(s);
+    MutexUnlock(&s->lock_);
+  }
+}
+
+bool ResultCacheEnabled(void) { return g_budget > 0; }
+
+void ResultCacheClear(void) {
+  if (!g_initialized) return;
+  for (int i = 0; i < RESULT_CACHE_SHARDS; i++) {
+    MutexLock(&g_shards[i].lock_);
+    ClearShard(&g_shards[i]);
+    MutexUnlock(&g_shards[i].lock_);
+  }
+}
+
+void ResultCacheGetStats(ResultCacheStats* stats) {
+  memset(stats, 0, sizeof(ResultCacheStats));
+  stats->budget_ = g_budget;
+  if (!g_initialized) return;
+  for (int i = 0; i < RESULT_CACHE_SHARDS; i++) {
+    CacheShard* s = &g_shards[i];
+    MutexLock(&s->lock_);
+    stats->hits_ += s->hits_;
+    stats->misses_ += s->misses_;
+    stats->insertions_ += s->insertions_;
+    stats->evictions_ += s->evictions_;
+    stats->entries_ += s->clock_size_;
+    stats->bytes_ += s->bytes_;
+    MutexUnlock(&s->lock_);
+  }
+}
+
+bool ResultCacheLookup(const void* key, size_t key_len, void** value,
+                       size_t* value_len) {
+  if (!g_budget) return false;
+  uint64_t hash = HashKey(key, key_len);
+  CacheShard* s = ShardOf(hash);
+  MutexLock(&s->lock_);
+  CacheEntry* e = Find(s, hash, key, key_len);
+  if (e) {
+    e->referenced_ = true;
+    *value = malloc(e->value_len_ ? e->value_len_ : 1);
+    memcpy(*value, e->data_ + e->key_len_, e->value_len_);
+    *value_len = e->value_len_;
+    s->hits_++;
+  } else {
+    s->misses_++;
+  }
+  MutexUnlock(&s->lock_);
+  return e != NULL;
+}
+
+void ResultCacheStore(const void* key, size_t key_len, const void* value,
+                      size_t value_len) {
+  if (!g_budget) return;
+  uint64_t hash = HashKey(key, key_len);
+  CacheShard* s = ShardOf(hash);
+  CacheEntry* e =
+      (CacheEntry*)malloc(sizeof(CacheEntry) + key_len + value_len);
+  e->hash_ = hash;
+  e->key_len_ = key_len;
+  e->value_len_ = value_len;
+  e->referenced_ = true;
+  memcpy(e->data_, key, key_len);
+  memcpy(e->data_ + key_len, value, value_len);
+
+  MutexLock(&s->lock_);
+  // Outra thread pode ter calculado o mesmo resultado nesse meio tempo
+  if (EntryBytes(e) > s->budget_ || Find(s, hash, key, key_len)) {
+    MutexUnlock(&s->lock_);
+    free(e);
+    return;
+  }
+  if ((size_t)s->clock_size_ >= s->num_buckets_) GrowBuckets(s);
+  if (s->clock_size_ == s->clock_cap_) {
+    s->clock_cap_ = s->clock_cap_ ? s->clock_cap_ * 2 : 64;
+    s->clock_ = (CacheEntry**)realloc(s->clock_,
+                                      sizeof(CacheEntry*) * s->clock_cap_);
+  }
+  CacheEntry** bucket = &s->buckets_[hash & (s->num_buckets_ - 1)];
+  e->next_ = *bucket;
+  *bucket = e;
+  e->slot_ = s->clock_size_;
+  s->clock_[s->clock_size_++] = e;
+  s->bytes_ += EntryBytes(e);
+  s->insertions_++;
+  EvictToBudget(s);
+  MutexUnlock(&s->lock_);
+}
@@ -0,0 +1,196 @@
+#include "../include/sat_session.h"
+
+#include <stdlib.h>
+
+#include "../include/clause_set.h"
+#include "../include/cnf_encoder.h"
+#include "../include/convert_internal.h"
+#include "../include/expr_arena.h"
+#include "../include/sat_solver.h"
+
+// Um único resolvedor e uma única arena por sessão: as sentenças de cada
+// consulta são compartilhadas por hash-consing com as anteriores e só as
+// portas novas são codificadas. Restrições de um nível de Push recebem o
+// literal negado do seletor do nível, que é suposto verdadeiro enquanto o
+// nível existe e fixado em falso no Pop.
+
+struct SatSession {
+  ExprArena arena_;
+  CnfIncremental enc_;
+  SatSolver* solver_;
+  ExprNode* base_;
+  int base_sel_;   // seletor das cláusulas da base
+  int base_lit_;   // literal equivalente à base (0 até a primeira comparação)
+  int* frames_;    // seletores dos níveis de Push
+  int num_frames_;
+  int frames_cap_;
+  int* assumptions_;
+  int assumptions_cap_;
+};
+
+// Passa as cláusulas novas da codificação para o resolvedor
+static void SessionFlush(SatSession* session) {
+  ClauseSet* cnf = &session->enc_.enc_.cnf_;
+  while (SatSolverNumVars(session->solver_) < session->enc_.enc_.num_vars_)
+    SatSolverNewVar(session->solver_);
+  SatSolverAddClauseSet(session->solver_, cnf);
+  ClauseSetClear(cnf);
+}
+
+static void SessionAddUnit(SatSession* session, int lit) {
+  SatSolverAddClause(session->solver_, &lit, 1);
+}
+
+static ExprNode* SessionParse(SatSession* session, const char* input) {
+  int pos = 0;
+  PhaseMark mark = PhaseBegin(&session->arena_);
+  ExprNode* root = ParseExpressionArena(&session->arena_, input, &pos);
+  PhaseEnd(PHASE_PARSE, mark, &session->arena_);
+  return root;
+}
+
+SatSession* SatSessionCreate(const char* base) {
+  SatSession* session = (SatSession*)calloc(1, sizeof(SatSession));
+  ExprArenaInit(&session->arena_);
+  CnfIncrementalInit(&session->enc_);
+  session->solver_ = SatSolverCreate();
+
+  session->base_ = SessionParse(session, base);
+  if (!session->base_) {
+    SatSessionDestroy(session);
+    return NULL;
+  }
+  PhaseMark mark = PhaseBegin(NULL);
+  session->base_sel_ = CnfIncrementalNewVar(&session->enc_);
+  CnfIncrementalAssert(&session->enc_, session->base_, -session->base_sel_);
+  SessionFlush(session);
+  PhaseEnd(PHASE_ENCODE, mark, NULL);
+  return session;
+}
+
+void SatSessionDestroy(SatSession* session) {
+  if (!session) return;
+  ReleaseArena(&session->arena_);
+  CnfIncrementalFree(&session->enc_);
+  SatSolverDestroy(session->solver_);
+  free(session->frames_);
+  free(session->assumptions_);
+  free(session);
+}
+
+bool SatSessionAdd(SatSession* session, const char* formula) {
+  ExprNode* root = SessionParse(session, formula);
+  if (!root) return false;
+  int guard = session->num_frames_ > 0
+                  ? -session->frames_[session->num_frames_ - 1]
+                  : 0;
+  PhaseMark mark = PhaseBegin(NULL);
+  CnfIncrementalAssert(&session->enc_, root, guard);
+  SessionFlush(session);
+  PhaseEnd(PHASE_ENCODE, mark, NULL);
+  return true;
+}
+
+void SatSessionPush(SatSession* session) {
+  if (session->num_frames_ == session->frames_cap_) {
+    session->frames_cap_ = session->frames_cap_ ? session->frames_cap_ * 2 : 16;
+    session->frames_ = (int*)realloc(session->frames_,
+                                     sizeof(int) * session->frames_cap_);
+  }
+  session->frames_[session->num_frames_++] =
+      CnfIncrementalNewVar(&session->enc_);
+  SessionFlush(session);
+}
+
+bool SatSessionPop(SatSession* session) {
+  if (session->num_frames_ == 0) return false;
+  // Seletor falso: as cláusulas do nível (e as aprendidas a partir delas,
+  // que contêm o seletor negado) ficam satisfeitas para sempre
+  SessionAddUnit(session, -session->frames_[--session->num_frames_]);
+  return true;
+}
+
+// Suposições de uma consulta: seletores ativos, `extra` e as do usuário
+static int SessionAssumptions(SatSession* session, int extra,
+                              const int* assumptions, int num_assumptions) {
+  int needed = session->num_frames_ + num_assumptions + 1;
+  if (needed > session->assumptions_cap_) {
+    session->assumptions_cap_ = needed * 2;
+    session->assumptions_ = (int*)realloc(
+        session->assumptions_, sizeof(int) * session->assumptions_cap_);
+  }
+  int n = 0;
+  session->assumptions_[n++] = extra;
+  for (int i = 0; i < session->num_frames_; i++)
+    session->assumptions_[n++] = session->frames_[i];
+  for (int i = 0; i < num_assumptions; i++) {
+    int var = assumptions[i] < 0 ? -assumptions[i] : assumptions[i];
+    if (var == 0) continue;
+    int x = CnfIncrementalInput(&session->enc_, var);
+    session->assumptions_[n++] = assumptions[i] < 0 ? -x : x;
+  }
+  SessionFlush(session);
+  return n;
+}
+
+// Modelo do resolvedor sobre as variáveis originais vistas na sessão
+static void SessionModel(const SatSession* session, bool** model,
+                         int* size) {
+  const CnfEncoding* enc = &session->enc_.enc_;
+  int max_var = 0;
+  for (int i = 1; i <= enc->num_inputs_; i++)
+    if (enc->vars_.originals_[i] > max_var) max_var = enc->vars_.originals_[i];
+  bool* values = (bool*)calloc(max_var + 1, sizeof(bool));
+  for (int i = 1; i <= enc->num_inputs_; i++)
+    values[enc->vars_.originals_[i]] =
+        SatSolverModelValue(session->solver_, session->enc_.input_var_[i]);
+  *model = values;
+  *size = max_var + 1;
+}
+
+bool SatSessionSolve(SatSession* session, const int* assumptions,
+                     int num_assumptions, bool** model, int* model_size) {
+  int n = SessionAssumptions(session, session->base_sel_, assumptions,
+                             num_assumptions);
+  PhaseMark mark = PhaseBegin(NULL);
+  bool sat = SatSolverSolveAssuming(session->solver_, session->assumptions_,
+                                    n) == SAT_SATISFIABLE;
+  PhaseEnd(PHASE_SOLVE, mark, NULL);
+  if (sat && model) SessionModel(session, model, model_size);
+  return sat;
+}
+
+bool SatSessionCompare(SatSession* session, const char* candidate,
+                       bool** counterexample, int* size) {
+  if (counterexample) {
+    *counterexample = NULL;
+    *size = 0;
+  }
+  ExprNode* root = SessionParse(session, candidate);
+  if (!root) return false;
+  if (root == session->base_) return true;
+
+  // Miter guardado por um seletor de uso único: sel > (base x candidata)
+  PhaseMark mark = PhaseBegin(NULL);
+  if (!session->base_lit_)
+    CnfIncrementalLiteral(&session->enc_, session->base_, true,
+                          &session->base_lit_);
+  int b = session->base_lit_;
+  int c;
+  CnfIncrementalLiteral(&session->enc_, root, true, &c);
+  int sel = CnfIncrementalNewVar(&session->enc_);
+  int miter1[] = {-sel, b, c};
+  int miter2[] = {-sel, -b, -c};
+  ClauseSetAdd(&session->enc_.enc_.cnf_, miter1, 3);
+  ClauseSetAdd(&session->enc_.enc_.cnf_, miter2, 3);
+  int n = SessionAssumptions(session, sel, NULL, 0);
+  PhaseEnd(PHASE_ENCODE, mark, NULL);
+
+  mark = PhaseBegin(NULL);
+  bool differ = SatSolverSolveAssuming(session->solver_, session->assumptions_,
+                                       n) == SAT_SATISFIABLE;
+  PhaseEnd(PHASE_SOLVE, mark, NULL);
+  if (differ && counterexample) SessionModel(session, counterexample, size);
+  SessionAddUnit(session, -sel);
+  return !differ;
+}
@@ -0,0 +1,899 @@
+#include "../include/sat_solver.h"
+
+#include <stdint.h>
+#include <stdlib.h>
+#include <string.h>
+
+// --- Representação Interna ---
+// Literal interno: 2 * v + sinal (v 0-based, sinal 1 = negado)
+
+#define LIT_UNDEF (-1)
+#define CREF_UNDEF 0xFFFFFFFFu
+
+// Cabeçalho da cláusula na memória plana: [tamanho][flags][atividade]
+#define CLAUSE_HEADER 3
+#define FLAG_LEARNT 1u
+#define FLAG_DELETED 2u
+#define LBD_SHIFT 2
+
+#define VAR_DECAY 0.95
+#define CLAUSE_DECAY 0.999
+#define RESTART_BASE 100
+#define REDUCE_FIRST 2000
+#define REDUCE_INC 300
+
+typedef uint32_t CRef;
+
+typedef struct {
+  CRef cref_;
+  int blocker_;
+} Watcher;
+
+typedef struct {
+  Watcher* data_;
+  int size_;
+  int cap_;
+} WatchList;
+
+typedef struct {
+  int* data_;
+  int size_;
+  int cap_;
+} IntVec;
+
+typedef struct {
+  CRef* data_;
+  int size_;
+  int cap_;
+} CRefVec;
+
+struct SatSolver {
+  int num_vars_;
+  int vars_cap_;
+  bool ok_;
+
+  // Memória de cláusulas (offsets de 32 bits, sem malloc por cláusula)
+  uint32_t* mem_;
+  size_t mem_size_;
+  size_t mem_cap_;
+  size_t wasted_;
+  CRefVec clauses_;
+  CRefVec learnts_;
+
+  // Estado por literal / variável
+  signed char* lit_val_;  // 1 verdadeiro, -1 falso, 0 indefinido
+  WatchList* watches_;    // watches_[l]: cláusulas que vigiam l
+  int* level_;
+  CRef* reason_;
+  double* activity_;
+  char* polarity_;  // fase salva (1 = negativo)
+  char* seen_;
+  bool* model_;
+
+  // Heap de variáveis por atividade (VSIDS)
+  int* heap_;
+  int* heap_index_;  // -1 se fora do heap
+  int heap_size_;
+
+  // Trilha de atribuições
+  int* trail_;
+  int trail_size_;
+  IntVec trail_lim_;
+  int qhead_;
+
+  double var_inc_;
+  double cla_inc_;
+  long long next_reduce_;
+  int reduce_count_;
+  int simp_trail_;  // tamanho da trilha no último Simplify
+
+  long long conflict_limit_;  // por chamada de Solve; < 0: sem limite
+  int next_restart_;          // posição na sequência de Luby ao retomar
+
+  IntVec assumptions_;  // literais internos da chamada atual
+  IntVec failed_;       // suposições responsáveis pela última UNSAT (DIMACS)
+
+  IntVec learnt_tmp_;
+  IntVec analyze_tmp_;
+  int* level_stamp_;
+  int stamp_;
+
+  SatSolverStats stats_;
+};
+
+static inline int LitVar(int lit) { return lit >> 1; }
+static inline int LitNeg(int lit) { return lit ^ 1; }
+static inline int DimacsToLit(int d) { return d > 0 ? 2 * (d - 1) : 2 * (-d - 1) + 1; }
+
+static void IntVecPush(IntVec* v, int x) {
+  if (v->size_ == v->cap_) {
+    v->cap_ = v->cap_ ? v->cap_ * 2 : 16;
+    v->data_ = (int*)realloc(v->data_, sizeof(int) * v->cap_);
+  }
+  v->data_[v->size_++] = x;
+}
+
+static void CRefVecPush(CRefVec* v, CRef x) {
+  if (v->size_ == v->cap_) {
+    v->cap_ = v->cap_ ? v->cap_ * 2 : 16;
+    v->data_ = (CRef*)realloc(v->data_, sizeof(CRef) * v->cap_);
+  }
+  v->data_[v->size_++] = x;
+}
+
+static void WatchPush(WatchList* w, CRef cref, int blocker) {
+  if (w->size_ == w->cap_) {
+    w->cap_ = w->cap_ ? w->cap_ * 2 : 4;
+    w->data_ = (Watcher*)realloc(w->data_, sizeof(Watcher) * w->cap_);
+  }
+  w->data_[w->size_].cref_ = cref;
+  w->data_[w->size_].blocker_ = blocker;
+  w->size_++;
+}
+
+// --- Acesso às Cláusulas ---
+
+static inline uint32_t ClauseSize(const SatSolver* s, CRef c) { return s->mem_[c]; }
+static inline int* ClauseLits(SatSolver* s, CRef c) {
+  return (int*)(s->mem_ + c + CLAUSE_HEADER);
+}
+static inline bool ClauseLearnt(const SatSolver* s, CRef c) {
+  return (s->mem_[c + 1] & FLAG_LEARNT) != 0;
+}
+static inline bool ClauseDeleted(const SatSolver* s, CRef c) {
+  return (s->mem_[c + 1] & FLAG_DELETED) != 0;
+}
+static inline uint32_t ClauseLbd(const SatSolver* s, CRef c) {
+  return s->mem_[c + 1] >> LBD_SHIFT;
+}
+static inline float ClauseActivity(const SatSolver* s, CRef c) {
+  float f;
+  memcpy(&f, &s->mem_[c + 2], sizeof(f));
+  return f;
+}
+static inline void SetClauseActivity(SatSolver* s, CRef c, float f) {
+  memcpy(&s->mem_[c + 2], &f, sizeof(f));
+}
+
+static CRef AllocClause(SatSolver* s, const int* lits, int size, bool learnt,
+                        int lbd) {
+  size_t need = CLAUSE_HEADER + (size_t)size;
+  if (s->mem_size_ + need > s->mem_cap_) {
+    while (s->mem_size_ + need > s->mem_cap_)
+      s->mem_cap_ = s->mem_cap_ ? s->mem_cap_ * 2 : 1024;
+    s->mem_ = (uint32_t*)realloc(s->mem_, sizeof(uint32_t) * s->mem_cap_);
+  }
+  CRef c = (CRef)s->mem_size_;
+  s->mem_[c] = (uint32_t)size;
+  s->mem_[c + 1] = (learnt ? FLAG_LEARNT : 0) | ((uint32_t)lbd << LBD_SHIFT);
+  SetClauseActivity(s, c, 0.0f);
+  memcpy(s->mem_ + c + CLAUSE_HEADER, lits, sizeof(int) * size);
+  s->mem_size_ += need;
+  return c;
+}
+
+static void AttachClause(SatSolver* s, CRef c) {
+  int* lits = ClauseLits(s, c);
+  WatchPush(&s->watches_[lits[0]], c, lits[1]);
+  WatchPush(&s->watches_[lits[1]], c, lits[0]);
+}
+
+// --- Heap VSIDS ---
+
+static inline bool HeapLess(const SatSolver* s, int a, int b) {
+  return s->activity_[a] > s->activity_[b];
+}
+
+static void HeapUp(SatSolver* s, int i) {
+  int v = s->heap_[i];
+  while (i > 0) {
+    int parent = (i - 1) >> 1;
+    if (!HeapLess(s, v, s->heap_[parent])) break;
+    s->heap_[i] = s->heap_[parent];
+    s->heap_index_[s->heap_[i]] = i;
+    i = parent;
+  }
+  s->heap_[i] = v;
+  s->heap_index_[v] = i;
+}
+
+static void HeapDown(SatSolver* s, int i) {
+  int v = s->heap_[i];
+  for (;;) {
+    int child = 2 * i + 1;
+    if (child >= s->heap_size_) break;
+    if (child + 1 < s->heap_size_ &&
+        HeapLess(s, s->heap_[child + 1], s->heap_[child]))
+      child++;
+    if (!HeapLess(s, s->heap_[child], v)) break;
+    s->heap_[i] = s->heap_[child];
+    s->heap_index_[s->heap_[i]] = i;
+    i = child;
+  }
+  s->heap_[i] = v;
+  s->heap_index_[v] = i;
+}
+
+static void HeapInsert(SatSolver* s, int v) {
+  if (s->heap_index_[v] >= 0) return;
+  s->heap_[s->heap_size_] = v;
+  s->heap_index_[v] = s->heap_size_;
+  s->heap_size_++;
+  HeapUp(s, s->heap_size_ - 1);
+}
+
+static int HeapPop(SatSolver* s) {
+  int v = s->heap_[0];
+  s->heap_index_[v] = -1;
+  s->heap_size_--;
+  if (s->heap_size_ > 0) {
+    s->heap_[0] = s->heap_[s->heap_size_];
+    s->heap_index_[s->heap_[0]] = 0;
+    HeapDown(s, 0);
+  }
+  return v;
+}
+
+// --- Criação / Destruição ---
+
+SatSolver* SatSolverCreate(void) {
+  SatSolver* s = (SatSolver*)calloc(1, sizeof(SatSolver));
+  s->ok_ = true;
+  s->var_inc_ = 1.0;
+  s->cla_inc_ = 1.0;
+  s->next_reduce_ = REDUCE_FIRST;
+  s->conflict_limit_ = -1;
+  return s;
+}
+
+void SatSolverDestroy(SatSolver* s) {
+  if (!s) return;
+  for (int l = 0; l < 2 * s->num_vars_; l++) free(s->watches_[l].data_);
+  free(s->watches_);
+  free(s->mem_);
+  free(s->clauses_.data_);
+  free(s->learnts_.data_);
+  free(s->lit_val_);
+  free(s->level_);
+  free(s->reason_);
+  free(s->activity_);
+  free(s->polarity_);
+  free(s->seen_);
+  free(s->model_);
+  free(s->heap_);
+  free(s->heap_index_);
+  free(s->trail_);
+  free(s->trail_lim_.data_);
+  free(s->assumptions_.data_);
+  free(s->failed_.data_);
+  free(s->learnt_tmp_.data_);
+  free(s->analyze_tmp_.data_);
+  free(s->level_stamp_);
+  free(s);
+}
+
+static void GrowVars(SatSolver* s, int num_vars) {
+  if (num_vars <= s->num_vars_) return;
+  if (num_vars > s->vars_cap_) {
+    int cap = s->vars_cap_ ? s->vars_cap_ : 16;
+    while (cap < num_vars) cap *= 2;
+    s->lit_val_ = (signed char*)realloc(s->lit_val_, 2 * cap);
+    s->watches_ = (WatchList*)realloc(s->watches_, sizeof(WatchList) * 2 * cap);
+    s->level_ = (int*)realloc(s->level_, sizeof(int) * cap);
+    s->reason_ = (CRef*)realloc(s->reason_, sizeof(CRef) * cap);
+    s->activity_ = (double*)realloc(s->activity_, sizeof(double) * cap);
+    s->polarity_ = (char*)realloc(s->polarity_, cap);
+    s->seen_ = (char*)realloc(s->seen_, cap);
+    s->model_ = (bool*)realloc(s->model_, sizeof(bool) * cap);
+    s->heap_ = (int*)realloc(s->heap_, sizeof(int) * cap);
+    s->heap_index_ = (int*)realloc(s->heap_index_, sizeof(int) * cap);
+    s->trail_ = (int*)realloc(s->trail_, sizeof(int) * cap);
+    s->level_stamp_ = (int*)realloc(s->level_stamp_, sizeof(int) * (cap + 1));
+    for (int i = s->vars_cap_; i <= cap; i++) s->level_stamp_[i] = 0;
+    s->vars_cap_ = cap;
+  }
+  for (int v = s->num_vars_; v < num_vars; v++) {
+    s->lit_val_[2 * v] = 0;
+    s->lit_val_[2 * v + 1] = 0;
+    memset(&s->watches_[2 * v], 0, sizeof(WatchList) * 2);
+    s->level_[v] = 0;
+    s->reason_[v] = CREF_UNDEF;
+    s->activity_[v] = 0.0;
+    s->polarity_[v] = 1;
+    s->seen_[v] = 0;
+    s->model_[v] = false;
+    s->heap_index_[v] = -1;
+  }
+  int old = s->num_vars_;
+  s->num_vars_ = num_vars;
+  for (int v = old; v < num_vars; v++) HeapInsert(s, v);
+}
+
+int SatSolverNewVar(SatSolver* s) {
+  GrowVars(s, s->num_vars_ + 1);
+  return s->num_vars_;
+}
+
+int SatSolverNumVars(const SatSolver* s) { return s->num_vars_; }
+
+void SatSolverSetConflictLimit(SatSolver* s, long long max_conflicts) {
+  s->conflict_limit_ = max_conflicts;
+}
+
+const SatSolverStats* SatSolverGetStats(const SatSolver* s) {
+  return &s->stats_;
+}
+
+bool SatSolverModelValue(const SatSolver* s, int var) {
+  if (var < 1 || var > s->num_vars_) return false;
+  return s->model_[var - 1];
+}
+
+// --- Atribuição e Retrocesso ---
+
+static inline int DecisionLevel(const SatSolver* s) {
+  return s->trail_lim_.size_;
+}
+
+static inline void Enqueue(SatSolver* s, int lit, CRef reason) {
+  int v = LitVar(lit);
+  s->lit_val_[lit] = 1;
+  s->lit_val_[LitNeg(lit)] = -1;
+  s->level_[v] = DecisionLevel(s);
+  s->reason_[v] = reason;
+  s->trail_[s->trail_size_++] = lit;
+}
+
+static void Backtrack(SatSolver* s, int level) {
+  if (DecisionLevel(s) <= level) return;
+  int lim = s->trail_lim_.data_[level];
+  for (int i = s->trail_size_ - 1; i >= lim; i--) {
+    int lit = s->trail_[i];
+    int v = LitVar(lit);
+    s->lit_val_[lit] = 0;
+    s->lit_val_[LitNeg(lit)] = 0;
+    s->reason_[v] = CREF_UNDEF;
+    s->polarity_[v] = (char)(lit & 1);
+    HeapInsert(s, v);
+  }
+  s->trail_size_ = lim;
+  s->qhead_ = lim;
+  s->trail_lim_.size_ = level;
+}
+
+// --- Propagação (dois literais vigiados) ---
+
+static CRef Propagate(SatSolver* s) {
+  CRef conflict = CREF_UNDEF;
+  while (s->qhead_ < s->trail_size_) {
+    int p = s->trail_[s->qhead_++];
+    int false_lit = LitNeg(p);
+    WatchList* ws = &s->watches_[false_lit];
+    Watcher* w = ws->data_;
+    int i = 0, j = 0, n = ws->size_;
+    s->stats_.propagations_++;
+
+    while (i < n) {
+      int blocker = w[i].blocker_;
+      if (s->lit_val_[blocker] == 1) {
+        w[j++] = w[i++];
+        continue;
+      }
+
+      CRef cr = w[i].cref_;
+      int* c = ClauseLits(s, cr);
+      if (c[0] == false_lit) {
+        c[0] = c[1];
+        c[1] = false_lit;
+      }
+      i++;
+
+      int first = c[0];
+      if (first != blocker && s->lit_val_[first] == 1) {
+        w[j].cref_ = cr;
+        w[j].blocker_ = first;
+        j++;
+        continue;
+      }
+
+      // Procura um novo literal para vigiar
+      uint32_t size = ClauseSize(s, cr);
+      bool moved = false;
+      for (uint32_t k = 2; k < size; k++) {
+        if (s->lit_val_[c[k]] != -1) {
+          c[1] = c[k];
+          c[k] = false_lit;
+          WatchPush(&s->watches_[c[1]], cr, first);
+          moved = true;
+          break;
+        }
+      }
+      if (moved) continue;
+
+      // Cláusula unitária ou em conflito
+      w[j].cref_ = cr;
+      w[j].blocker_ = first;
+      j++;
+      if (s->lit_val_[first] == -1) {
+        conflict = cr;
+        s->qhead_ = s->trail_size_;
+        while (i < n) w[j++] = w[i++];
+      } else {
+        Enqueue(s, first, cr);
+      }
+    }
+    ws->size_ = j;
+    if (conflict != CREF_UNDEF) break;
+  }
+  return conflict;
+}
+
+// --- Atividades ---
+
+static void BumpVar(SatSolver* s, int v) {
+  s->activity_[v] += s->var_inc_;
+  if (s->activity_[v] > 1e100) {
+    for (int i = 0; i < s->num_vars_; i++) s->activity_[i] *= 1e-100;
+    s->var_inc_ *= 1e-100;
+  }
+  if (s->heap_index_[v] >= 0) HeapUp(s, s->heap_index_[v]);
+}
+
+static void BumpClause(SatSolver* s, CRef c) {
+  float act = ClauseActivity(s, c) + (float)s->cla_inc_;
+  SetClauseActivity(s, c, act);
+  if (act > 1e20f) {
+    for (int i = 0; i < s->learnts_.size_; i++) {
+      CRef l = s->learnts_.data_[i];
+      SetClauseActivity(s, l, ClauseActivity(s, l) * 1e-20f);
+    }
+    s->cla_inc_ *= 1e-20;
+  }
+}
+
+// --- Análise de Conflito (1-UIP) ---
+
+static int ComputeLbd(SatSolver* s, const int* lits, int size) {
+  s->stamp_++;
+  int lbd = 0;
+  for (int i = 0; i < size; i++) {
+    int lvl = s->level_[LitVar(lits[i])];
+    if (s->level_stamp_[lvl] != s->stamp_) {
+      s->level_stamp_[lvl] = s->stamp_;
+      lbd++;
+    }
+  }
+  return lbd;
+}
+
+// Literal é redundante se todos os antecedentes já estão na cláusula
+static bool LitRedundant(SatSolver* s, int lit) {
+  CRef r = s->reason_[LitVar(lit)];
+  if (r == CREF_UNDEF) return false;
+  int* c = ClauseLits(s, r);
+  uint32_t size = ClauseSize(s, r);
+  for (uint32_t k = 1; k < size; k++) {
+    int v = LitVar(c[k]);
+    if (!s->seen_[v] && s->level_[v] > 0) return false;
+  }
+  return true;
+}
+
+// A suposição ~p ficou falsa: failed_ recebe as suposições (decisões
+// acima do nível 0) das quais p decorre, mais a própria ~p
+static void AnalyzeFinal(SatSolver* s, int p) {
+  IntVec* out = &s->failed_;
+  out->size_ = 0;
+  IntVecPush(out, LitNeg(p));
+  if (DecisionLevel(s) > 0 && s->level_[LitVar(p)] > 0) {
+    s->seen_[LitVar(p)] = 1;
+    for (int i = s->trail_size_ - 1; i >= s->trail_lim_.data_[0]; i--) {
+      int v = LitVar(s->trail_[i]);
+      if (!s->seen_[v]) continue;
+      CRef r = s->reason_[v];
+      if (r == CREF_UNDEF) {
+        IntVecPush(out, s->trail_[i]);
+      } else {
+        int* c = ClauseLits(s, r);
+        uint32_t size = ClauseSize(s, r);
+        for (uint32_t k = 1; k < size; k++)
+          if (s->level_[LitVar(c[k])] > 0) s->seen_[LitVar(c[k])] = 1;
+      }
+      s->seen_[v] = 0;
+    }
+  }
+  for (int i = 0; i < out->size_; i++) {
+    int lit = out->data_[i];
+    out->data_[i] = (lit & 1) ? -(LitVar(lit) + 1) : LitVar(lit) + 1;
+  }
+}
+
+static int Analyze(SatSolver* s, CRef conflict, int* out_level) {
+  IntVec* out = &s->learnt_tmp_;
+  out->size_ = 0;
+  IntVecPush(out, LIT_UNDEF);
+
+  int path_count = 0;
+  int p = LIT_UNDEF;
+  int index = s->trail_size_ - 1;
+
+  do {
+    if (ClauseLearnt(s, conflict)) BumpClause(s, conflict);
+    int* c = ClauseLits(s, conflict);
+    uint32_t size = ClauseSize(s, conflict);
+    for (uint32_t j = (p == LIT_UNDEF) ? 0 : 1; j < size; j++) {
+      int q = c[j];
+      int v = LitVar(q);
+      if (!s->seen_[v] && s->level_[v] > 0) {
+        BumpVar(s, v);
+        s->seen_[v] = 1;
+        if (s->level_[v] >= DecisionLevel(s))
+          path_count++;
+        else
+          IntVecPush(out, q);
+      }
+    }
+    while (!s->seen_[LitVar(s->trail_[index--])]);
+    p = s->trail_[index + 1];
+    conflict = s->reason_[LitVar(p)];
+    s->seen_[LitVar(p)] = 0;
+    path_count--;
+  } while (path_count > 0);
+  out->data_[0] = LitNeg(p);
+
+  // Minimização local: remove literais implicados pelos demais
+  IntVec* all = &s->analyze_tmp_;
+  all->size_ = 0;
+  for (int i = 1; i < out->size_; i++) IntVecPush(all, out->data_[i]);
+  int j = 1;
+  for (int i = 1; i < out->size_; i++) {
+    if (!LitRedundant(s, out->data_[i])) out->data_[j++] = out->data_[i];
+  }
+  out->size_ = j;
+  for (int i = 0; i < all->size_; i++) s->seen_[LitVar(all->data_[i])] = 0;
+
+  // Nível de retrocesso: maior nível entre os literais restantes
+  int bt_level = 0;
+  if (out->size_ > 1) {
+    int max_i = 1;
+    for (int i = 2; i < out->size_; i++) {
+      if (s->level_[LitVar(out->data_[i])] >
+          s->level_[LitVar(out->data_[max_i])])
+        max_i = i;
+    }
+    int tmp = out->data_[1];
+    out->data_[1] = out->data_[max_i];
+    out->data_[max_i] = tmp;
+    bt_level = s->level_[LitVar(out->data_[1])];
+  }
+  *out_level = bt_level;
+  return ComputeLbd(s, out->data_, out->size_);
+}
+
+// --- Manutenção da Base de Cláusulas ---
+
+static bool ClauseLocked(SatSolver* s, CRef c) {
+  int first = ClauseLits(s, c)[0];
+  return s->lit_val_[first] == 1 && s->reason_[LitVar(first)] == c;
+}
+
+static bool ClauseSatisfied(SatSolver* s, CRef c) {
+  int* lits = ClauseLits(s, c);
+  uint32_t size = ClauseSize(s, c);
+  for (uint32_t k = 0; k < size; k++)
+    if (s->lit_val_[lits[k]] == 1) return true;
+  return false;
+}
+
+static void DeleteClause(SatSolver* s, CRef c) {
+  s->mem_[c + 1] |= FLAG_DELETED;
+  s->wasted_ += CLAUSE_HEADER + ClauseSize(s, c);
+}
+
+// Compacta a memória de cláusulas e reconstrói as listas de vigilância.
+// O endereço novo de cada cláusula viva fica no campo de atividade antigo.
+static void CollectGarbage(SatSolver* s) {
+  uint32_t* old_mem = s->mem_;
+  size_t old_size = s->mem_size_;
+  size_t live = old_size - s->wasted_;
+  uint32_t* new_mem = (uint32_t*)malloc(sizeof(uint32_t) * (live ? live : 1));
+  size_t pos = 0;
+
+  for (size_t c = 0; c < old_size;) {
+    size_t len = CLAUSE_HEADER + old_mem[c];
+    if (!(old_mem[c + 1] & FLAG_DELETED)) {
+      memcpy(new_mem + pos, old_mem + c, sizeof(uint32_t) * len);
+      old_mem[c + 2] = (uint32_t)pos;
+      pos += len;
+    }
+    c += len;
+  }
+
+  for (int i = 0; i < s->trail_size_; i++) {
+    int v = LitVar(s->trail_[i]);
+    CRef r = s->reason_[v];
+    if (r == CREF_UNDEF) continue;
+    // Acima do nível 0 razões nunca são removidas (ver ClauseLocked);
+    // no nível 0 a razão não é mais consultada pela análise
+    s->reason_[v] = (old_mem[r + 1] & FLAG_DELETED) ? CREF_UNDEF : old_mem[r + 2];
+  }
+
+  CRefVec* lists[2] = {&s->clauses_, &s->learnts_};
+  for (int l = 0; l < 2; l++) {
+    CRefVec* vec = lists[l];
+    int j = 0;
+    for (int i = 0; i < vec->size_; i++) {
+      CRef c = vec->data_[i];
+      if (!(old_mem[c + 1] & FLAG_DELETED)) vec->data_[j++] = old_mem[c + 2];
+    }
+    vec->size_ = j;
+  }
+
+  free(old_mem);
+  s->mem_ = new_mem;
+  s->mem_size_ = pos;
+  s->mem_cap_ = live ? live : 1;
+  s->wasted_ = 0;
+
+  for (int l = 0; l < 2 * s->num_vars_; l++) s->watches_[l].size_ = 0;
+  for (int l = 0; l < 2; l++)
+    for (int i = 0; i < lists[l]->size_; i++)
+      AttachClause(s, lists[l]->data_[i]);
+}
+
+typedef struct {
+  CRef cref_;
+  uint32_t lbd_;
+  float activity_;
+} LearntKey;
+
+static int CompareLearntKeys(const void* a, const void* b) {
+  const LearntKey* x = (const LearntKey*)a;
+  const LearntKey* y = (const LearntKey*)b;
+  // Piores primeiro: LBD alto, depois atividade baixa
+  if (x->lbd_ != y->lbd_) return x->lbd_ > y->lbd_ ? -1 : 1;
+  if (x->activity_ != y->activity_) return x->activity_ < y->activity_ ? -1 : 1;
+  return 0;
+}
+
+static void ReduceDb(SatSolver* s) {
+  int n = s->learnts_.size_;
+  LearntKey* keys = (LearntKey*)malloc(sizeof(LearntKey) * (n ? n : 1));
+  for (int i = 0; i < n; i++) {
+    CRef c = s->learnts_.data_[i];
+    keys[i].cref_ = c;
+    keys[i].lbd_ = ClauseLbd(s, c);
+    keys[i].activity_ = ClauseActivity(s, c);
+  }
+  qsort(keys, n, sizeof(LearntKey), CompareLearntKeys);
+
+  for (int i = 0; i < n / 2; i++) {
+    CRef c = keys[i].cref_;
+    if (keys[i].lbd_ > 2 && ClauseSize(s, c) > 2 && !ClauseLocked(s, c))
+      DeleteClause(s, c);
+  }
+  free(keys);
+
+  s->stats_.reductions_++;
+  s->reduce_count_++;
+  CollectGarbage(s);
+}
+
+// Remove cláusulas satisfeitas no nível 0
+static void Simplify(SatSolver* s) {
+  CRefVec* lists[2] = {&s->clauses_, &s->learnts_};
+  bool removed = false;
+  for (int l = 0; l < 2; l++) {
+    for (int i = 0; i < lists[l]->size_; i++) {
+      CRef c = lists[l]->data_[i];
+      if (!ClauseDeleted(s, c) && ClauseSatisfied(s, c)) {
+        DeleteClause(s, c);
+        removed = true;
+      }
+    }
+  }
+  if (removed) CollectGarbage(s);
+  s->simp_trail_ = s->trail_size_;
+}
+
+// --- Inclusão de Cláusulas ---
+
+static int CompareInts(const void* a, const void* b) {
+  int x = *(const int*)a, y = *(const int*)b;
+  return (x > y) - (x < y);
+}
+
+bool SatSolverAddClause(SatSolver* s, const int* lits, int size) {
+  if (!s->ok_) return false;
+  Backtrack(s, 0);
+
+  IntVec* tmp = &s->analyze_tmp_;
+  tmp->size_ = 0;
+  for (int i = 0; i < size; i++) {
+    int var = lits[i] < 0 ? -lits[i] : lits[i];
+    if (var == 0) continue;
+    GrowVars(s, var);
+    IntVecPush(tmp, DimacsToLit(lits[i]));
+  }
+  if (tmp->size_ > 1) qsort(tmp->data_, tmp->size_, sizeof(int), CompareInts);
+
+  // Remove duplicatas e literais falsos; descarta tautologias/satisfeitas
+  int j = 0;
+  int prev = LIT_UNDEF;
+  for (int i = 0; i < tmp->size_; i++) {
+    int lit = tmp->data_[i];
+    if (s->lit_val_[lit] == 1 || lit == LitNeg(prev)) return true;
+    if (lit == prev || s->lit_val_[lit] == -1) continue;
+    tmp->data_[j++] = prev = lit;
+  }
+  tmp->size_ = j;
+
+  if (j == 0) {
+    s->ok_ = false;
+  } else if (j == 1) {
+    Enqueue(s, tmp->data_[0], CREF_UNDEF);
+    s->ok_ = (Propagate(s) == CREF_UNDEF);
+  } else {
+    CRef c = AllocClause(s, tmp->data_, j, false, 0);
+    CRefVecPush(&s->clauses_, c);
+    AttachClause(s, c);
+  }
+  return s->ok_;
+}
+
+bool SatSolverAddClauseSet(SatSolver* s, const ClauseSet* cs) {
+  GrowVars(s, cs->num_vars_);
+  for (int i = 0; i < cs->num_clauses_; i++) {
+    if (!SatSolverAddClause(s, ClauseSetClause(cs, i), ClauseSetSize(cs, i)))
+      return false;
+  }
+  return true;
+}
+
+// --- Busca ---
+
+static double Luby(double y, int x) {
+  int size = 1, seq = 0;
+  while (size < x + 1) {
+    seq++;
+    size = 2 * size + 1;
+  }
+  double result = 1.0;
+  while (size - 1 != x) {
+    size = (size - 1) >> 1;
+    seq--;
+    x = x % size;
+  }
+  while (seq-- > 0) result *= y;
+  return result;
+}
+
+static int PickBranchLit(SatSolver* s) {
+  while (s->heap_size_ > 0) {
+    int v = HeapPop(s);
+    if (s->lit_val_[2 * v] == 0) {
+      s->stats_.decisions_++;
+      return 2 * v + s->polarity_[v];
+    }
+  }
+  return LIT_UNDEF;
+}
+
+static SatResult Search(SatSolver* s, long long max_conflicts) {
+  long long conflicts = 0;
+  for (;;) {
+    CRef conflict = Propagate(s);
+    if (conflict != CREF_UNDEF) {
+      s->stats_.conflicts_++;
+      conflicts++;
+      if (DecisionLevel(s) == 0) {
+        s->ok_ = false;
+        return SAT_UNSATISFIABLE;
+      }
+
+      int bt_level;
+      int lbd = Analyze(s, conflict, &bt_level);
+      Backtrack(s, bt_level);
+
+      IntVec* learnt = &s->learnt_tmp_;
+      if (learnt->size_ == 1) {
+        Enqueue(s, learnt->data_[0], CREF_UNDEF);
+      } else {
+        CRef c = AllocClause(s, learnt->data_, learnt->size_, true, lbd);
+        CRefVecPush(&s->learnts_, c);
+        AttachClause(s, c);
+        BumpClause(s, c);
+        Enqueue(s, learnt->data_[0], c);
+      }
+      s->var_inc_ /= VAR_DECAY;
+      s->cla_inc_ /= CLAUSE_DECAY;
+      continue;
+    }
+
+    if (conflicts >= max_conflicts) {
+      Backtrack(s, 0);
+      return SAT_UNKNOWN;
+    }
+    if (DecisionLevel(s) == 0 && s->trail_size_ > s->simp_trail_) Simplify(s);
+    if (s->stats_.conflicts_ >= s->next_reduce_) {
+      s->next_reduce_ =
+          s->stats_.conflicts_ + REDUCE_FIRST + REDUCE_INC * s->reduce_count_;
+      ReduceDb(s);
+    }
+
+    // As suposições ocupam os primeiros níveis de decisão, uma por nível
+    int next = LIT_UNDEF;
+    while (DecisionLevel(s) < s->assumptions_.size_) {
+      int p = s->assumptions_.data_[DecisionLevel(s)];
+      if (s->lit_val_[p] == 1) {
+        IntVecPush(&s->trail_lim_, s->trail_size_);  // nível vazio
+      } else if (s->lit_val_[p] == -1) {
+        AnalyzeFinal(s, LitNeg(p));
+        return SAT_UNSATISFIABLE;
+      } else {
+        next = p;
+        break;
+      }
+    }
+    if (next == LIT_UNDEF) next = PickBranchLit(s);
+    if (next == LIT_UNDEF) return SAT_SATISFIABLE;
+    IntVecPush(&s->trail_lim_, s->trail_size_);
+    Enqueue(s, next, CREF_UNDEF);
+  }
+}
+
+SatResult SatSolverSolve(SatSolver* s) {
+  return SatSolverSolveAssuming(s, NULL, 0);
+}
+
+SatResult SatSolverSolveAssuming(SatSolver* s, const int* assumptions,
+                                 int num_assumptions) {
+  s->failed_.size_ = 0;
+  if (!s->ok_) return SAT_UNSATISFIABLE;
+
+  // Literais repetidos viram um só (cada suposição ocupa um nível)
+  s->assumptions_.size_ = 0;
+  for (int i = 0; i < num_assumptions; i++) {
+    int var = assumptions[i] < 0 ? -assumptions[i] : assumptions[i];
+    if (var == 0) continue;
+    GrowVars(s, var);
+    int lit = DimacsToLit(assumptions[i]);
+    char mark = (char)(1 + (lit & 1));
+    if (s->seen_[var - 1] & mark) continue;
+    s->seen_[var - 1] |= mark;
+    IntVecPush(&s->assumptions_, lit);
+  }
+  for (int i = 0; i < s->assumptions_.size_; i++)
+    s->seen_[LitVar(s->assumptions_.data_[i])] = 0;
+
+  SatResult result = SAT_UNKNOWN;
+  long long remaining = s->conflict_limit_;
+  int restart = s->next_restart_;
+  while (result == SAT_UNKNOWN && remaining != 0) {
+    long long budget = (long long)(Luby(2.0, restart) * RESTART_BASE);
+    if (remaining > 0 && budget > remaining) budget = remaining;
+    long long before = s->stats_.conflicts_;
+    result = Search(s, budget);
+    if (remaining > 0) {
+      remaining -= s->stats_.conflicts_ - before;
+      if (remaining < 0) remaining = 0;  // Search pode passar do orçamento
+    }
+    if (result == SAT_UNKNOWN && remaining != 0) {
+      s->stats_.restarts_++;
+      restart++;
+    }
+  }
+  // Interrompida pelo limite, a próxima chamada segue a sequência daqui
+  s->next_restart_ = result == SAT_UNKNOWN ? restart : 0;
+
+  if (result == SAT_SATISFIABLE)
+    for (int v = 0; v < s->num_vars_; v++) s->model_[v] = s->lit_val_[2 * v] == 1;
+  Backtrack(s, 0);
+  s->assumptions_.size_ = 0;
+  return result;
+}
+
+const int* SatSolverFailedAssumptions(const SatSolver* s, int* size) {
+  *size = s->failed_.size_;
+  return s->failed_.data_;
+}
@@ -0,0 +1,85 @@
+#include "../include/var_map.h"
+
+#include <stdlib.h>
+
+static unsigned HashVar(int var) {
+  unsigned h = (unsigned)var * 2654435761u;
+  return h ^ (h >> 16);
+}
+
+void VarMapInit(VarMap* map) {
+  map->capacity_ = 64;
+  map->count_ = 0;
+  map->keys_ = (int*)malloc(sizeof(int) * map->capacity_);
+  map->values_ = (int*)malloc(sizeof(int) * map->capacity_);
+  for (int i = 0; i < map->capacity_; i++) map->values_[i] = 0;
+  map->originals_cap_ = 64;
+  map->originals_ = (int*)malloc(sizeof(int) * map->originals_cap_);
+  map->originals_[0] = -1;
+}
+
+void VarMapFree(VarMap* map) {
+  free(map->keys_);
+  free(map->values_);
+  free(map->originals_);
+  map->keys_ = NULL;
+  map->values_ = NULL;
+  map->originals_ = NULL;
+  map->count_ = 0;
+}
+
+static void VarMapGrow(VarMap* map) {
+  int old_cap = map->capacity_;
+  int* old_keys = map->keys_;
+  int* old_values = map->values_;
+
+  map->capacity_ *= 2;
+  map->keys_ = (int*)malloc(sizeof(int) * map->capacity_);
+  map->values_ = (int*)malloc(sizeof(int) * map->capacity_);
+  for (int i = 0; i < map->capacity_; i++) map->values_[i] = 0;
+
+  for (int i = 0; i < old_cap; i++) {
+    if (!old_values[i]) continue;
+    unsigned mask = (unsigned)map->capacity_ - 1;
+    unsigned h = HashVar(old_keys[i]) & mask;
+    while (map->values_[h]) h = (h + 1) & mask;
+    map->keys_[h] = old_keys[i];
+    map->values_[h] = old_values[i];
+  }
+  free(old_keys);
+  free(old_values);
+}
+
+int VarMapFind(const VarMap* map, int var) {
+  unsigned mask = (unsigned)map->capacity_ - 1;
+  unsigned h = HashVar(var) & mask;
+  while (map->values_[h]) {
+    if (map->keys_[h] == var) return map->values_[h];
+    h = (h + 1) & mask;
+  }
+  return 0;
+}
+
+int VarMapGet(VarMap* map, int var) {
+  unsigned mask = (unsigned)map->capacity_ - 1;
+  unsigned h = HashVar(var) & mask;
+  while (map->values_[h]) {
+    if (map->keys_[h] == var) return map->values_[h];
+    h = (h + 1) & mask;
+  }
+
+  int id = ++map->count_;
+  map->keys_[h] = var;
+  map->values_[h] = id;
+
+  if (id >= map->originals_cap_) {
+    map->originals_cap_ *= 2;
+    map->originals_ =
+        (int*)realloc(map->originals_, sizeof(int) * map->originals_cap_);
+  }
+  map->originals_[id] = var;
+
+  // Mantém fator de carga abaixo de 1/2
+  if (map->count_ * 2 > map->capacity_) VarMapGrow(map);
+  return id;
+}
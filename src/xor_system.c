@@ -0,0 +1,218 @@
+#include "../include/xor_system.h"
+
+#include <stdint.h>
+#include <stdlib.h>
+#include <string.h>
+
+static int CompareInts(const void* a, const void* b) {
+  int x = *(const int*)a, y = *(const int*)b;
+  return (x > y) - (x < y);
+}
+
+void XorSystemInit(XorSystem* sys) {
+  ClauseSetInit(&sys->rows_);
+  sys->rhs_ = NULL;
+  sys->rhs_cap_ = 0;
+  sys->num_vars_ = 0;
+}
+
+void XorSystemFree(XorSystem* sys) {
+  ClauseSetFree(&sys->rows_);
+  free(sys->rhs_);
+  sys->rhs_ = NULL;
+  sys->rhs_cap_ = 0;
+}
+
+void XorSystemAdd(XorSystem* sys, const int* vars, int size, bool rhs) {
+  int* sorted = (int*)malloc(sizeof(int) * (size > 0 ? size : 1));
+  memcpy(sorted, vars, sizeof(int) * size);
+  qsort(sorted, size, sizeof(int), CompareInts);
+  for (int i = 0; i < size; i++) {
+    if (i + 1 < size && sorted[i] == sorted[i + 1]) {
+      i++;  // x ^ x = 0
+      continue;
+    }
+    ClauseSetPushLit(&sys->rows_, sorted[i]);
+    if (sorted[i] > sys->num_vars_) sys->num_vars_ = sorted[i];
+  }
+  ClauseSetEndClause(&sys->rows_);
+  free(sorted);
+
+  int row = sys->rows_.num_clauses_ - 1;
+  if (row == sys->rhs_cap_) {
+    sys->rhs_cap_ = sys->rhs_cap_ ? sys->rhs_cap_ * 2 : 64;
+    sys->rhs_ = (bool*)realloc(sys->rhs_, sizeof(bool) * sys->rhs_cap_);
+  }
+  sys->rhs_[row] = rhs;
+}
+
+// --- Eliminação de Gauss-Jordan ---
+
+#define GET_BIT(row, c) (((row)[(c) >> 6] >> ((c) & 63)) & 1)
+
+XorStatus XorSystemSolve(const XorSystem* sys, XorSystem* reduced,
+                         bool* values) {
+  if (reduced) XorSystemInit(reduced);
+  if (values) memset(values, 0, sizeof(bool) * (sys->num_vars_ + 1));
+
+  // Só as variáveis presentes ganham coluna; a última coluna é o rhs
+  int* col_of = (int*)calloc(sys->num_vars_ + 1, sizeof(int));
+  int* var_of = (int*)malloc(sizeof(int) * (sys->num_vars_ + 1));
+  int num_cols = 0;
+  const ClauseSet* rows = &sys->rows_;
+  for (size_t i = 0; i < rows->num_lits_; i++) {
+    int v = rows->lits_[i];
+    if (!col_of[v]) {
+      var_of[num_cols] = v;
+      col_of[v] = ++num_cols;
+    }
+  }
+  int num_rows = rows->num_clauses_;
+  int words = (num_cols + 1 + 63) / 64;
+  double min_dim = num_rows < num_cols ? num_rows : num_cols;
+  if ((double)num_rows * min_dim * words > (double)XOR_GAUSS_MAX_WORD_OPS) {
+    free(col_of);
+    free(var_of);
+    return XOR_TOO_LARGE;
+  }
+
+  uint64_t* matrix = (uint64_t*)calloc((size_t)num_rows * words + 1,
+                                       sizeof(uint64_t));
+  for (int r = 0; r < num_rows; r++) {
+    uint64_t* row = matrix + (size_t)r * words;
+    const int* vars = ClauseSetClause(rows, r);
+    for (int j = 0; j < ClauseSetSize(rows, r); j++) {
+      int c = col_of[vars[j]] - 1;
+      row[c >> 6] |= 1ull << (c & 63);
+    }
+    if (sys->rhs_[r]) row[num_cols >> 6] |= 1ull << (num_cols & 63);
+  }
+
+  // Acima do posto as linhas são zeradas nas colunas já percorridas, então
+  // o pivô da coluna c só tem bits a partir da palavra c / 64
+  int* pivot_col = (int*)malloc(sizeof(int) * (num_rows + 1));
+  uint64_t* tmp = (uint64_t*)malloc(sizeof(uint64_t) * words);
+  int rank = 0;
+  for (int c = 0; c < num_cols && rank < num_rows; c++) {
+    int p = rank;
+    while (p < num_rows && !GET_BIT(matrix + (size_t)p * words, c)) p++;
+    if (p == num_rows) continue;
+    uint64_t* pivot = matrix + (size_t)rank * words;
+    if (p != rank) {
+      uint64_t* other = matrix + (size_t)p * words;
+      memcpy(tmp, pivot, sizeof(uint64_t) * words);
+      memcpy(pivot, other, sizeof(uint64_t) * words);
+      memcpy(other, tmp, sizeof(uint64_t) * words);
+    }
+    for (int r = 0; r < num_rows; r++) {
+      uint64_t* row = matrix + (size_t)r * words;
+      if (r == rank || !GET_BIT(row, c)) continue;
+      for (int w = c >> 6; w < words; w++) row[w] ^= pivot[w];
+    }
+    pivot_col[rank++] = c;
+  }
+
+  // Linha nula com rhs 1: 0 = 1
+  XorStatus status = XOR_CONSISTENT;
+  for (int r = rank; r < num_rows; r++)
+    if (GET_BIT(matrix + (size_t)r * words, num_cols))
+      status = XOR_INCONSISTENT;
+
+  if (status == XOR_CONSISTENT) {
+    int* vars = (int*)malloc(sizeof(int) * (num_cols + 1));
+    for (int r = 0; r < rank; r++) {
+      const uint64_t* row = matrix + (size_t)r * words;
+      bool rhs = GET_BIT(row, num_cols);
+      // Livres em false: o pivô vale o rhs da sua linha
+      if (values) values[var_of[pivot_col[r]]] = rhs;
+      if (!reduced) continue;
+      int n = 0;
+      for (int c = pivot_col[r]; c < num_cols; c++)
+        if (GET_BIT(row, c)) vars[n++] = var_of[c];
+      XorSystemAdd(reduced, vars, n, rhs);
+    }
+    free(vars);
+  }
+  free(tmp);
+  free(pivot_col);
+  free(matrix);
+  free(col_of);
+  free(var_of);
+  return status;
+}
+
+#undef GET_BIT
+
+// --- Cadeias e Codificação ---
+
+bool XorChainLeaves(const ExprNode* root, const ExprNode*** leaves,
+                    int* size, int* cap, bool* parity) {
+  const ExprNode** stack = NULL;
+  int stack_size = 0, stack_cap = 0;
+  bool ok = true;
+  *size = 0;
+  *parity = false;
+
+#define PUSH(arr, n, c, node)                                         \
+  do {                                                                \
+    if ((n) == (c)) {                                                 \
+      (c) = (c) ? (c) * 2 : 64;                                       \
+      (arr) = (const ExprNode**)realloc((arr), sizeof(*(arr)) * (c)); \
+    }                                                                 \
+    (arr)[(n)++] = (node);                                            \
+  } while (0)
+
+  PUSH(stack, stack_size, stack_cap, root);
+  while (stack_size > 0) {
+    const ExprNode* node = stack[--stack_size];
+    if (!node) {
+      ok = false;
+      break;
+    }
+    if (node->type_ == NODE_NOT) {
+      *parity = !*parity;
+      PUSH(stack, stack_size, stack_cap, node->left_);
+    } else if (node->type_ == NODE_XOR) {
+      PUSH(stack, stack_size, stack_cap, node->right_);
+      PUSH(stack, stack_size, stack_cap, node->left_);
+    } else {
+      PUSH(*leaves, *size, *cap, node);
+    }
+  }
+#undef PUSH
+
+  free(stack);
+  return ok;
+}
+
+// Uma cláusula por atribuição dos literais com a paridade errada
+static void EncodeDirect(const int* lits, int size, bool rhs,
+                         ClauseSet* out) {
+  for (unsigned mask = 0; mask < (1u << size); mask++) {
+    bool parity = false;
+    for (int i = 0; i < size; i++) parity ^= (mask >> i) & 1;
+    if (parity == rhs) continue;
+    for (int i = 0; i < size; i++)
+      ClauseSetPushLit(out, (mask >> i) & 1 ? -lits[i] : lits[i]);
+    ClauseSetEndClause(out);
+  }
+}
+
+void XorEncodeClauses(const int* lits, int size, bool rhs, int* num_vars,
+                      ClauseSet* out) {
+  int chunk[XOR_CHUNK_SIZE];
+  int carry = 0;  // auxiliar = XOR dos blocos anteriores
+  int i = 0;
+  while ((carry != 0) + (size - i) > XOR_CHUNK_SIZE) {
+    int n = 0;
+    if (carry) chunk[n++] = carry;
+    while (n < XOR_CHUNK_SIZE - 1) chunk[n++] = lits[i++];
+    carry = ++*num_vars;
+    chunk[n++] = carry;
+    EncodeDirect(chunk, n, false, out);
+  }
+  int n = 0;
+  if (carry) chunk[n++] = carry;
+  while (i < size) chunk[n++] = lits[i++];
+  EncodeDirect(chunk, n, rhs, out);
+}
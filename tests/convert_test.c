@@ -0,0 +1,1117 @@
+// Testes diferenciais das funções principais contra força bruta: cada
+// sentença aleatória (sobre até TEST_VARS variáveis) tem sua tabela
+// verdade calculada por EvaluateTree, e cada resposta da biblioteca é
+// conferida contra ela. Para passar dos caminhos exaustivos, as mesmas
+// sentenças também são testadas acrescidas de pares de variáveis novas,
+// com mais de 20 variáveis no total.
+// A semente é fixa; a segunda rodada repete tudo com o cache de resultados
+// ligado.
+//
+// Uso: convert_test [--seed n] [--rounds n]
+
+#include <stdbool.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "../include/batch.h"
+#include "../include/bdd.h"
+#include "../include/bit_eval.h"
+#include "../include/clause_set.h"
+#include "../include/dimacs.h"
+#include "../include/dimacs_convert.h"
+#include "../include/dnf_converter.h"
+#include "../include/dnf_cubes.h"
+#include "../include/model_count.h"
+#include "../include/model_iterator.h"
+#include "../include/preprocess.h"
+#include "../include/result_cache.h"
+#include "../include/sat_session.h"
+#include "../include/sat_solver.h"
+#include "../include/var_map.h"
+#include "../include/xor_system.h"
+
+// Variáveis das sentenças aleatórias: a tabela verdade cabe em 64 bits
+#define TEST_VARS 6
+#define TEST_ROWS (1 << TEST_VARS)
+#define XOR_MAX 3
+
+// Pares (v v w) de variáveis novas acrescentados às sentenças: com eles
+// passam de 20 variáveis, e cada par só multiplica os modelos por 3
+#define PAD_PAIRS 12
+#define PAD_MODELS 531441  // 3^PAD_PAIRS
+
+// Variáveis das CNFs aleatórias do pré-processamento e do DIMACS
+#define CNF_VARS 10
+
+#define FORMULA_MAX 4096
+#define REWRITTEN_MAX (3 * FORMULA_MAX + 32)
+#define PADDED_MAX (REWRITTEN_MAX + 16 * PAD_PAIRS)
+
+typedef uint64_t TruthTable;  // bit m: valor na atribuição m (v em m >> v-1)
+
+static long long g_checks = 0;
+static long long g_failures = 0;
+
+#define CHECK(cond, ...)                                  \
+  do {                                                    \
+    g_checks++;                                           \
+    if (!(cond)) {                                        \
+      g_failures++;                                       \
+      fprintf(stderr, "%s:%d: falha: ", __FILE__, __LINE__); \
+      fprintf(stderr, __VA_ARGS__);                       \
+      fprintf(stderr, "\n");                              \
+    }                                                     \
+  } while (0)
+
+// --- Geração ---
+
+typedef struct {
+  uint64_t state_;
+} TestRng;
+
+static uint64_t RngNext(TestRng* rng) {
+  uint64_t x = rng->state_;
+  x ^= x << 13;
+  x ^= x >> 7;
+  x ^= x << 17;
+  return rng->state_ = x;
+}
+
+static int RngBelow(TestRng* rng, int n) { return (int)(RngNext(rng) % n); }
+
+// Sentença totalmente parentizada com até `depth` níveis de operadores e
+// no máximo XOR_MAX ou-exclusivos (cada um dobra a distribuição nas formas
+// normais); buf precisa de FORMULA_MAX bytes
+static void RandomFormula(TestRng* rng, int depth, char* buf) {
+  // Pilha de trechos a escrever: um nó (depth >= 0) ou um texto fixo
+  typedef struct {
+    int depth_;
+    const char* text_;
+  } Item;
+  Item stack[256];
+  int size = 0;
+  size_t len = 0;
+  int xors = XOR_MAX;
+  stack[size++] = (Item){depth, NULL};
+  while (size > 0) {
+    Item item = stack[--size];
+    if (item.text_) {
+      len += (size_t)sprintf(buf + len, "%s", item.text_);
+      continue;
+    }
+    int kind = item.depth_ == 0 ? 0 : RngBelow(rng, 8);
+    if (kind <= 1) {
+      len += (size_t)sprintf(buf + len, "%s%d", RngBelow(rng, 3) ? "" : "n",
+                             1 + RngBelow(rng, TEST_VARS));
+    } else if (kind == 2) {
+      stack[size++] = (Item){0, ")"};
+      stack[size++] = (Item){item.depth_ - 1, NULL};
+      stack[size++] = (Item){0, "n("};
+    } else {
+      static const char* const kOps[] = {" a ", " v ", " > ", " x "};
+      int op = RngBelow(rng, xors > 0 ? 4 : 3);
+      if (op == 3) xors--;
+      stack[size++] = (Item){0, ")"};
+      stack[size++] = (Item){item.depth_ - 1, NULL};
+      stack[size++] = (Item){0, kOps[op]};
+      stack[size++] = (Item){item.depth_ - 1, NULL};
+      stack[size++] = (Item){0, "("};
+    }
+  }
+  buf[len] = '\0';
+}
+
+// n(nf a (f v nf)): equivalente a f, com outra estrutura; out precisa de
+// REWRITTEN_MAX bytes
+static void RewriteFormula(const char* f, char* out) {
+  sprintf(out, "n(n(%s) a ((%s) v n(%s)))", f, f, f);
+}
+
+// f conjugada com PAD_PAIRS pares (v v v+1) sobre as variáveis seguintes
+// a TEST_VARS; out precisa de PADDED_MAX bytes
+static void PadFormula(const char* f, char* out) {
+  size_t len = (size_t)sprintf(out, "(%s)", f);
+  for (int i = 0; i < PAD_PAIRS; i++) {
+    int v = TEST_VARS + 1 + 2 * i;
+    len += (size_t)sprintf(out + len, " a (%d v %d)", v, v + 1);
+  }
+}
+
+// Cláusulas de 0 a 4 literais (vazias raras) sobre CNF_VARS variáveis
+static void RandomCnf(TestRng* rng, ClauseSet* cs) {
+  ClauseSetInit(cs);
+  int num_clauses = 10 + RngBelow(rng, 36);
+  for (int i = 0; i < num_clauses; i++) {
+    int size = RngBelow(rng, 200) == 0 ? 0 : 1 + RngBelow(rng, 4);
+    for (int j = 0; j < size; j++) {
+      int v = 1 + RngBelow(rng, CNF_VARS);
+      ClauseSetPushLit(cs, RngBelow(rng, 2) ? v : -v);
+    }
+    ClauseSetEndClause(cs);
+  }
+  cs->num_vars_ = CNF_VARS;
+}
+
+// Casa das pombas: n + 1 pombas em n casas (variável p * n + c + 1 para a
+// pomba p na casa c), insatisfatível e difícil para resolução
+static void PigeonholeCnf(int n, ClauseSet* cs) {
+  ClauseSetInit(cs);
+  for (int p = 0; p <= n; p++) {
+    for (int c = 0; c < n; c++) ClauseSetPushLit(cs, p * n + c + 1);
+    ClauseSetEndClause(cs);
+  }
+  for (int c = 0; c < n; c++)
+    for (int p = 0; p <= n; p++)
+      for (int q = p + 1; q <= n; q++) {
+        ClauseSetPushLit(cs, -(p * n + c + 1));
+        ClauseSetPushLit(cs, -(q * n + c + 1));
+        ClauseSetEndClause(cs);
+      }
+  cs->num_vars_ = (n + 1) * n;
+}
+
+// Conteúdo de um arquivo temporário já escrito, que é fechado (liberar
+// com free); *size recebe o tamanho
+static char* ReadBack(FILE* file, size_t* size) {
+  long end = ftell(file);
+  char* text = (char*)malloc((size_t)end + 1);
+  rewind(file);
+  *size = fread(text, 1, (size_t)end, file);
+  text[*size] = '\0';
+  fclose(file);
+  return text;
+}
+
+// --- Oráculos ---
+
+// false se a sentença for inválida; *used recebe as variáveis presentes
+static bool TruthTableOf(const char* formula, TruthTable* table,
+                         unsigned* used) {
+  int pos = 0;
+  ExprNode* root = ParseExpression(formula, &pos);
+  if (!root) return false;
+  *table = 0;
+  for (int m = 0; m < TEST_ROWS; m++)
+    if (EvaluateTree(root, m)) *table |= (TruthTable)1 << m;
+  if (used) {
+    *used = 0;
+    for (const char* p = formula; *p; p++)
+      if (*p >= '1' && *p <= '9' && (p == formula || p[-1] < '0' ||
+                                     p[-1] > '9'))
+        *used |= 1u << (atoi(p) - 1);
+  }
+  FreeExprTree(root);
+  return true;
+}
+
+// Atribuição (bit v-1) de um modelo indexado pela variável
+static int ModelMask(const bool* model, int size) {
+  int m = 0;
+  for (int v = 1; v <= TEST_VARS && v < size; v++)
+    if (model[v]) m |= 1 << (v - 1);
+  return m;
+}
+
+// O modelo satisfaz os pares de PadFormula
+static bool PadSatisfied(const bool* model, int size) {
+  for (int i = 0; i < PAD_PAIRS; i++) {
+    int v = TEST_VARS + 1 + 2 * i;
+    if (v + 1 >= size || !(model[v] || model[v + 1])) return false;
+  }
+  return true;
+}
+
+static int Popcount(uint64_t x) {
+  int n = 0;
+  for (; x; x &= x - 1) n++;
+  return n;
+}
+
+// Linhas da tabela em que a variável v é verdadeira
+static TruthTable VarRows(int v) {
+  TruthTable rows = 0;
+  for (int m = 0; m < TEST_ROWS; m++)
+    if ((m >> (v - 1)) & 1) rows |= (TruthTable)1 << m;
+  return rows;
+}
+
+static bool ClausesSatisfied(const ClauseSet* cs, const bool* model) {
+  for (int i = 0; i < cs->num_clauses_; i++) {
+    const int* lits = ClauseSetClause(cs, i);
+    bool sat = false;
+    for (int j = 0; j < ClauseSetSize(cs, i) && !sat; j++)
+      sat = model[abs(lits[j])] == (lits[j] > 0);
+    if (!sat) return false;
+  }
+  return true;
+}
+
+// Primeiro modelo de cs sobre 1..num_vars por enumeração; false se não
+// houver
+static bool BruteForceModel(const ClauseSet* cs, int num_vars, bool* model) {
+  for (long m = 0; m < 1L << num_vars; m++) {
+    for (int v = 1; v <= num_vars; v++) model[v] = (m >> (v - 1)) & 1;
+    if (ClausesSatisfied(cs, model)) return true;
+  }
+  return false;
+}
+
+static long long BruteForceCount(const ClauseSet* cs, int num_vars) {
+  bool model[CNF_VARS + 1];
+  long long count = 0;
+  for (long m = 0; m < 1L << num_vars; m++) {
+    for (int v = 1; v <= num_vars; v++) model[v] = (m >> (v - 1)) & 1;
+    count += ClausesSatisfied(cs, model);
+  }
+  return count;
+}
+
+// A sentença está na forma de dois níveis: `outer` de `inner` de literais
+static bool IsTwoLevel(const char* formula, NodeType outer) {
+  NodeType inner = outer == NODE_AND ? NODE_OR : NODE_AND;
+  int pos = 0;
+  ExprNode* root = ParseExpression(formula, &pos);
+  if (!root) return false;
+  // Cada nó ocupa ao menos um caractere do texto
+  size_t cap = strlen(formula) + 1;
+  ExprNode** stack = (ExprNode**)malloc(sizeof(ExprNode*) * cap);
+  int* levels = (int*)malloc(sizeof(int) * cap);  // 0: acima do termo
+  int size = 0;
+  bool ok = true;
+  stack[size] = root;
+  levels[size++] = 0;
+  while (size > 0 && ok) {
+    ExprNode* node = stack[--size];
+    int level = levels[size];
+    if (node->type_ == NODE_VAR) continue;
+    if (node->type_ == NODE_NOT) {
+      ok = node->left_->type_ == NODE_VAR;
+      continue;
+    }
+    if (level == 0 && node->type_ == outer) {
+      stack[size] = node->left_;
+      levels[size++] = 0;
+      stack[size] = node->right_;
+      levels[size++] = 0;
+    } else if (node->type_ == inner) {
+      stack[size] = node->left_;
+      levels[size++] = 1;
+      stack[size] = node->right_;
+      levels[size++] = 1;
+    } else {
+      ok = false;
+    }
+  }
+  free(stack);
+  free(levels);
+  FreeExprTree(root);
+  return ok;
+}
+
+// --- Funções principais ---
+
+static void TestNormalForms(const char* f, TruthTable table) {
+  static const struct {
+    bool cnf_;
+    MinimizeLevel level_;
+  } kForms[] = {{true, MINIMIZE_SIMPLIFY},  {true, MINIMIZE_TWO_LEVEL},
+                {false, MINIMIZE_SIMPLIFY}, {false, MINIMIZE_TWO_LEVEL},
+                {true, MINIMIZE_NONE},      {false, MINIMIZE_NONE},
+  };
+  for (size_t i = 0; i < sizeof(kForms) / sizeof(kForms[0]); i++) {
+    char* out = kForms[i].cnf_ ? ConvertToCNFMinimized(f, kForms[i].level_)
+                               : ConvertToDNFMinimized(f, kForms[i].level_);
+    TruthTable t;
+    bool ok = out && TruthTableOf(out, &t, NULL);
+    CHECK(ok && t == table, "%s nível %d de %s: %s",
+          kForms[i].cnf_ ? "FNC" : "FND", kForms[i].level_, f,
+          out ? out : "(null)");
+    CHECK(!out || IsTwoLevel(out, kForms[i].cnf_ ? NODE_AND : NODE_OR),
+          "forma de %s: %s", f, out);
+    free(out);
+  }
+}
+
+// Tseitin e Plaisted-Greenbaum: com as entradas fixadas, a CNF é
+// satisfatível exatamente nas linhas verdadeiras da tabela (só as
+// variáveis da sentença são fixadas; as auxiliares vêm depois da maior)
+static void TestEncodedCnf(const char* f, TruthTable table, unsigned used) {
+  for (int mode = CNF_TSEITIN; mode <= CNF_PLAISTED_GREENBAUM; mode++) {
+    char* cnf = ConvertToCNFMode(f, (CnfMode)mode);
+    CHECK(cnf != NULL, "modo %d de %s", mode, f);
+    if (!cnf) continue;
+    CHECK(IsTwoLevel(cnf, NODE_AND), "forma do modo %d de %s", mode, f);
+    char* query = (char*)malloc(strlen(cnf) + 8 * TEST_VARS + 3);
+    for (int m = 0; m < TEST_ROWS; m++) {
+      if (m & ~used) continue;  // linha igual à de m & used
+      int len = sprintf(query, "(%s)", cnf);
+      for (int v = 1; v <= TEST_VARS; v++)
+        if ((used >> (v - 1)) & 1)
+          len += sprintf(query + len, " a %s%d",
+                         (m >> (v - 1)) & 1 ? "" : "n", v);
+      bool expected = (table >> m) & 1;
+      CHECK(IsSatisfiable(query) == expected, "modo %d de %s na linha %d",
+            mode, f, m);
+    }
+    free(query);
+    free(cnf);
+  }
+}
+
+// O programa bit-paralelo acha linhas verdadeiras e falsas da tabela (a
+// atribuição é sobre as variáveis densas, na ordem da primeira ocorrência)
+static void TestBitProgram(const char* f, TruthTable table, unsigned used) {
+  int pos = 0;
+  ExprNode* root = ParseExpression(f, &pos);
+  if (!root) return;
+  BitProgram prog;
+  bool compiled = BitProgramCompile(root, &prog);
+  CHECK(compiled, "compilação de %s", f);
+  if (compiled) {
+    for (int target = 0; target < 2; target++) {
+      TruthTable rows = target ? table : ~table;
+      long long index = BitProgramFindAssignment(&prog, target);
+      CHECK((index >= 0) == (rows != 0), "varredura %d de %s", target, f);
+      int m = 0;
+      for (int j = 0; index >= 0 && j < prog.num_vars_; j++)
+        if ((index >> j) & 1) m |= 1 << (prog.vars_.originals_[j + 1] - 1);
+      if (index >= 0)
+        CHECK((rows >> m) & 1, "atribuição %d de %s", target, f);
+    }
+    long long expected = Popcount(table) >> (TEST_VARS - Popcount(used));
+    CHECK(BitProgramCountAssignments(&prog, true) == expected,
+          "contagem bit-paralela de %s", f);
+  }
+  BitProgramFree(&prog);
+  FreeExprTree(root);
+}
+
+static void TestSatAndCount(const char* f, TruthTable table, unsigned used) {
+  bool* model = NULL;
+  int size = 0;
+  bool sat = FindSatisfyingModel(f, &model, &size);
+  CHECK(sat == (table != 0), "sat de %s", f);
+  if (sat) CHECK((table >> ModelMask(model, size)) & 1, "modelo de %s", f);
+  free(model);
+
+  char* count = CountModels(f);
+  long long expected = Popcount(table) >> (TEST_VARS - Popcount(used));
+  CHECK(count && atoll(count) == expected, "contagem de %s: %s, esperado %lld",
+        f, count ? count : "(null)", expected);
+  free(count);
+
+  // Enumeração: modelos distintos, todos verdadeiros, na quantidade certa
+  ModelIterator* it = ModelIteratorCreate(f);
+  CHECK(it != NULL, "iterador de %s", f);
+  uint64_t seen = 0;
+  long long listed = 0;
+  const bool* next;
+  while (it && (next = ModelIteratorNext(it, &size))) {
+    int m = ModelMask(next, size);
+    CHECK((table >> m) & 1, "modelo enumerado de %s", f);
+    CHECK(!((seen >> m) & 1), "modelo repetido de %s", f);
+    seen |= (uint64_t)1 << m;
+    listed++;
+  }
+  CHECK(listed == expected, "enumeração de %s: %lld modelos", f, listed);
+  ModelIteratorDestroy(it);
+}
+
+// Com os pares de PadFormula a resposta vem do CDCL (e a contagem do
+// #SAT), não da varredura exaustiva
+static void TestPaddedSat(const char* f, TruthTable table, unsigned used) {
+  char padded[PADDED_MAX];
+  PadFormula(f, padded);
+  bool* model = NULL;
+  int size = 0;
+  bool sat = FindSatisfyingModel(padded, &model, &size);
+  CHECK(sat == (table != 0), "sat de %s", padded);
+  if (sat)
+    CHECK(((table >> ModelMask(model, size)) & 1) &&
+              PadSatisfied(model, size),
+          "modelo de %s", padded);
+  free(model);
+
+  char* count = CountModels(padded);
+  long long expected =
+      (Popcount(table) >> (TEST_VARS - Popcount(used))) * PAD_MODELS;
+  CHECK(count && atoll(count) == expected, "contagem de %s: %s, esperado %lld",
+        padded, count ? count : "(null)", expected);
+  free(count);
+}
+
+static bool CollectCube(const int* lits, int size, void* user) {
+  // Linhas em que o cubo é verdadeiro
+  TruthTable rows = ~(TruthTable)0;
+  for (int i = 0; i < size; i++) {
+    TruthTable var = VarRows(abs(lits[i]));
+    rows &= lits[i] > 0 ? var : ~var;
+  }
+  *(TruthTable*)user |= rows;
+  return true;
+}
+
+static void TestDnfCubes(const char* f, TruthTable table) {
+  TruthTable cubes = 0;
+  long long count = ForEachDnfCube(f, CollectCube, &cubes);
+  CHECK(count >= 0 && cubes == table, "cubos de %s", f);
+
+  FILE* out = tmpfile();
+  long long written = WriteDnfCubes(f, out, 0);
+  size_t len;
+  char* text = ReadBack(out, &len);
+  TruthTable t;
+  CHECK(written == count && TruthTableOf(text, &t, NULL) && t == table,
+        "FND em fluxo de %s: %s", f, text);
+  free(text);
+}
+
+static void TestEquivalence(const char* f, TruthTable tf, const char* g,
+                            TruthTable tg) {
+  bool* cex = NULL;
+  int size = 0;
+  bool equiv = CheckEquivalence(f, g, &cex, &size);
+  CHECK(equiv == (tf == tg), "equivalência de %s e %s", f, g);
+  CHECK(equiv == (cex == NULL), "contraexemplo de %s e %s", f, g);
+  if (cex) {
+    int m = ModelMask(cex, size);
+    CHECK(((tf ^ tg) >> m) & 1, "contraexemplo errado de %s e %s", f, g);
+  }
+  free(cex);
+}
+
+// Com os pares de PadFormula dos dois lados a comparação passa pelos BDDs;
+// o contraexemplo também precisa satisfazer os pares
+static void TestPaddedEquivalence(const char* f, TruthTable tf, const char* g,
+                                  TruthTable tg) {
+  char pf[PADDED_MAX], pg[PADDED_MAX];
+  PadFormula(f, pf);
+  PadFormula(g, pg);
+  bool* cex = NULL;
+  int size = 0;
+  bool equiv = CheckEquivalence(pf, pg, &cex, &size);
+  CHECK(equiv == (tf == tg), "equivalência de %s e %s", pf, pg);
+  CHECK(equiv == (cex == NULL), "contraexemplo de %s e %s", pf, pg);
+  if (cex)
+    CHECK((((tf ^ tg) >> ModelMask(cex, size)) & 1) &&
+              PadSatisfied(cex, size),
+          "contraexemplo errado de %s e %s", pf, pg);
+  free(cex);
+
+  // Equivalente: f reescrita com os mesmos pares
+  char rewritten[REWRITTEN_MAX];
+  RewriteFormula(f, rewritten);
+  PadFormula(rewritten, pg);
+  CHECK(CheckEquivalence(pf, pg, NULL, NULL), "equivalência de %s e %s", pf,
+        pg);
+}
+
+// O BDD de f, o de sua negação dupla e o de f reescrita são o mesmo nó;
+// BddPickSat acha uma linha verdadeira; com outra ordem o resultado é o
+// mesmo
+static void TestBdd(const char* f, TruthTable table) {
+  char rewritten[REWRITTEN_MAX];
+  RewriteFormula(f, rewritten);
+  int pos = 0, pos_rewritten = 0;
+  ExprNode* root = ParseExpression(f, &pos);
+  ExprNode* root_rewritten = ParseExpression(rewritten, &pos_rewritten);
+  CHECK(root && root_rewritten, "árvores de %s", f);
+  for (int reversed = 0; root && root_rewritten && reversed < 2;
+       reversed++) {
+    BddManager* mgr = BddManagerCreate();
+    if (reversed) {
+      int order[TEST_VARS];
+      for (int i = 0; i < TEST_VARS; i++) order[i] = TEST_VARS - i;
+      CHECK(BddSetVarOrder(mgr, order, TEST_VARS), "ordem invertida");
+    }
+    // Índices densos iguais às variáveis: a ordem acima vale para elas
+    VarMap vars;
+    VarMapInit(&vars);
+    for (int v = 1; v <= TEST_VARS; v++) VarMapGet(&vars, v);
+    BddRef a = BddFromExpr(mgr, root, &vars);
+    BddIncRef(mgr, a);
+    BddRef b = BddFromExpr(mgr, root_rewritten, &vars);
+    BddIncRef(mgr, b);
+    BddRef nn = BddNot(mgr, BddNot(mgr, a));
+    CHECK(a >= 0 && a == b && a == nn, "BDD de %s e de %s", f, rewritten);
+    CHECK((a == BDD_FALSE) == (table == 0), "BDD falso de %s", f);
+    CHECK((a == BDD_TRUE) == (table == ~(TruthTable)0), "BDD verdadeiro de %s",
+          f);
+    CHECK(BddXor(mgr, a, b) == BDD_FALSE && BddOr(mgr, a, BddNot(mgr, a)) ==
+              BDD_TRUE,
+          "identidades de %s", f);
+    bool values[TEST_VARS + 1] = {false};
+    if (BddPickSat(mgr, a, values))
+      CHECK((table >> ModelMask(values, TEST_VARS + 1)) & 1,
+            "BddPickSat de %s", f);
+    BddDecRef(mgr, a);
+    BddDecRef(mgr, b);
+    BddCollectGarbage(mgr);
+    CHECK(BddGetStats(mgr)->nodes_ == 2, "coleta de %s", f);
+    VarMapFree(&vars);
+    BddManagerDestroy(mgr);
+  }
+  FreeExprTree(root);
+  FreeExprTree(root_rewritten);
+}
+
+// Base f com dois níveis de restrições g e h
+static void TestSession(const char* f, TruthTable tf, const char* g,
+                        TruthTable tg, const char* h, TruthTable th,
+                        TestRng* rng) {
+  SatSession* s = SatSessionCreate(f);
+  CHECK(s != NULL, "sessão de %s", f);
+  if (!s) return;
+  bool* model = NULL;
+  int size = 0;
+  CHECK(SatSessionSolve(s, NULL, 0, NULL, NULL) == (tf != 0), "base %s", f);
+  SatSessionPush(s);
+  CHECK(SatSessionAdd(s, g), "restrição %s", g);
+  bool sat = SatSessionSolve(s, NULL, 0, &model, &size);
+  CHECK(sat == ((tf & tg) != 0), "%s com %s", f, g);
+  if (sat)
+    CHECK(((tf & tg) >> ModelMask(model, size)) & 1, "modelo de sessão");
+  free(model);
+
+  SatSessionPush(s);
+  SatSessionAdd(s, h);
+  TruthTable active = tf & tg & th;
+  CHECK(SatSessionSolve(s, NULL, 0, NULL, NULL) == (active != 0),
+        "%s com %s e %s", f, g, h);
+  // Comparação com a base sob g e h
+  bool* cex = NULL;
+  bool same = SatSessionCompare(s, h, &cex, &size);
+  TruthTable region = tg & th, differ = (tf ^ th) & region;
+  CHECK(same == (differ == 0), "comparação de %s com %s", f, h);
+  if (cex)
+    CHECK((differ >> ModelMask(cex, size)) & 1, "contraexemplo de sessão");
+  free(cex);
+
+  CHECK(SatSessionPop(s), "pop");
+  CHECK(SatSessionSolve(s, NULL, 0, NULL, NULL) == ((tf & tg) != 0),
+        "%s com %s depois do pop", f, g);
+  CHECK(SatSessionPop(s), "pop");
+  CHECK(!SatSessionPop(s), "pop sem nível");
+
+  // Suposições sobre a base sozinha
+  int assumptions[2];
+  TruthTable rows = tf;
+  for (int i = 0; i < 2; i++) {
+    int v = 1 + RngBelow(rng, TEST_VARS);
+    assumptions[i] = RngBelow(rng, 2) ? v : -v;
+    TruthTable var = VarRows(v);
+    rows &= assumptions[i] > 0 ? var : ~var;
+  }
+  CHECK(SatSessionSolve(s, assumptions, 2, NULL, NULL) == (rows != 0),
+        "%s supondo %d %d", f, assumptions[0], assumptions[1]);
+  CHECK(SatSessionSolve(s, NULL, 0, NULL, NULL) == (tf != 0),
+        "base %s depois das suposições", f);
+  SatSessionDestroy(s);
+}
+
+// x1 x ... x xn tem 2^(n-1) modelos; fixar k variáveis divide por 2^k.
+// Com n > 20 a contagem sai da eliminação sobre GF(2), e a cadeia
+// conjugada com a própria negação é insatisfatível
+static void TestXorChains(void) {
+  char chain[512], query[1100];
+  for (int n = 21; n <= 60; n += 13) {
+    size_t len = 0;
+    for (int v = 1; v <= n; v++)
+      len += (size_t)sprintf(chain + len, v > 1 ? " x %s%d" : "%s%d",
+                             v % 3 ? "" : "n", v);
+    char* count = CountModels(chain);
+    char expected[32];
+    sprintf(expected, "%llu", 1ull << (n - 1));
+    CHECK(count && !strcmp(count, expected), "contagem da cadeia de %d: %s",
+          n, count ? count : "(null)");
+    free(count);
+
+    sprintf(query, "(%s) a 1 a n2", chain);
+    count = CountModels(query);
+    sprintf(expected, "%llu", 1ull << (n - 3));
+    CHECK(count && !strcmp(count, expected), "contagem da cadeia fixada");
+    free(count);
+
+    sprintf(query, "(%s) a n(%s)", chain, chain);
+    CHECK(!IsSatisfiable(query), "cadeia com a negação");
+    bool* model = NULL;
+    int size = 0;
+    CHECK(FindSatisfyingModel(chain, &model, &size) && size == n + 1,
+          "modelo da cadeia de %d", n);
+    bool parity = false;
+    for (int v = 1; model && v <= n; v++) parity ^= model[v] == (v % 3 != 0);
+    CHECK(model && parity, "paridade do modelo da cadeia de %d", n);
+    free(model);
+  }
+}
+
+// Sistemas aleatórios sobre CNF_VARS variáveis contra enumeração: a
+// consistência, a solução devolvida e 2^(variáveis - posto) soluções
+static void TestXorSystem(TestRng* rng) {
+  XorSystem sys, reduced;
+  XorSystemInit(&sys);
+  int num_rows = 1 + RngBelow(rng, 12);
+  bool rhs[16];
+  int rows[16][CNF_VARS];
+  int sizes[16];
+  for (int i = 0; i < num_rows; i++) {
+    sizes[i] = 1 + RngBelow(rng, 5);
+    for (int j = 0; j < sizes[i]; j++) rows[i][j] = 1 + RngBelow(rng, CNF_VARS);
+    rhs[i] = RngBelow(rng, 2);
+    XorSystemAdd(&sys, rows[i], sizes[i], rhs[i]);
+  }
+  long long solutions = 0;
+  for (int m = 0; m < 1 << CNF_VARS; m++) {
+    bool ok = true;
+    for (int i = 0; i < num_rows && ok; i++) {
+      bool parity = false;
+      for (int j = 0; j < sizes[i]; j++) parity ^= (m >> (rows[i][j] - 1)) & 1;
+      ok = parity == rhs[i];
+    }
+    solutions += ok;
+  }
+
+  bool values[CNF_VARS + 1] = {false};
+  XorStatus status = XorSystemSolve(&sys, &reduced, values);
+  CHECK(status == (solutions ? XOR_CONSISTENT : XOR_INCONSISTENT),
+        "consistência do sistema");
+  if (status == XOR_CONSISTENT) {
+    for (int i = 0; i < num_rows; i++) {
+      bool parity = false;
+      for (int j = 0; j < sizes[i]; j++) parity ^= values[rows[i][j]];
+      CHECK(parity == rhs[i], "solução do sistema, equação %d", i);
+    }
+    int rank = reduced.rows_.num_clauses_;
+    CHECK(solutions == 1ll << (CNF_VARS - rank), "posto %d, %lld soluções",
+          rank, solutions);
+  }
+  XorSystemFree(&reduced);
+  XorSystemFree(&sys);
+}
+
+// --- CNF: resolvedor, pré-processamento e DIMACS ---
+
+static void TestClauses(const ClauseSet* cs) {
+  bool model[CNF_VARS + 1];
+  bool sat = BruteForceModel(cs, CNF_VARS, model);
+
+  SatSolver* solver = SatSolverCreate();
+  SatResult result = SatSolverAddClauseSet(solver, cs) ? SatSolverSolve(solver)
+                                                       : SAT_UNSATISFIABLE;
+  CHECK(result == (sat ? SAT_SATISFIABLE : SAT_UNSATISFIABLE), "CDCL");
+  if (result == SAT_SATISFIABLE) {
+    for (int v = 1; v <= CNF_VARS; v++)
+      model[v] = SatSolverModelValue(solver, v);
+    CHECK(ClausesSatisfied(cs, model), "modelo do CDCL");
+  }
+  SatSolverDestroy(solver);
+
+  BigNat count;
+  BigNatInit(&count);
+  ModelCountClauses(cs, CNF_VARS + 2, &count);  // 2 livres: contagem * 4
+  char* text = BigNatToString(&count);
+  long long expected = BruteForceCount(cs, CNF_VARS) * 4;
+  CHECK(atoll(text) == expected, "#SAT: %s, esperado %lld", text, expected);
+  free(text);
+  BigNatFree(&count);
+
+  // Pré-processamento: a CNF simplificada é equisatisfatível e seus
+  // modelos voltam a ser modelos da original pela reconstrução
+  ClauseSet simplified;
+  ClauseSetInit(&simplified);
+  for (int i = 0; i < cs->num_clauses_; i++)
+    ClauseSetAdd(&simplified, ClauseSetClause(cs, i), ClauseSetSize(cs, i));
+  simplified.num_vars_ = CNF_VARS;
+  CnfReconstruction rec;
+  bool kept = PreprocessClauses(&simplified, CNF_VARS, &rec);
+  bool simplified_sat = kept && BruteForceModel(&simplified, CNF_VARS, model);
+  CHECK(simplified_sat == sat, "pré-processamento");
+  if (simplified_sat) {
+    CnfReconstructModel(&rec, model);
+    CHECK(ClausesSatisfied(cs, model), "reconstrução do modelo");
+  }
+  CnfReconstructionFree(&rec);
+  ClauseSetFree(&simplified);
+}
+
+// CDCL em instâncias com dezenas de variáveis: casas das pombas (UNSAT) e
+// 3-SAT aleatório com uma solução plantada (SAT)
+static void TestSolverInstances(TestRng* rng) {
+  for (int n = 4; n <= 7; n++) {
+    ClauseSet cs;
+    PigeonholeCnf(n, &cs);
+    SatSolver* solver = SatSolverCreate();
+    CHECK(SatSolverAddClauseSet(solver, &cs) &&
+              SatSolverSolve(solver) == SAT_UNSATISFIABLE,
+          "casa das pombas %d", n);
+    CHECK(SatSolverGetStats(solver)->conflicts_ > 0, "conflitos com %d", n);
+    SatSolverDestroy(solver);
+    ClauseSetFree(&cs);
+  }
+
+  enum { kVars = 60, kClauses = 250 };
+  bool planted[kVars + 1];
+  for (int v = 1; v <= kVars; v++) planted[v] = RngBelow(rng, 2);
+  ClauseSet cs;
+  ClauseSetInit(&cs);
+  for (int i = 0; i < kClauses; i++) {
+    int lits[3];
+    bool sat = false;
+    for (int j = 0; j < 3; j++) {
+      int v = 1 + RngBelow(rng, kVars);
+      lits[j] = RngBelow(rng, 2) ? v : -v;
+      sat |= planted[v] == (lits[j] > 0);
+    }
+    if (!sat) lits[0] = -lits[0];  // a solução plantada satisfaz todas
+    ClauseSetAdd(&cs, lits, 3);
+  }
+  cs.num_vars_ = kVars;
+  SatSolver* solver = SatSolverCreate();
+  bool model[kVars + 1];
+  bool sat = SatSolverAddClauseSet(solver, &cs) &&
+             SatSolverSolve(solver) == SAT_SATISFIABLE;
+  CHECK(sat, "3-SAT plantado");
+  for (int v = 1; sat && v <= kVars; v++)
+    model[v] = SatSolverModelValue(solver, v);
+  if (sat) CHECK(ClausesSatisfied(&cs, model), "modelo do 3-SAT plantado");
+  SatSolverDestroy(solver);
+  ClauseSetFree(&cs);
+}
+
+// Suposições: UNSAT só por causa delas não estraga o resolvedor, e as
+// suposições que falharam já bastam para a contradição
+static void TestSolverAssumptions(const ClauseSet* cs, TestRng* rng) {
+  bool model[CNF_VARS + 1];
+  SatSolver* solver = SatSolverCreate();
+  if (!SatSolverAddClauseSet(solver, cs)) {
+    SatSolverDestroy(solver);
+    return;
+  }
+  for (int round = 0; round < 4; round++) {
+    int assumptions[3];
+    ClauseSet with;
+    ClauseSetInit(&with);
+    for (int i = 0; i < cs->num_clauses_; i++)
+      ClauseSetAdd(&with, ClauseSetClause(cs, i), ClauseSetSize(cs, i));
+    for (int i = 0; i < 3; i++) {
+      int v = 1 + RngBelow(rng, CNF_VARS);
+      assumptions[i] = RngBelow(rng, 2) ? v : -v;
+      ClauseSetAdd(&with, &assumptions[i], 1);
+    }
+    bool sat = BruteForceModel(&with, CNF_VARS, model);
+    SatResult result = SatSolverSolveAssuming(solver, assumptions, 3);
+    CHECK(result == (sat ? SAT_SATISFIABLE : SAT_UNSATISFIABLE),
+          "CDCL supondo %d %d %d", assumptions[0], assumptions[1],
+          assumptions[2]);
+    if (result == SAT_SATISFIABLE) {
+      for (int v = 1; v <= CNF_VARS; v++)
+        model[v] = SatSolverModelValue(solver, v);
+      CHECK(ClausesSatisfied(&with, model), "modelo com suposições");
+    } else if (result == SAT_UNSATISFIABLE) {
+      int num_failed = 0;
+      const int* failed = SatSolverFailedAssumptions(solver, &num_failed);
+      ClauseSetFree(&with);
+      ClauseSetInit(&with);
+      for (int i = 0; i < cs->num_clauses_; i++)
+        ClauseSetAdd(&with, ClauseSetClause(cs, i), ClauseSetSize(cs, i));
+      for (int i = 0; i < num_failed; i++) ClauseSetAdd(&with, &failed[i], 1);
+      CHECK(!BruteForceModel(&with, CNF_VARS, model),
+            "suposições que falharam");
+    }
+    ClauseSetFree(&with);
+  }
+  bool sat = BruteForceModel(cs, CNF_VARS, model);
+  CHECK(SatSolverSolve(solver) == (sat ? SAT_SATISFIABLE : SAT_UNSATISFIABLE),
+        "CDCL depois das suposições");
+  SatSolverDestroy(solver);
+}
+
+// Com limite de conflitos a casa das pombas para em SAT_UNKNOWN; sem o
+// limite a chamada seguinte termina a prova
+static void TestConflictLimit(void) {
+  ClauseSet cs;
+  PigeonholeCnf(7, &cs);
+  SatSolver* solver = SatSolverCreate();
+  SatSolverAddClauseSet(solver, &cs);
+  SatSolverSetConflictLimit(solver, 10);
+  CHECK(SatSolverSolve(solver) == SAT_UNKNOWN, "limite de conflitos");
+  // O limite é testado depois de cada propagação sem conflito, então
+  // conflitos em sequência podem passar um pouco dele
+  long long conflicts = SatSolverGetStats(solver)->conflicts_;
+  CHECK(conflicts >= 10 && conflicts < 40, "%lld conflitos", conflicts);
+  CHECK(SatSolverSolve(solver) == SAT_UNKNOWN, "limite na segunda chamada");
+  SatSolverSetConflictLimit(solver, -1);
+  CHECK(SatSolverSolve(solver) == SAT_UNSATISFIABLE, "sem limite");
+  SatSolverDestroy(solver);
+  ClauseSetFree(&cs);
+}
+
+static bool SameClauses(const ClauseSet* a, const ClauseSet* b) {
+  if (a->num_clauses_ != b->num_clauses_) return false;
+  for (int i = 0; i < a->num_clauses_; i++) {
+    int size = ClauseSetSize(a, i);
+    if (size != ClauseSetSize(b, i) ||
+        memcmp(ClauseSetClause(a, i), ClauseSetClause(b, i),
+               sizeof(int) * (size_t)size))
+      return false;
+  }
+  return true;
+}
+
+// Escreve f e lê de volta; *text recebe o arquivo (liberar com free)
+static bool DimacsRoundTrip(const DimacsFormula* f, DimacsFormula* back,
+                            char** text) {
+  FILE* out = tmpfile();
+  bool ok = DimacsWrite(out, f);
+  size_t size;
+  *text = ReadBack(out, &size);
+  return ok && DimacsParse(*text, size, back, NULL);
+}
+
+static void TestDimacs(const ClauseSet* cs, TestRng* rng) {
+  DimacsFormula f, back;
+  DimacsFormulaInit(&f);
+  ClauseSetFree(&f.clauses_);
+  f.clauses_ = *cs;  // emprestada; não liberada com f
+  char* text;
+  bool ok = DimacsRoundTrip(&f, &back, &text);
+  CHECK(ok && !back.weights_ && SameClauses(cs, &back.clauses_),
+        "DIMACS ida e volta:\n%s", text);
+  if (ok) DimacsFormulaFree(&back);
+  free(text);
+
+  // WCNF: pesos preservados
+  f.weights_ = (long long*)malloc(sizeof(long long) *
+                                  (size_t)(cs->num_clauses_ + 1));
+  f.top_ = 100;
+  for (int i = 0; i < cs->num_clauses_; i++)
+    f.weights_[i] = RngBelow(rng, 4) ? 1 + RngBelow(rng, 9) : f.top_;
+  ok = DimacsRoundTrip(&f, &back, &text);
+  ok = ok && back.weights_ && back.top_ == f.top_ &&
+       SameClauses(cs, &back.clauses_);
+  for (int i = 0; ok && i < cs->num_clauses_; i++)
+    ok = back.weights_[i] == f.weights_[i];
+  CHECK(ok, "WCNF ida e volta:\n%s", text);
+  DimacsFormulaFree(&back);
+  free(text);
+  free(f.weights_);
+
+  // SAT sobre o arquivo
+  const char* path = "convert_test.cnf";
+  FILE* file = fopen(path, "wb");
+  f.weights_ = NULL;
+  ok = file && DimacsWrite(file, &f);
+  if (file) fclose(file);
+  CHECK(ok, "escrita de %s", path);
+  bool model[CNF_VARS + 1];
+  bool sat = BruteForceModel(cs, CNF_VARS, model);
+  bool* found = NULL;
+  int size = 0;
+  long long error_line = -2;
+  CHECK(FindSatisfyingModelDimacs(path, &found, &size, &error_line) == sat &&
+            error_line == 0,
+        "SAT DIMACS");
+  if (found) CHECK(ClausesSatisfied(cs, found), "modelo DIMACS");
+  free(found);
+  CHECK(FindSatisfyingModelDimacs(path, NULL, NULL, NULL) == sat,
+        "SAT DIMACS sem modelo");
+  remove(path);
+}
+
+// A FNC em DIMACS tem a mesma tabela verdade da sentença
+static void TestWriteCnfDimacs(const char* formula, TruthTable table) {
+  FILE* out = tmpfile();
+  bool ok = WriteCNFDimacs(formula, CNF_EQUIVALENT, out);
+  size_t size;
+  char* text = ReadBack(out, &size);
+  DimacsFormula f;
+  ok = ok && DimacsParse(text, size, &f, NULL);
+  if (ok) {
+    bool model[TEST_VARS + 1] = {false};
+    TruthTable t = 0;
+    ok = f.clauses_.num_vars_ <= TEST_VARS;
+    for (int m = 0; ok && m < TEST_ROWS; m++) {
+      for (int v = 1; v <= TEST_VARS; v++) model[v] = (m >> (v - 1)) & 1;
+      if (ClausesSatisfied(&f.clauses_, model)) t |= (TruthTable)1 << m;
+    }
+    ok = ok && t == table;
+    DimacsFormulaFree(&f);
+  }
+  CHECK(ok, "FNC em DIMACS de %s:\n%s", formula, text);
+  free(text);
+}
+
+// --- Casos fixos ---
+
+static void TestEdgeCases(void) {
+  int pos = 0;
+  CHECK(ParseExpression("0 a 1", &pos) == NULL, "variável 0");
+  CHECK(!IsSatisfiable("n0"), "variável 0 negada");
+  CHECK(ConvertToCNF("1 a") == NULL, "operando faltando");
+
+  // Cabeçalho inválido: f fica zerada, sem nada para liberar
+  DimacsFormula f;
+  CHECK(!DimacsParse("p cnf x 1\n", 10, &f, NULL) && !f.clauses_.lits_ &&
+            !f.weights_,
+        "DIMACS inválido");
+
+  // Cabeçalho que declara mais cláusulas do que o arquivo comporta
+  const char* huge = "p cnf 1 2147483647\n1 0\n";
+  CHECK(DimacsParse(huge, strlen(huge), &f, NULL) &&
+            f.clauses_.num_clauses_ == 1 && f.clauses_.starts_cap_ < 64,
+        "cabeçalho exagerado");
+  DimacsFormulaFree(&f);
+  const char* wide = "p wcnf 1 2147483647 9\n9 1 0\n";
+  CHECK(DimacsParse(wide, strlen(wide), &f, NULL) &&
+            f.clauses_.num_clauses_ == 1 && f.weights_cap_ < 64,
+        "cabeçalho WCNF exagerado");
+  DimacsFormulaFree(&f);
+
+  SatSolver* solver = SatSolverCreate();
+  int none = 0;
+  CHECK(!SatSolverAddClause(solver, &none, 0), "cláusula vazia");
+  SatSolverDestroy(solver);
+
+  BddManager* mgr = BddManagerCreate();
+  int repeated[] = {2, 1, 2}, zero[] = {1, 0}, order[] = {2, 1};
+  CHECK(!BddSetVarOrder(mgr, repeated, 3) && !BddSetVarOrder(mgr, zero, 2),
+        "ordem inválida");
+  CHECK(BddSetVarOrder(mgr, order, 2), "ordem válida");
+  BddRef x = BddAnd(mgr, BddVar(mgr, 1), BddVar(mgr, 2));
+  CHECK(x > BDD_TRUE && !BddSetVarOrder(mgr, order, 2), "ordem com nós");
+  BddManagerDestroy(mgr);
+
+  // Sentenças profundas não podem estourar a pilha: ((1 op 2) op 3) ...
+  // sobre 50 variáveis, com forma normal pequena
+  int depth = 100000;
+  char* deep = (char*)malloc((size_t)depth * 8 + 16);
+  for (int op = 0; op < 2; op++) {
+    size_t len = 0;
+    for (int i = 0; i < depth; i++) deep[len++] = '(';
+    len += (size_t)sprintf(deep + len, "1");
+    for (int i = 0; i < depth; i++)
+      len += (size_t)sprintf(deep + len, " %c %d)", op ? 'v' : 'a',
+                             1 + (i + 1) % 50);
+    char* dnf = ConvertToDNF(deep);
+    char* cnf = ConvertToCNF(deep);
+    CHECK(dnf && cnf && strlen(dnf) < 1000 && strlen(cnf) < 1000,
+          "formas normais profundas");
+    free(dnf);
+    free(cnf);
+    CHECK(IsSatisfiable(deep), "SAT profunda");
+  }
+
+  memset(deep, 'n', (size_t)depth);
+  strcpy(deep + depth, "1");
+  char* cnf = ConvertToCNF(deep);
+  CHECK(cnf && !strcmp(cnf, "1"), "FNC de n...n1: %s", cnf ? cnf : "(null)");
+  free(cnf);
+  free(deep);
+}
+
+// Toda operação responde a uma sentença inválida com o mesmo "error"
+static void TestBatch(void) {
+  const char* jobs[] = {"sat 1 a", "equiv 1 v 2 ; 1 a", "equiv 1 a ; 1",
+                        "count 1 a", "cnf 1 a", "dnf 0", "tseitin 1 a"};
+  for (size_t i = 0; i < sizeof(jobs) / sizeof(jobs[0]); i++) {
+    char* out = BatchRunJob(jobs[i], 1);
+    CHECK(strstr(out, "\"error\":\"sentenca invalida\"") &&
+              !strstr(out, "false"),
+          "lote: %s -> %s", jobs[i], out);
+    free(out);
+  }
+  char* out = BatchRunJob("sat 1 a n1", 1);
+  CHECK(!strcmp(out, "{\"id\":1,\"op\":\"sat\",\"sat\":false}"),
+        "lote: UNSAT -> %s", out);
+  free(out);
+
+  // Linha longa demais: erro só para ela, e a leitura continua na seguinte
+  FILE* in = tmpfile();
+  FILE* result = tmpfile();
+  if (!in || !result) {
+    CHECK(false, "tmpfile");
+    return;
+  }
+  fputs("sat ", in);
+  for (size_t i = 0; i <= BATCH_MAX_LINE / 4; i++) fputs("1 a ", in);
+  fputs("1\nsat 1\n", in);
+  rewind(in);
+  CHECK(BatchRun(in, result, 2) == 2, "lote: tarefas");
+  rewind(result);
+  char line[256];
+  CHECK(fgets(line, sizeof(line), result) &&
+            !strcmp(line, "{\"id\":1,\"error\":\"linha longa demais\"}\n"),
+        "lote: linha longa");
+  CHECK(fgets(line, sizeof(line), result) && strstr(line, "\"id\":2,") &&
+            strstr(line, "\"sat\":true"),
+        "lote: linha seguinte");
+  fclose(in);
+  fclose(result);
+}
+
+static void RunRound(uint64_t seed, int rounds) {
+  TestRng rng = {seed};
+  char f[FORMULA_MAX], g[FORMULA_MAX], h[FORMULA_MAX];
+  for (int r = 0; r < rounds; r++) {
+    TruthTable tf, tg, th;
+    unsigned used;
+    RandomFormula(&rng, 1 + RngBelow(&rng, 5), f);
+    RandomFormula(&rng, 1 + RngBelow(&rng, 4), g);
+    RandomFormula(&rng, 1 + RngBelow(&rng, 3), h);
+    if (!TruthTableOf(f, &tf, &used) || !TruthTableOf(g, &tg, NULL) ||
+        !TruthTableOf(h, &th, NULL)) {
+      CHECK(false, "sentença gerada inválida: %s / %s / %s", f, g, h);
+      continue;
+    }
+    TestNormalForms(f, tf);
+    TestSatAndCount(f, tf, used);
+    TestBitProgram(f, tf, used);
+    TestDnfCubes(f, tf);
+    TestEquivalence(f, tf, g, tg);
+    char rewritten[REWRITTEN_MAX];
+    RewriteFormula(f, rewritten);
+    TestEquivalence(f, tf, rewritten, tf);
+    TestSession(f, tf, g, tg, h, th, &rng);
+    TestWriteCnfDimacs(f, tf);
+    if (r % 4 == 0) TestEncodedCnf(f, tf, used);
+    if (r % 4 == 1) TestPaddedSat(f, tf, used);
+    if (r % 4 == 2) TestPaddedEquivalence(f, tf, g, tg);
+    if (r % 4 == 3) TestBdd(f, tf);
+
+    ClauseSet cs;
+    RandomCnf(&rng, &cs);
+    TestClauses(&cs);
+    TestSolverAssumptions(&cs, &rng);
+    TestXorSystem(&rng);
+    TestDimacs(&cs, &rng);
+    ClauseSetFree(&cs);
+  }
+  TestSolverInstances(&rng);
+}
+
+int main(int argc, char** argv) {
+  uint64_t seed = 0x9e3779b97f4a7c15ull;
+  int rounds = 300;
+  for (int i = 1; i + 1 < argc; i += 2) {
+    if (!strcmp(argv[i], "--seed"))
+      seed = strtoull(argv[i + 1], NULL, 10) | 1;
+    else if (!strcmp(argv[i], "--rounds"))
+      rounds = atoi(argv[i + 1]);
+  }
+
+  TestEdgeCases();
+  TestBatch();
+  TestXorChains();
+  TestConflictLimit();
+  RunRound(seed, rounds);
+  ResultCacheSetBudget((size_t)1 << 22);
+  RunRound(seed, rounds);  // acertos e faltas do cache
+  RunRound(seed, rounds);
+  ResultCacheSetBudget(0);
+  ConvertThreadRelease();
+
+  printf("%lld verificações, %lld falhas\n", g_checks, g_failures);
+  return g_failures == 0 ? 0 : 1;
+}